@@ -0,0 +1,277 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Asynchronous, rate-limited logger
+*/
+
+#include "Logger.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdarg>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+constexpr std::size_t kLineBytes = 248;  // record payload; longer lines are truncated
+constexpr std::size_t kQueueSlots = 4096; // power of two, about 1 MB
+
+struct Record
+{
+    std::atomic<std::size_t> sequence{0};
+    Log::Level level = Log::Level::Info;
+    uint16_t length = 0;
+    char text[kLineBytes];
+};
+
+/**
+ * @brief Bounded multi-producer queue (Vyukov): one CAS per push, never blocks.
+ */
+class RecordQueue
+{
+  public:
+    RecordQueue()
+    {
+        for (std::size_t i = 0; i < kQueueSlots; ++i)
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Claim a slot to fill, or nullptr when full. Must be followed by publish().
+     */
+    Record *claim()
+    {
+        std::size_t pos = _head.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Record &slot = _slots[pos & (kQueueSlots - 1)];
+            std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0)
+            {
+                if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    return &slot;
+            }
+            else if (diff < 0)
+            {
+                return nullptr;
+            }
+            else
+            {
+                pos = _head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void publish(Record *slot)
+    {
+        std::size_t pos = slot->sequence.load(std::memory_order_relaxed);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Oldest published record, or nullptr. Single consumer; call release() when done with it.
+     */
+    Record *front()
+    {
+        Record &slot = _slots[_tail & (kQueueSlots - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != _tail + 1)
+            return nullptr;
+        return &slot;
+    }
+
+    void release(Record *slot)
+    {
+        slot->sequence.store(_tail + kQueueSlots, std::memory_order_release);
+        ++_tail;
+    }
+
+  private:
+    std::array<Record, kQueueSlots> _slots;
+    alignas(64) std::atomic<std::size_t> _head{0};
+    alignas(64) std::size_t _tail = 0;
+};
+
+struct LoggerState
+{
+    std::atomic<Log::Level> level{Log::Level::Info};
+    std::atomic<uint32_t> rateLimit{20};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> running{false};
+    std::unique_ptr<RecordQueue> queue;
+    std::thread flusher;
+    std::mutex syncMutex; // only for synchronous writes before start()
+    FILE *out = stdout;
+    FILE *err = stderr;
+};
+
+LoggerState &state()
+{
+    static LoggerState s;
+    return s;
+}
+
+FILE *sinkFor(const LoggerState &s, Log::Level level)
+{
+    return level >= Log::Level::Warn ? s.err : s.out;
+}
+
+void flushLoop()
+{
+    LoggerState &s = state();
+    uint64_t reportedDrops = 0;
+    while (true)
+    {
+        bool stopping = !s.running.load(std::memory_order_acquire);
+        std::size_t written = 0;
+        while (Record *r = s.queue->front())
+        {
+            std::fwrite(r->text, 1, r->length, sinkFor(s, r->level));
+            s.queue->release(r);
+            ++written;
+        }
+        uint64_t drops = s.dropped.load(std::memory_order_relaxed);
+        if (drops != reportedDrops)
+        {
+            std::fprintf(s.err, "[LOG] %llu lines dropped (queue full)\n",
+                         static_cast<unsigned long long>(drops - reportedDrops));
+            reportedDrops = drops;
+        }
+        if (written)
+        {
+            std::fflush(s.out);
+            std::fflush(s.err);
+        }
+        if (stopping)
+            return;
+        if (!written)
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+std::size_t formatLine(char *buf, std::size_t size, uint32_t suppressed, const char *format, va_list args)
+{
+    int n = std::vsnprintf(buf, size, format, args);
+    std::size_t len = n < 0 ? 0 : std::min(static_cast<std::size_t>(n), size - 1);
+    if (suppressed)
+    {
+        int extra = std::snprintf(buf + len, size - len, " (+%u similar lines suppressed)", suppressed);
+        len = extra < 0 ? len : std::min(len + static_cast<std::size_t>(extra), size - 1);
+    }
+    if (len == 0 || buf[len - 1] != '\n')
+    {
+        if (len == size - 1)
+            --len;
+        buf[len++] = '\n';
+        buf[len] = '\0';
+    }
+    return len;
+}
+} // namespace
+
+void Log::start(FILE *out, FILE *err)
+{
+    LoggerState &s = state();
+    if (s.running.load())
+        return;
+    s.out = out;
+    s.err = err;
+    if (!s.queue)
+        s.queue = std::make_unique<RecordQueue>();
+    s.running.store(true, std::memory_order_release);
+    s.flusher = std::thread(flushLoop);
+}
+
+void Log::shutdown()
+{
+    LoggerState &s = state();
+    if (!s.running.exchange(false))
+        return;
+    if (s.flusher.joinable())
+        s.flusher.join();
+}
+
+void Log::setLevel(Level level)
+{
+    state().level.store(level, std::memory_order_relaxed);
+}
+
+Log::Level Log::level()
+{
+    return state().level.load(std::memory_order_relaxed);
+}
+
+bool Log::parseLevel(const char *text, Level &out)
+{
+    static const char *const kNames[] = {"debug", "info", "warn", "error", "off"};
+    for (std::size_t i = 0; i < sizeof(kNames) / sizeof(kNames[0]); ++i)
+    {
+        if (std::strcmp(text, kNames[i]) == 0)
+        {
+            out = static_cast<Level>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Log::setRateLimit(uint32_t linesPerSecond)
+{
+    state().rateLimit.store(linesPerSecond, std::memory_order_relaxed);
+}
+
+uint64_t Log::droppedLines()
+{
+    return state().dropped.load(std::memory_order_relaxed);
+}
+
+bool Log::CallSite::admit(uint32_t &suppressed)
+{
+    uint32_t limit = state().rateLimit.load(std::memory_order_relaxed);
+    suppressed = 0;
+    if (limit == 0)
+        return true;
+    using namespace std::chrono;
+    long long sec = duration_cast<seconds>(steady_clock::now().time_since_epoch()).count();
+    long long window = _windowSec.load(std::memory_order_relaxed);
+    if (window != sec && _windowSec.compare_exchange_strong(window, sec, std::memory_order_relaxed))
+        _inWindow.store(0, std::memory_order_relaxed);
+    if (_inWindow.fetch_add(1, std::memory_order_relaxed) >= limit)
+    {
+        _suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    suppressed = _suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+void Log::write(Level level, uint32_t suppressed, const char *format, ...)
+{
+    LoggerState &s = state();
+    va_list args;
+    va_start(args, format);
+    if (!s.running.load(std::memory_order_acquire))
+    {
+        char buf[kLineBytes];
+        std::size_t len = formatLine(buf, sizeof(buf), suppressed, format, args);
+        va_end(args);
+        std::lock_guard<std::mutex> lock(s.syncMutex);
+        std::fwrite(buf, 1, len, sinkFor(s, level));
+        return;
+    }
+    Record *slot = s.queue->claim();
+    if (!slot)
+    {
+        va_end(args);
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    slot->level = level;
+    slot->length = static_cast<uint16_t>(formatLine(slot->text, sizeof(slot->text), suppressed, format, args));
+    va_end(args);
+    s.queue->publish(slot);
+}
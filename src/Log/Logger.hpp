@@ -0,0 +1,126 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Asynchronous, rate-limited logger
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @brief Lowest level compiled in; 1 (Info) by default, so RTYPE_LOG_DEBUG costs nothing.
+ */
+#ifndef RTYPE_LOG_MIN_LEVEL
+#define RTYPE_LOG_MIN_LEVEL 1
+#endif
+
+/**
+ * @namespace Log
+ * @brief printf-style logging that formats on the caller and writes on a background thread.
+ *
+ * A log call formats into a fixed-size record and pushes it on a bounded lock-free
+ * queue; the flusher thread started by start() writes records out in order. When
+ * the queue is full the line is dropped and counted instead of blocking the caller.
+ * Before start() (tools, benchmarks) lines are written synchronously.
+ *
+ * Use the RTYPE_LOG_* macros: each call site checks the level first and is rate
+ * limited on its own, so a hot path that starts failing cannot flood the output.
+ */
+namespace Log
+{
+enum class Level : uint8_t
+{
+    Debug = 0,
+    Info,
+    Warn, ///< written to stderr from here up
+    Error,
+    Off
+};
+
+/**
+ * @brief Whether lines of this level survive RTYPE_LOG_MIN_LEVEL (folded at compile time).
+ */
+constexpr bool compiledIn(Level level)
+{
+    return static_cast<int>(level) + 1 > RTYPE_LOG_MIN_LEVEL;
+}
+
+/**
+ * @brief Start the flusher thread.
+ * @param out Destination of Debug/Info lines.
+ * @param err Destination of Warn/Error lines.
+ */
+void start(FILE *out = stdout, FILE *err = stderr);
+
+/**
+ * @brief Write every queued line and stop the flusher thread.
+ */
+void shutdown();
+
+/**
+ * @brief Runtime threshold; lines below it are skipped before formatting.
+ */
+void setLevel(Level level);
+Level level();
+
+/**
+ * @brief Parse "debug", "info", "warn", "error" or "off".
+ */
+bool parseLevel(const char *text, Level &out);
+
+/**
+ * @brief Lines per second each call site may write (0 = unlimited, default 20).
+ */
+void setRateLimit(uint32_t linesPerSecond);
+
+/**
+ * @brief Lines dropped so far because the queue was full.
+ */
+uint64_t droppedLines();
+
+/**
+ * @brief Per-call-site state of the rate limiter, one static instance per RTYPE_LOG_* use.
+ */
+class CallSite
+{
+  public:
+    /**
+     * @brief Whether this line may be written; on success `suppressed` is the count skipped since the last one.
+     */
+    bool admit(uint32_t &suppressed);
+
+  private:
+    std::atomic<long long> _windowSec{-1};
+    std::atomic<uint32_t> _inWindow{0};
+    std::atomic<uint32_t> _suppressed{0};
+};
+
+/**
+ * @brief Format and queue one line (use the macros instead).
+ */
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((format(printf, 3, 4)))
+#endif
+void write(Level level, uint32_t suppressed, const char *format, ...);
+} // namespace Log
+
+#define RTYPE_LOG(lvl, ...)                                                                                            \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (Log::compiledIn(lvl) && (lvl) >= Log::level())                                                             \
+        {                                                                                                              \
+            static Log::CallSite rtypeLogSite;                                                                         \
+            uint32_t rtypeLogSuppressed = 0;                                                                           \
+            if (rtypeLogSite.admit(rtypeLogSuppressed))                                                                \
+                Log::write((lvl), rtypeLogSuppressed, __VA_ARGS__);                                                    \
+        }                                                                                                              \
+    } while (0)
+
+#define RTYPE_LOG_DEBUG(...) RTYPE_LOG(Log::Level::Debug, __VA_ARGS__)
+#define RTYPE_LOG_INFO(...) RTYPE_LOG(Log::Level::Info, __VA_ARGS__)
+#define RTYPE_LOG_WARN(...) RTYPE_LOG(Log::Level::Warn, __VA_ARGS__)
+#define RTYPE_LOG_ERROR(...) RTYPE_LOG(Log::Level::Error, __VA_ARGS__)
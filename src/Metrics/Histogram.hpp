@@ -0,0 +1,174 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Fixed-size log-linear histogram
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace Metrics
+{
+/**
+ * @brief Histogram of unsigned values with bounded relative error and no allocation.
+ *
+ * Values below 16 get their own bucket; above, every power of two is split into 16
+ * buckets, so a reported percentile is within 1/16 (6.25%) of the recorded value.
+ * Recording is a few shifts and an increment, cheap enough for per-packet hot paths.
+ * Units are the caller's (microseconds, milliseconds, hundredths of a percent...).
+ */
+class Histogram
+{
+  public:
+    static constexpr unsigned kSubBits = 4;
+    static constexpr uint64_t kSubBuckets = 1u << kSubBits;
+    static constexpr std::size_t kBuckets = (64 - kSubBits + 1) * kSubBuckets;
+
+    /**
+     * @brief Records one value.
+     */
+    void record(uint64_t value)
+    {
+        ++_buckets[bucketOf(value)];
+        ++_count;
+        _sum += value;
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+    }
+
+    /**
+     * @brief Adds `count` values known only by their bucket (e.g. forwarded by another process).
+     *
+     * The values are taken as the bucket's upper bound for sum(), min() and max().
+     */
+    void recordBucket(std::size_t bucket, uint64_t count)
+    {
+        if (bucket >= kBuckets || count == 0)
+            return;
+        uint64_t value = upperBound(bucket);
+        _buckets[bucket] += count;
+        _count += count;
+        _sum += value * count;
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+    }
+
+    /**
+     * @brief Adds every value recorded in another histogram.
+     */
+    void merge(const Histogram &other)
+    {
+        for (std::size_t i = 0; i < kBuckets; ++i)
+            _buckets[i] += other._buckets[i];
+        _count += other._count;
+        _sum += other._sum;
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+    }
+
+    /**
+     * @brief Value at a percentile, reported as the upper bound of its bucket (capped at max()).
+     * @param pct Percentile in [0, 100].
+     */
+    uint64_t percentile(double pct) const
+    {
+        if (_count == 0)
+            return 0;
+        uint64_t rank = static_cast<uint64_t>(pct / 100.0 * static_cast<double>(_count) + 0.5);
+        rank = std::max<uint64_t>(1, std::min(rank, _count));
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i)
+        {
+            seen += _buckets[i];
+            if (seen >= rank)
+                return std::min(std::max(upperBound(i), _min), _max);
+        }
+        return _max;
+    }
+
+    uint64_t count() const
+    {
+        return _count;
+    }
+
+    uint64_t min() const
+    {
+        return _count ? _min : 0;
+    }
+
+    uint64_t max() const
+    {
+        return _max;
+    }
+
+    double mean() const
+    {
+        return _count ? static_cast<double>(_sum) / static_cast<double>(_count) : 0.0;
+    }
+
+    uint64_t sum() const
+    {
+        return _sum;
+    }
+
+    /**
+     * @brief Forgets every recorded value.
+     */
+    void clear()
+    {
+        _buckets.fill(0);
+        _count = 0;
+        _sum = 0;
+        _min = std::numeric_limits<uint64_t>::max();
+        _max = 0;
+    }
+
+    /**
+     * @brief Bucket a value falls in.
+     */
+    static std::size_t bucketOf(uint64_t value)
+    {
+        if (value < kSubBuckets)
+            return static_cast<std::size_t>(value);
+        unsigned shift = highestBit(value) - kSubBits;
+        return (shift + 1) * kSubBuckets + static_cast<std::size_t>((value >> shift) - kSubBuckets);
+    }
+
+    /**
+     * @brief Largest value a bucket holds.
+     */
+    static uint64_t upperBound(std::size_t bucket)
+    {
+        std::size_t group = bucket / kSubBuckets;
+        uint64_t sub = bucket % kSubBuckets;
+        if (group == 0)
+            return sub;
+        unsigned shift = static_cast<unsigned>(group - 1);
+        return ((kSubBuckets + sub + 1) << shift) - 1;
+    }
+
+  private:
+    static unsigned highestBit(uint64_t value)
+    {
+        unsigned bit = 0;
+        for (unsigned step = 32; step > 0; step /= 2)
+        {
+            if (value >> (bit + step))
+                bit += step;
+        }
+        return bit;
+    }
+
+    std::array<uint64_t, kBuckets> _buckets{};
+    uint64_t _count = 0;
+    uint64_t _sum = 0;
+    uint64_t _min = std::numeric_limits<uint64_t>::max();
+    uint64_t _max = 0;
+};
+} // namespace Metrics
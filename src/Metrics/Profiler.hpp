@@ -0,0 +1,227 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Scoped section timers with histograms and Chrome trace export
+*/
+
+#pragma once
+
+#include "Histogram.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Metrics
+{
+/**
+ * @brief Per-section timing histograms, plus an optional ring of recent events for Chrome tracing.
+ *
+ * Sections are named by string literals and get a process-wide id on first use, so the
+ * histogram lookup on the hot path is an index. Durations are recorded in nanoseconds.
+ * Not thread-safe: one profiler per simulation thread.
+ */
+class Profiler
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t kTraceCapacity = 1u << 16; ///< events kept for the trace (about 1 MB)
+
+    Profiler() : _epoch(Clock::now())
+    {
+    }
+
+    /**
+     * @brief Id of a section name, registering it on first call (thread-safe, call once per site).
+     */
+    static std::size_t sectionId(const char *name)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        auto &names = sectionNames();
+        for (std::size_t i = 0; i < names.size(); ++i)
+        {
+            if (names[i] == name)
+                return i;
+        }
+        names.emplace_back(name);
+        return names.size() - 1;
+    }
+
+    /**
+     * @brief Records one timed section.
+     */
+    void record(std::size_t id, Clock::time_point start, Clock::time_point end)
+    {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        if (id >= _sections.size())
+            _sections.resize(id + 1);
+        _sections[id].record(static_cast<uint64_t>(ns));
+        if (!_tracing)
+            return;
+        TraceEvent event;
+        event.section = static_cast<uint32_t>(id);
+        event.durationNs = static_cast<uint32_t>(std::min<long long>(ns, UINT32_MAX));
+        event.startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(start - _epoch).count();
+        if (_trace.size() < kTraceCapacity)
+            _trace.push_back(event);
+        else
+            _trace[_traceHead] = event;
+        _traceHead = (_traceHead + 1) % kTraceCapacity;
+    }
+
+    /**
+     * @brief Starts keeping the last kTraceCapacity events for writeChromeTrace().
+     */
+    void enableTrace()
+    {
+        _tracing = true;
+        _trace.reserve(kTraceCapacity);
+    }
+
+    /**
+     * @brief True once any section has been recorded since the last reset().
+     */
+    bool hasSamples() const
+    {
+        for (const auto &h : _sections)
+        {
+            if (h.count())
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief One line per recorded section: count, mean, p50, p99 and max in microseconds.
+     */
+    void report(std::ostream &out, const std::string &prefix) const
+    {
+        std::vector<std::string> names = namesSnapshot();
+        char line[160];
+        for (std::size_t id = 0; id < _sections.size(); ++id)
+        {
+            const Histogram &h = _sections[id];
+            if (!h.count())
+                continue;
+            std::snprintf(line, sizeof(line), "%-22s n=%-7llu mean=%8.1f p50=%8.1f p99=%8.1f max=%8.1f us",
+                          names[id].c_str(), static_cast<unsigned long long>(h.count()), h.mean() / 1000.0,
+                          h.percentile(50) / 1000.0, h.percentile(99) / 1000.0, h.max() / 1000.0);
+            out << prefix << "profile " << line << "\n";
+        }
+    }
+
+    /**
+     * @brief Clears the histograms (the trace ring is kept).
+     */
+    void reset()
+    {
+        for (auto &h : _sections)
+            h.clear();
+    }
+
+    /**
+     * @brief Writes the traced events as Chrome trace JSON (chrome://tracing, Perfetto).
+     * @param processName Label shown for the process row, e.g. the lobby code.
+     * @return false if the file cannot be opened.
+     */
+    bool writeChromeTrace(const std::string &path, const std::string &processName) const
+    {
+        FILE *out = std::fopen(path.c_str(), "w");
+        if (!out)
+            return false;
+        std::vector<std::string> names = namesSnapshot();
+        std::fprintf(out, "{\"traceEvents\":[\n");
+        std::fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"%s\"}}",
+                     processName.c_str());
+        std::size_t first = _trace.size() < kTraceCapacity ? 0 : _traceHead;
+        for (std::size_t i = 0; i < _trace.size(); ++i)
+        {
+            const TraceEvent &e = _trace[(first + i) % _trace.size()];
+            std::fprintf(out, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                         names[e.section].c_str(), e.startNs / 1000.0, e.durationNs / 1000.0);
+        }
+        std::fprintf(out, "\n],\"displayTimeUnit\":\"ns\"}\n");
+        return std::fclose(out) == 0;
+    }
+
+  private:
+    struct TraceEvent
+    {
+        long long startNs = 0; ///< since the profiler was created
+        uint32_t durationNs = 0;
+        uint32_t section = 0;
+    };
+
+    static std::mutex &registryMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::vector<std::string> &sectionNames()
+    {
+        static std::vector<std::string> names;
+        return names;
+    }
+
+    static std::vector<std::string> namesSnapshot()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        return sectionNames();
+    }
+
+    std::vector<Histogram> _sections; ///< indexed by section id, grown on first record
+    std::vector<TraceEvent> _trace;   ///< ring once full, oldest at _traceHead
+    std::size_t _traceHead = 0;
+    bool _tracing = false;
+    Clock::time_point _epoch;
+};
+
+/**
+ * @brief Times its own lifetime into a profiler (no-op when the profiler is null).
+ */
+class ScopedTimer
+{
+  public:
+    ScopedTimer(Profiler *profiler, std::size_t id)
+        : _profiler(profiler), _id(id), _start(profiler ? Profiler::Clock::now() : Profiler::Clock::time_point{})
+    {
+    }
+
+    ~ScopedTimer()
+    {
+        if (_profiler)
+            _profiler->record(_id, _start, Profiler::Clock::now());
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+  private:
+    Profiler *_profiler;
+    std::size_t _id;
+    Profiler::Clock::time_point _start;
+};
+} // namespace Metrics
+
+#define RTYPE_PROFILE_CONCAT_(a, b) a##b
+#define RTYPE_PROFILE_CONCAT(a, b) RTYPE_PROFILE_CONCAT_(a, b)
+
+/**
+ * @brief Times the rest of the enclosing scope as section `name` of `profiler` (a Metrics::Profiler *).
+ *
+ * Compiles to nothing unless RTYPE_PROFILING is defined (CMake option of the same name).
+ */
+#ifdef RTYPE_PROFILING
+#define RTYPE_PROFILE_SCOPE(profiler, name)                                                                            \
+    static const std::size_t RTYPE_PROFILE_CONCAT(rtypeProfileId_, __LINE__) = Metrics::Profiler::sectionId(name);     \
+    Metrics::ScopedTimer RTYPE_PROFILE_CONCAT(rtypeProfileTimer_, __LINE__)((profiler),                                \
+                                                                            RTYPE_PROFILE_CONCAT(rtypeProfileId_, __LINE__))
+#else
+#define RTYPE_PROFILE_SCOPE(profiler, name) static_cast<void>(0)
+#endif
@@ -0,0 +1,131 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Named counters, gauges and histograms rendered as Prometheus text
+*/
+
+#include "Registry.hpp"
+#include <cstdio>
+
+namespace
+{
+const char *typeName(Metrics::Registry::Kind kind)
+{
+    switch (kind)
+    {
+    case Metrics::Registry::Kind::Counter:
+        return "counter";
+    case Metrics::Registry::Kind::Gauge:
+        return "gauge";
+    default:
+        return "summary";
+    }
+}
+
+std::string number(double value)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.9g", value);
+    return buf;
+}
+
+std::string series(const std::string &name, const std::string &labels, const std::string &extra = "")
+{
+    std::string all = labels;
+    if (!extra.empty())
+        all += (all.empty() ? "" : ",") + extra;
+    return all.empty() ? name : name + "{" + all + "}";
+}
+} // namespace
+
+void Metrics::Registry::describe(const std::string &name, Kind kind, const std::string &help, double scale)
+{
+    Family &family = _families[name];
+    family.kind = kind;
+    family.help = help;
+    family.scale = scale;
+}
+
+void Metrics::Registry::add(const std::string &name, uint64_t delta, const std::string &labels)
+{
+    _families[name].counters[labels] += delta;
+}
+
+void Metrics::Registry::set(const std::string &name, double value, const std::string &labels)
+{
+    Family &family = _families[name];
+    family.kind = Kind::Gauge;
+    family.gauges[labels] = value;
+}
+
+Metrics::Histogram &Metrics::Registry::histogram(const std::string &name, const std::string &labels)
+{
+    Family &family = _families[name];
+    family.kind = Kind::Summary;
+    return family.summaries[labels];
+}
+
+void Metrics::Registry::removeSeries(const std::string &labels)
+{
+    // Series are sorted by labels, so the ones extending `labels` follow it.
+    const std::string extended = labels + ",";
+    auto erase = [&](auto &series) {
+        series.erase(labels);
+        auto it = series.lower_bound(extended);
+        while (it != series.end() && it->first.compare(0, extended.size(), extended) == 0)
+            it = series.erase(it);
+    };
+    for (auto &kv : _families)
+    {
+        erase(kv.second.counters);
+        erase(kv.second.gauges);
+        erase(kv.second.summaries);
+    }
+}
+
+std::string Metrics::Registry::renderPrometheus() const
+{
+    std::string out;
+    for (const auto &kv : _families)
+    {
+        const std::string &name = kv.first;
+        const Family &family = kv.second;
+        if (!family.help.empty())
+            out += "# HELP " + name + " " + family.help + "\n";
+        out += "# TYPE " + name + " " + typeName(family.kind) + "\n";
+        for (const auto &c : family.counters)
+            out += series(name, c.first) + " " + std::to_string(c.second) + "\n";
+        for (const auto &g : family.gauges)
+            out += series(name, g.first) + " " + number(g.second) + "\n";
+        for (const auto &s : family.summaries)
+        {
+            const Histogram &h = s.second;
+            for (double q : {0.5, 0.9, 0.99})
+            {
+                out += series(name, s.first, "quantile=\"" + number(q) + "\"") + " " +
+                       number(static_cast<double>(h.percentile(q * 100.0)) * family.scale) + "\n";
+            }
+            out += series(name + "_sum", s.first) + " " + number(static_cast<double>(h.sum()) * family.scale) + "\n";
+            out += series(name + "_count", s.first) + " " + std::to_string(h.count()) + "\n";
+        }
+    }
+    return out;
+}
+
+std::string Metrics::Registry::label(const std::string &key, const std::string &value)
+{
+    std::string out = key + "=\"";
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        if (c == '\n')
+        {
+            out += "\\n";
+            continue;
+        }
+        out += c;
+    }
+    return out + "\"";
+}
@@ -0,0 +1,81 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Named counters, gauges and histograms rendered as Prometheus text
+*/
+
+#pragma once
+
+#include "Histogram.hpp"
+#include <map>
+#include <string>
+
+namespace Metrics
+{
+/**
+ * @brief Metric families keyed by name, each holding one series per label set.
+ *
+ * Labels are passed preformatted (`lobby="AB12CD"`, see label()). Histograms are
+ * exposed as Prometheus summaries (p50/p90/p99, sum, count). Single-threaded: the
+ * owner updates and renders it from its own loop.
+ */
+class Registry
+{
+  public:
+    enum class Kind
+    {
+        Counter,
+        Gauge,
+        Summary
+    };
+
+    /**
+     * @brief Declares a family's type and help text; `scale` converts recorded values to the exposed unit.
+     */
+    void describe(const std::string &name, Kind kind, const std::string &help, double scale = 1.0);
+
+    /**
+     * @brief Adds to a counter.
+     */
+    void add(const std::string &name, uint64_t delta, const std::string &labels = "");
+
+    /**
+     * @brief Sets a gauge.
+     */
+    void set(const std::string &name, double value, const std::string &labels = "");
+
+    /**
+     * @brief Histogram of a summary series, created empty on first use.
+     */
+    Histogram &histogram(const std::string &name, const std::string &labels = "");
+
+    /**
+     * @brief Drops every series carrying these labels, alone or followed by others (e.g. a closed lobby).
+     */
+    void removeSeries(const std::string &labels);
+
+    /**
+     * @brief Prometheus text exposition format (version 0.0.4).
+     */
+    std::string renderPrometheus() const;
+
+    /**
+     * @brief Formats one `key="value"` label, escaping the value.
+     */
+    static std::string label(const std::string &key, const std::string &value);
+
+  private:
+    struct Family
+    {
+        Kind kind = Kind::Counter;
+        std::string help;
+        double scale = 1.0;
+        std::map<std::string, uint64_t> counters;
+        std::map<std::string, double> gauges;
+        std::map<std::string, Histogram> summaries;
+    };
+
+    std::map<std::string, Family> _families;
+};
+} // namespace Metrics
@@ -0,0 +1,42 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** CPU time of the calling thread
+*/
+
+#pragma once
+
+#include <cstdint>
+#ifdef _WIN32
+#include <winsock2.h>
+#include <windows.h>
+#else
+#include <ctime>
+#endif
+
+namespace Metrics
+{
+/**
+ * @brief CPU time consumed by the calling thread, in nanoseconds (user + system).
+ *
+ * Unlike wall time it does not count the time the thread sleeps or is preempted, so the
+ * difference around a section is the work it did. Costs a system call on most platforms.
+ */
+inline uint64_t threadCpuNs()
+{
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+        return 0;
+    auto ticks = [](const FILETIME &t) {
+        return (static_cast<uint64_t>(t.dwHighDateTime) << 32) | t.dwLowDateTime;
+    };
+    return (ticks(kernel) + ticks(user)) * 100;
+#else
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+}
+} // namespace Metrics
@@ -7,8 +7,8 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <unordered_map>
 #include <vector>
 
 /**
@@ -47,8 +47,117 @@ struct MonsterState
     uint8_t type = 0; // 0 = sin, 1 = cos
 };
 
+/**
+ * @brief Entities of one kind, packed in a vector and indexed by server id.
+ *
+ * Same layout as the client ECS component arrays: `items` stays dense for iteration and
+ * `slots` maps an id to its position. Removal moves the last entry into the hole, and
+ * clear() only resets the slots that are in use, so the storage is reused from one
+ * snapshot to the next.
+ *
+ * @tparam T State type with an int `id` member.
+ */
+template <typename T> class StateTable
+{
+  public:
+    static constexpr uint32_t NPOS = 0xFFFFFFFFu; /**< Slot of an id without entry */
+
+    /**
+     * @brief Insert or update the entry of value.id.
+     * @return Position of the entry in items().
+     */
+    std::size_t upsert(const T &value)
+    {
+        if (value.id < 0)
+            return NPOS;
+        std::size_t id = static_cast<std::size_t>(value.id);
+        if (id >= _slots.size())
+            _slots.resize(id + 1, NPOS);
+        if (_slots[id] != NPOS)
+        {
+            _items[_slots[id]] = value;
+            return _slots[id];
+        }
+        _slots[id] = static_cast<uint32_t>(_items.size());
+        _items.push_back(value);
+        return _slots[id];
+    }
+
+    /**
+     * @brief Position of an id in items(), or NPOS.
+     */
+    std::size_t indexOf(int id) const
+    {
+        if (id < 0 || static_cast<std::size_t>(id) >= _slots.size())
+            return NPOS;
+        return _slots[static_cast<std::size_t>(id)];
+    }
+
+    /**
+     * @brief Entry of an id, or nullptr (valid until the table changes).
+     */
+    const T *find(int id) const
+    {
+        std::size_t idx = indexOf(id);
+        return idx == NPOS ? nullptr : &_items[idx];
+    }
+
+    /**
+     * @brief Remove an id, moving the last entry into its place.
+     * @return Id of the entry that moved (or -1 if none did).
+     */
+    int remove(int id)
+    {
+        std::size_t pos = indexOf(id);
+        if (pos == NPOS)
+            return -1;
+        std::size_t last = _items.size() - 1;
+        int moved = -1;
+        if (pos != last)
+        {
+            _items[pos] = _items[last];
+            moved = _items[pos].id;
+            _slots[static_cast<std::size_t>(moved)] = static_cast<uint32_t>(pos);
+        }
+        _items.pop_back();
+        _slots[static_cast<std::size_t>(id)] = NPOS;
+        return moved;
+    }
+
+    /**
+     * @brief Drop every entry, keeping both allocations.
+     */
+    void clear()
+    {
+        for (const auto &item : _items)
+            _slots[static_cast<std::size_t>(item.id)] = NPOS;
+        _items.clear();
+    }
+
+    /**
+     * @brief Packed entries, in no particular order.
+     */
+    const std::vector<T> &items() const
+    {
+        return _items;
+    }
+
+    std::size_t size() const
+    {
+        return _items.size();
+    }
+
+  private:
+    std::vector<T> _items;
+    std::vector<uint32_t> _slots;
+};
+
 /**
  * @brief Client-side container for the latest world state.
+ *
+ * The accessors return references to packed storage, so reading the state every frame
+ * copies nothing. The local player's position is cached and kept up to date when entries
+ * move.
  */
 class GameState
 {
@@ -58,7 +167,9 @@ class GameState
      */
     void upsertPlayer(int id, uint8_t x, uint8_t y, uint8_t hp, uint16_t score)
     {
-        _players[id] = PlayerState{id, x, y, hp, score};
+        std::size_t idx = _players.upsert(PlayerState{id, x, y, hp, score});
+        if (id == _localId)
+            _localIndex = idx;
     }
 
     /**
@@ -66,7 +177,7 @@ class GameState
      */
     void upsertBullet(int id, uint8_t x, uint8_t y, int8_t vx, int8_t vy)
     {
-        _bullets[id] = BulletState{id, x, y, vx, vy};
+        _bullets.upsert(BulletState{id, x, y, vx, vy});
     }
 
     /**
@@ -74,7 +185,19 @@ class GameState
      */
     void upsertMonster(int id, uint8_t x, uint8_t y, uint8_t hp, uint8_t type)
     {
-        _monsters[id] = MonsterState{id, x, y, hp, type};
+        _monsters.upsert(MonsterState{id, x, y, hp, type});
+    }
+
+    /**
+     * @brief Remove a player entry.
+     */
+    void removePlayer(int id)
+    {
+        int moved = _players.remove(id);
+        if (id == _localId)
+            _localIndex = StateTable<PlayerState>::NPOS;
+        else if (moved == _localId)
+            _localIndex = _players.indexOf(_localId);
     }
 
     /**
@@ -82,7 +205,7 @@ class GameState
      */
     void clear()
     {
-        _players.clear();
+        clearPlayers();
         _bullets.clear();
         _monsters.clear();
     }
@@ -93,46 +216,56 @@ class GameState
     void clearPlayers()
     {
         _players.clear();
+        _localIndex = StateTable<PlayerState>::NPOS;
+    }
+
+    /**
+     * @brief Set the id of the player controlled by this client.
+     */
+    void setLocalPlayerId(int id)
+    {
+        if (id == _localId)
+            return;
+        _localId = id;
+        _localIndex = _players.indexOf(id);
+    }
+
+    /**
+     * @brief Entry of the local player, or nullptr if it is not in the state.
+     */
+    const PlayerState *localPlayer() const
+    {
+        return _localIndex == StateTable<PlayerState>::NPOS ? nullptr : &_players.items()[_localIndex];
     }
 
     /**
-     * @brief Return a snapshot list of current players.
+     * @brief Current players, packed.
      */
-    std::vector<PlayerState> listPlayers() const
+    const std::vector<PlayerState> &players() const
     {
-        std::vector<PlayerState> res;
-        res.reserve(_players.size());
-        for (const auto &kv : _players)
-            res.push_back(kv.second);
-        return res;
+        return _players.items();
     }
 
     /**
-     * @brief Return a snapshot list of current bullets.
+     * @brief Current bullets, packed.
      */
-    std::vector<BulletState> listBullets() const
+    const std::vector<BulletState> &bullets() const
     {
-        std::vector<BulletState> res;
-        res.reserve(_bullets.size());
-        for (const auto &kv : _bullets)
-            res.push_back(kv.second);
-        return res;
+        return _bullets.items();
     }
 
     /**
-     * @brief Return a snapshot list of current monsters.
+     * @brief Current monsters, packed.
      */
-    std::vector<MonsterState> listMonsters() const
+    const std::vector<MonsterState> &monsters() const
     {
-        std::vector<MonsterState> res;
-        res.reserve(_monsters.size());
-        for (const auto &kv : _monsters)
-            res.push_back(kv.second);
-        return res;
+        return _monsters.items();
     }
 
   private:
-    std::unordered_map<int, PlayerState> _players;
-    std::unordered_map<int, BulletState> _bullets;
-    std::unordered_map<int, MonsterState> _monsters;
+    StateTable<PlayerState> _players;
+    StateTable<BulletState> _bullets;
+    StateTable<MonsterState> _monsters;
+    int _localId = -1;
+    std::size_t _localIndex = StateTable<PlayerState>::NPOS;
 };
@@ -0,0 +1,38 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Network events raised by NetworkClient
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Kind of event queued by NetworkClient::pollPackets().
+ */
+enum class NetEventType : uint8_t
+{
+    Ping,         ///< Server PING answered with a PONG.
+    PingSendFail, ///< Server PING received but the PONG could not be sent.
+    Refused,      ///< Server refused the connection (text: reason).
+    PlayerList,   ///< Full player list received (see getLastPlayerList()).
+    NewPlayer,    ///< A player joined (appended to getLastPlayerList()).
+    LobbyOk,      ///< Lobby created or joined (text: lobby code).
+    LobbyError,   ///< Lobby request failed (text: reason).
+    Message,      ///< Chat or system message (text: raw payload).
+    Snapshot,     ///< A new world snapshot is readable.
+    Timeout,      ///< TCP connection lost.
+    Connected     ///< Handshake started by beginConnect() accepted (getPlayerId() is set).
+};
+
+/**
+ * @brief Queued network event. Only TCP events that carry a payload fill text.
+ */
+struct NetEvent
+{
+    NetEventType type;
+    std::string text;
+};
@@ -7,10 +7,13 @@
 
 #include "NetworkClient.hpp"
 #include "GameState.hpp"
+#include "SnapshotDecoder.hpp"
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <iostream>
 #ifndef _WIN32
+#include <fcntl.h>
 #include <netinet/tcp.h>
 #endif // !_WIN32
 #include "../TransportLayer/Protocol.hpp"
@@ -19,7 +22,28 @@
 namespace
 {
 constexpr size_t BUFFER_SIZE = 1024;
+constexpr size_t HEADER_SIZE = 4;
+
+void setNonBlocking(socket_t fd, bool enabled)
+{
+#ifdef _WIN32
+    u_long mode = enabled ? 1 : 0;
+    ioctlsocket(fd, FIONBIO, &mode);
+#else
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, enabled ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK));
+#endif
+}
+
+bool connectInProgress(int err)
+{
+#ifdef _WIN32
+    return err == WSAEWOULDBLOCK;
+#else
+    return err == EINPROGRESS;
+#endif
 }
+} // namespace
 
 NetworkClient::NetworkClient(const std::string &ip, uint16_t port)
 {
@@ -37,7 +61,6 @@ NetworkClient::~NetworkClient()
 bool NetworkClient::connectToServer()
 {
     _tcpFd = socket(AF_INET, SOCK_STREAM, 0);
-    std::cout << "TCP fd: " << _tcpFd << std::endl;
     if (_tcpFd < 0)
         return false;
     if (::connect(_tcpFd, reinterpret_cast<sockaddr *>(&_tcpAddr), sizeof(_tcpAddr)) < 0)
@@ -58,6 +81,20 @@ bool NetworkClient::performHandshake()
     if (receiveTcpFramed(serverHello) != RecvResult::Ok)
         return false;
 
+    if (!sendPacketTcp(makeClientHello()))
+        return false;
+
+    Packet ok;
+    if (receiveTcpFramed(ok) != RecvResult::Ok)
+        return false;
+    if (ok.type != PacketType::OK || ok.payload.size() < 2)
+        return false;
+    _playerId = (ok.payload[0] << 8) | ok.payload[1];
+    return true;
+}
+
+Packet NetworkClient::makeClientHello() const
+{
     auto sanitizePseudo = [](const std::string &raw) {
         std::string out;
         out.reserve(raw.size());
@@ -82,16 +119,43 @@ bool NetworkClient::performHandshake()
     {
         helloPayload += "|";
     }
-    Packet clientHello(PacketType::CLIENT_HELLO, std::vector<uint8_t>(helloPayload.begin(), helloPayload.end()));
-    if (!sendPacketTcp(clientHello))
+    return Packet(PacketType::CLIENT_HELLO, std::vector<uint8_t>(helloPayload.begin(), helloPayload.end()));
+}
+
+bool NetworkClient::beginConnect()
+{
+    _tcpFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (_tcpFd < 0)
+        return false;
+    setNonBlocking(_tcpFd, true);
+    if (::connect(_tcpFd, reinterpret_cast<sockaddr *>(&_tcpAddr), sizeof(_tcpAddr)) < 0 &&
+        !connectInProgress(SOCKET_ERROR_CODE))
         return false;
+    _tcpConnecting = true;
+    _awaitingAccept = true;
+    return ensureUdp();
+}
 
-    Packet ok;
-    if (receiveTcpFramed(ok) != RecvResult::Ok)
+bool NetworkClient::finishConnect()
+{
+    pollfd fd{_tcpFd, POLLOUT, 0};
+    if (POLL(&fd, 1, 0) <= 0)
         return false;
-    if (ok.type != PacketType::OK || ok.payload.size() < 2)
+    _tcpConnecting = false;
+    int err = 0;
+    socklen_t len = sizeof(err);
+    getsockopt(_tcpFd, SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&err), &len);
+    if (err != 0)
+    {
+        _events.push_back({NetEventType::Refused, "CONNECT_FAILED"});
+        disconnect();
         return false;
-    _playerId = (ok.payload[0] << 8) | ok.payload[1];
+    }
+    // Back to blocking: the rest of the client (writeAll) expects it.
+    setNonBlocking(_tcpFd, false);
+    char flag = 1;
+    setsockopt(_tcpFd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+    _tcpConnected = true;
     return true;
 }
 
@@ -149,7 +213,8 @@ bool NetworkClient::sendChat(const std::string &text)
     }
     if (clean.empty())
         return false;
-    std::cout << "[CLIENT] sendChat \"" << clean << "\"\n";
+    if (_verbose)
+        std::cout << "[CLIENT] sendChat \"" << clean << "\"\n";
     Packet msg(PacketType::MESSAGE, std::vector<uint8_t>(clean.begin(), clean.end()));
     bool ok = sendPacketTcp(msg);
     if (!ok)
@@ -161,14 +226,16 @@ bool NetworkClient::sendChat(const std::string &text)
 
 bool NetworkClient::sendCreateLobby()
 {
-    std::cout << "[CLIENT] SEND CREATE_LOBBY\n";
+    if (_verbose)
+        std::cout << "[CLIENT] SEND CREATE_LOBBY\n";
     Packet pkt(PacketType::CREATE_LOBBY, {});
     return sendPacketTcp(pkt);
 }
 
 bool NetworkClient::sendJoinLobby(const std::string &code)
 {
-    std::cout << "[CLIENT] SEND JOIN_LOBBY " << code << "\n";
+    if (_verbose)
+        std::cout << "[CLIENT] SEND JOIN_LOBBY " << code << "\n";
     Packet pkt(PacketType::JOIN_LOBBY, {code.begin(), code.end()});
     return sendPacketTcp(pkt);
 }
@@ -190,14 +257,86 @@ bool NetworkClient::sendPacketTcp(const Packet &p)
 bool NetworkClient::sendPacketUdp(const Packet &p)
 {
     auto data = p.serialize();
-    ssize_t sent = sendto(_udpFd, reinterpret_cast<const char *>(data.data()), data.size(), 0,
+    if (!_udpOut.enabled())
+        return sendUdpBytes(data.data(), data.size());
+    _udpOut.push(data.data(), data.size(), _udpAddr, nowMs());
+    pumpImpairment();
+    return true;
+}
+
+bool NetworkClient::sendUdpBytes(const uint8_t *data, std::size_t size)
+{
+    ssize_t sent = sendto(_udpFd, reinterpret_cast<const char *>(data), size, 0,
                           reinterpret_cast<sockaddr *>(&_udpAddr), sizeof(_udpAddr));
     if (sent > 0)
     {
         _udpBytesOutWindow += static_cast<uint64_t>(sent);
         updateUdpRates(nowMs());
     }
-    return sent == static_cast<ssize_t>(data.size());
+    return sent == static_cast<ssize_t>(size);
+}
+
+void NetworkClient::setImpairment(const Network::TransportLayer::Impairment::Config &config)
+{
+    Network::TransportLayer::Impairment::Config inbound = config;
+    inbound.seed = config.seed + 1;
+    _udpOut.configure(config);
+    _udpIn.configure(inbound);
+}
+
+bool NetworkClient::pumpImpairment()
+{
+    if (_udpOut.enabled() && _udpFd != INVALID_SOCKET_FD)
+    {
+        Network::TransportLayer::Impairment::Datagram d;
+        long long now = nowMs();
+        while (_udpOut.pop(now, d))
+            sendUdpBytes(d.bytes.data(), d.bytes.size());
+    }
+    if (_rxRunning.load(std::memory_order_relaxed))
+        return false; // inbound belongs to the receive thread
+    return deliverDelayedUdp();
+}
+
+bool NetworkClient::deliverDelayedUdp()
+{
+    if (!_udpIn.enabled())
+        return false;
+    Network::TransportLayer::Impairment::Datagram d;
+    long long now = nowMs();
+    bool delivered = false;
+    while (_udpIn.pop(now, d))
+    {
+        handleUdpDatagram(d.bytes.data(), d.bytes.size(), now);
+        delivered = true;
+        // Without the receive thread, report each snapshot a burst of due datagrams brings.
+        if (!_rxRunning.load(std::memory_order_relaxed) && _snapshots.update())
+            _events.push_back({NetEventType::Snapshot, {}});
+    }
+    return delivered;
+}
+
+void NetworkClient::receiveUdpDatagram(const uint8_t *data, std::size_t len, long long arrivalMs)
+{
+    if (!_udpIn.enabled())
+    {
+        handleUdpDatagram(data, len, arrivalMs);
+        return;
+    }
+    _udpIn.push(data, len, _udpAddr, arrivalMs);
+    deliverDelayedUdp();
+}
+
+Network::TransportLayer::Impairment::Stats NetworkClient::getImpairmentStats() const
+{
+    Network::TransportLayer::Impairment::Stats total = _udpOut.stats();
+    const auto &in = _udpIn.stats();
+    total.submitted += in.submitted;
+    total.dropped += in.dropped;
+    total.duplicated += in.duplicated;
+    total.reordered += in.reordered;
+    total.delivered += in.delivered;
+    return total;
 }
 
 bool NetworkClient::readTcpPacket(Packet &p)
@@ -205,55 +344,54 @@ bool NetworkClient::readTcpPacket(Packet &p)
     auto res = receiveTcpFramed(p);
     if (res == RecvResult::Disconnected)
     {
-        _events.push_back("TIMEOUT");
+        _events.push_back({NetEventType::Timeout, {}});
         disconnect();
     }
     return res == RecvResult::Ok;
 }
 
-bool NetworkClient::readUdpPacket(Packet &p)
+bool NetworkClient::readUdpDatagram(uint8_t *buffer, std::size_t capacity, std::size_t &len, long long &arrivalMs)
 {
-    uint8_t buffer[BUFFER_SIZE]{};
     sockaddr_in from{};
-    socklen_t len = sizeof(from);
-    ssize_t n = recvfrom(_udpFd, reinterpret_cast<char *>(buffer), sizeof(buffer), 0,
-                         reinterpret_cast<sockaddr *>(&from), &len);
+    socklen_t fromLen = sizeof(from);
+    ssize_t n = recvfrom(_udpFd, reinterpret_cast<char *>(buffer), capacity, 0, reinterpret_cast<sockaddr *>(&from),
+                         &fromLen);
     if (n <= 0)
         return false;
+    arrivalMs = nowMs();
     _udpBytesInWindow += static_cast<uint64_t>(n);
-    updateUdpRates(nowMs());
-    p = Packet::deserialize(buffer, static_cast<size_t>(n));
+    len = static_cast<std::size_t>(n);
     return true;
 }
 
 bool NetworkClient::pollPackets()
 {
-    fd_set rfds, wfds, efds;
-    FD_ZERO(&rfds);
-    socket_t maxFd = 0;
+    if (_tcpConnecting && !finishConnect())
+        return false;
+    // poll() rather than select(): descriptors past FD_SETSIZE are fine, which matters
+    // when one process runs thousands of clients (rtype-loadgen).
+    pollfd fds[2]{};
+    unsigned count = 0;
+    int tcpSlot = -1;
+    int udpSlot = -1;
+    bool pollUdp = _udpFd != INVALID_SOCKET_FD && !_rxRunning.load(std::memory_order_relaxed);
     if (_tcpFd != INVALID_SOCKET_FD)
     {
-        FD_SET(_tcpFd, &rfds);
-        maxFd = std::max(maxFd, _tcpFd);
+        fds[count] = {_tcpFd, POLLIN, 0};
+        tcpSlot = static_cast<int>(count++);
     }
-    if (_udpFd != INVALID_SOCKET_FD)
+    if (pollUdp)
     {
-        FD_SET(_udpFd, &rfds);
-        maxFd = std::max(maxFd, _udpFd);
+        fds[count] = {_udpFd, POLLIN, 0};
+        udpSlot = static_cast<int>(count++);
     }
-    if (maxFd == INVALID_SOCKET_FD)
-        return false;
-    struct timeval tv
-    {
-        0, 0
-    }; // non-blocking
+    bool handled = false;
 
-    int activity = select(maxFd + 1, &rfds, nullptr, nullptr, &tv);
+    int activity = count == 0 ? 0 : POLL(fds, count, 0); // non-blocking
     if (activity < 0)
         return false;
 
-    bool handled = false;
-    if (_tcpFd != INVALID_SOCKET_FD && FD_ISSET(_tcpFd, &rfds))
+    if (activity > 0 && tcpSlot >= 0 && (fds[tcpSlot].revents & (POLLIN | POLLHUP | POLLERR)))
     {
         Packet p;
         if (readTcpPacket(p))
@@ -267,18 +405,70 @@ bool NetworkClient::pollPackets()
             handled = true;
         }
     }
-    if (_udpFd != INVALID_SOCKET_FD && FD_ISSET(_udpFd, &rfds))
+    if (activity > 0 && udpSlot >= 0 && _udpFd != INVALID_SOCKET_FD && (fds[udpSlot].revents & POLLIN))
     {
-        Packet p;
-        if (readUdpPacket(p))
+        uint8_t buffer[BUFFER_SIZE];
+        std::size_t len = 0;
+        long long arrivalMs = 0;
+        if (readUdpDatagram(buffer, sizeof(buffer), len, arrivalMs))
         {
-            handleUdpPacket(p);
+            receiveUdpDatagram(buffer, len, arrivalMs);
             handled = true;
         }
     }
+    if (pumpImpairment())
+        handled = true;
+    if (_snapshots.update())
+    {
+        _events.push_back({NetEventType::Snapshot, {}});
+        handled = true;
+    }
     return handled;
 }
 
+void NetworkClient::setThreadedReceive(bool enabled)
+{
+    _threadedReceive = enabled;
+    if (!enabled)
+        stopReceiveThread();
+    else if (_udpFd != INVALID_SOCKET_FD)
+        startReceiveThread();
+}
+
+void NetworkClient::startReceiveThread()
+{
+    if (_rxThread.joinable() || _udpFd == INVALID_SOCKET_FD)
+        return;
+    _rxRunning = true;
+    _rxThread = std::thread(&NetworkClient::receiveLoop, this);
+}
+
+void NetworkClient::stopReceiveThread()
+{
+    if (!_rxThread.joinable())
+        return;
+    _rxRunning = false;
+    _rxThread.join();
+}
+
+void NetworkClient::receiveLoop()
+{
+    while (_rxRunning.load(std::memory_order_relaxed))
+    {
+        pollfd fd{_udpFd, POLLIN, 0};
+        // Short timeout so stopReceiveThread() never waits long (and delayed datagrams stay on time).
+        bool readable = POLL(&fd, 1, _udpIn.enabled() ? 1 : 5) > 0;
+        deliverDelayedUdp();
+        if (!readable)
+            continue;
+        uint8_t buffer[BUFFER_SIZE];
+        std::size_t len = 0;
+        long long arrivalMs = 0;
+        if (readUdpDatagram(buffer, sizeof(buffer), len, arrivalMs))
+            receiveUdpDatagram(buffer, len, arrivalMs);
+    }
+}
+
 void NetworkClient::handleTcpPacket(const Packet &p)
 {
     switch (p.type)
@@ -286,15 +476,30 @@ void NetworkClient::handleTcpPacket(const Packet &p)
     case PacketType::PING:
         if (sendPong())
         {
-            _events.push_back("PING");
+            _events.push_back({NetEventType::Ping, {}});
         }
         else
         {
-            _events.push_back("PING_SEND_FAIL");
+            _events.push_back({NetEventType::PingSendFail, {}});
+        }
+        break;
+    case PacketType::SERVER_HELLO:
+        if (_awaitingAccept && !sendPacketTcp(makeClientHello()))
+        {
+            _events.push_back({NetEventType::Timeout, {}});
+            disconnect();
+        }
+        break;
+    case PacketType::OK:
+        if (_awaitingAccept && p.payload.size() >= 2)
+        {
+            _playerId = (p.payload[0] << 8) | p.payload[1];
+            _awaitingAccept = false;
+            _events.push_back({NetEventType::Connected, {}});
         }
         break;
     case PacketType::REFUSED:
-        _events.push_back("REFUSED:" + std::string(p.payload.begin(), p.payload.end()));
+        _events.push_back({NetEventType::Refused, std::string(p.payload.begin(), p.payload.end())});
         disconnect();
         break;
     case PacketType::PLAYER_LIST:
@@ -314,7 +519,7 @@ void NetworkClient::handleTcpPacket(const Packet &p)
                     uint8_t hp = p.payload[off + 4];
                     _lastPlayerList.push_back({id, x, y, hp, 0});
                 }
-                _events.push_back("PLAYER_LIST");
+                _events.push_back({NetEventType::PlayerList, {}});
             }
         }
         break;
@@ -326,7 +531,7 @@ void NetworkClient::handleTcpPacket(const Packet &p)
             uint8_t y = p.payload[3];
             uint8_t hp = p.payload[4];
             _lastPlayerList.push_back({id, x, y, hp, 0});
-            _events.push_back("NEW_PLAYER");
+            _events.push_back({NetEventType::NewPlayer, {}});
         }
         break;
     case PacketType::LOBBY_OK: {
@@ -347,138 +552,87 @@ void NetworkClient::handleTcpPacket(const Packet &p)
                 _udpAddr.sin_port = htons(static_cast<uint16_t>(port));
             }
         }
-        _events.push_back("LOBBY_OK:" + _lobbyCode);
+        _events.push_back({NetEventType::LobbyOk, _lobbyCode});
         break;
     }
     case PacketType::LOBBY_ERROR:
-        _events.push_back("LOBBY_ERROR:" + std::string(p.payload.begin(), p.payload.end()));
+        _events.push_back({NetEventType::LobbyError, std::string(p.payload.begin(), p.payload.end())});
         break;
     case PacketType::MESSAGE:
-        std::cout << "[CLIENT] recv MESSAGE \"" << std::string(p.payload.begin(), p.payload.end()) << "\"\n";
-        _events.push_back("MESSAGE:" + std::string(p.payload.begin(), p.payload.end()));
+        if (_verbose)
+            std::cout << "[CLIENT] recv MESSAGE \"" << std::string(p.payload.begin(), p.payload.end()) << "\"\n";
+        _events.push_back({NetEventType::Message, std::string(p.payload.begin(), p.payload.end())});
         break;
     default:
         break;
     }
 }
 
-void NetworkClient::handleUdpPacket(const Packet &p)
+void NetworkClient::handleUdpDatagram(const uint8_t *data, std::size_t len, long long arrivalMs)
 {
-    if (p.type == PacketType::SNAPSHOT && !p.payload.empty())
-    {
-        auto parseSnapshot = [&](size_t perPlayer, bool hasScore, std::vector<PlayerState> &players,
-                                 std::vector<BulletState> &bullets, std::vector<MonsterState> &monsters, uint16_t &seq,
-                                 bool &hasSeq) -> bool {
-            uint8_t count = p.payload[0];
-            size_t off = 1;
-            size_t expectedPlayers = off + count * perPlayer;
-            if (p.payload.size() < expectedPlayers)
-                return false;
-
-            for (size_t i = 0; i < count; ++i)
-            {
-                size_t idx = off + i * perPlayer;
-                int id = (p.payload[idx] << 8) | p.payload[idx + 1];
-                uint8_t x = p.payload[idx + 2];
-                uint8_t y = p.payload[idx + 3];
-                uint8_t hp = p.payload[idx + 4];
-                uint16_t score = 0;
-                if (hasScore)
-                {
-                    score = (p.payload[idx + 5] << 8) | p.payload[idx + 6];
-                }
-                players.push_back({id, x, y, hp, score});
-            }
-
-            off = expectedPlayers;
-            if (off >= p.payload.size())
-                return true;
-
-            uint8_t bulletCount = p.payload[off++];
-            size_t expectedBullets = off + bulletCount * 6;
-            if (p.payload.size() < expectedBullets)
-                return false;
-            for (size_t i = 0; i < bulletCount; ++i)
-            {
-                size_t idx = off + i * 6;
-                int id = (p.payload[idx] << 8) | p.payload[idx + 1];
-                uint8_t x = p.payload[idx + 2];
-                uint8_t y = p.payload[idx + 3];
-                int8_t vx = static_cast<int8_t>(p.payload[idx + 4]);
-                int8_t vy = static_cast<int8_t>(p.payload[idx + 5]);
-                bullets.push_back({id, x, y, vx, vy});
-            }
-
-            off = expectedBullets;
-            if (off < p.payload.size())
-            {
-                uint8_t monsterCount = p.payload[off++];
-                size_t expectedMonsters = off + monsterCount * 6;
-                if (p.payload.size() < expectedMonsters)
-                    return false;
-                for (size_t i = 0; i < monsterCount; ++i)
-                {
-                    size_t idx = off + i * 6;
-                    int id = (p.payload[idx] << 8) | p.payload[idx + 1];
-                    uint8_t x = p.payload[idx + 2];
-                    uint8_t y = p.payload[idx + 3];
-                    uint8_t hp = p.payload[idx + 4];
-                    uint8_t type = p.payload[idx + 5];
-                    monsters.push_back({id, x, y, hp, type});
-                }
-                off = expectedMonsters;
-            }
+    // Parse the header in place: building a Packet would copy the payload into a fresh vector.
+    if (len < HEADER_SIZE || ((data[0] << 8) | data[1]) != PACKET_MAGIC)
+        return;
+    auto type = static_cast<PacketType>(data[2]);
+    std::size_t size = data[3];
+    if (len < HEADER_SIZE + size)
+        return;
+    const uint8_t *payload = data + HEADER_SIZE;
 
-            if (p.payload.size() >= off + 2)
-            {
-                seq = (p.payload[off] << 8) | p.payload[off + 1];
-                hasSeq = true;
-            }
-            return true;
-        };
-
-        std::vector<PlayerState> players;
-        std::vector<BulletState> bullets;
-        std::vector<MonsterState> monsters;
-        uint16_t seq = 0;
-        bool hasSeq = false;
-        if (!parseSnapshot(7, true, players, bullets, monsters, seq, hasSeq))
-        {
-            players.clear();
-            bullets.clear();
-            monsters.clear();
-            hasSeq = false;
-            if (!parseSnapshot(5, false, players, bullets, monsters, seq, hasSeq))
-                return;
-        }
+    if (type == PacketType::SNAPSHOT && size > 0)
+    {
+        // Decode straight into the triple buffer's write slot; its vectors never reallocate.
+        Snapshot &snap = _snapshots.writeBuffer();
+        if (!SnapshotDecoder::decode(payload, size, snap))
+            return;
+        snap.receivedAtMs = arrivalMs;
+        if (trackSnapshotArrival(snap.seq, snap.hasSeq, arrivalMs))
+            _snapshots.publish();
+    }
+    else if (type == PacketType::PONG_UDP && size >= 4)
+    {
+        uint32_t ts = (static_cast<uint32_t>(payload[0]) << 24) | (static_cast<uint32_t>(payload[1]) << 16) |
+                      (static_cast<uint32_t>(payload[2]) << 8) | static_cast<uint32_t>(payload[3]);
+        uint32_t now = static_cast<uint32_t>(arrivalMs & 0xFFFFFFFFu);
+        _udpPingMs = static_cast<int>(now - ts);
+        _udpPongCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
 
-        _lastSnapshot = std::move(players);
-        _lastSnapshotBullets = std::move(bullets);
-        _lastSnapshotMonsters = std::move(monsters);
-        if (hasSeq)
+bool NetworkClient::trackSnapshotArrival(uint16_t seq, bool hasSeq, long long arrivalMs)
+{
+    if (hasSeq)
+    {
+        if (_hasSnapshotSeq)
         {
-            if (_hasSnapshotSeq)
+            uint16_t expected = static_cast<uint16_t>(_lastSnapshotSeq + 1);
+            uint16_t diff = static_cast<uint16_t>(seq - expected);
+            // Duplicated or overtaken: older than the snapshot already shown, and not a gap.
+            if (diff >= 0x8000)
+                return false;
+            if (diff > 0)
             {
-                uint16_t expected = static_cast<uint16_t>(_lastSnapshotSeq + 1);
-                uint16_t diff = static_cast<uint16_t>(seq - expected);
-                if (diff > 0)
-                {
-                    _snapshotLost += diff;
-                }
+                _snapshotLost += diff;
             }
-            _snapshotReceived += 1;
-            _lastSnapshotSeq = seq;
-            _hasSnapshotSeq = true;
         }
-        _events.push_back("SNAPSHOT");
+        _snapshotReceived += 1;
+        _lastSnapshotSeq = seq;
+        _hasSnapshotSeq = true;
     }
-    else if (p.type == PacketType::PONG_UDP && p.payload.size() >= 4)
+    if (_lastSnapshotArrivalMs != 0)
     {
-        uint32_t ts = (static_cast<uint32_t>(p.payload[0]) << 24) | (static_cast<uint32_t>(p.payload[1]) << 16) |
-                      (static_cast<uint32_t>(p.payload[2]) << 8) | static_cast<uint32_t>(p.payload[3]);
-        uint32_t now = static_cast<uint32_t>(nowMs() & 0xFFFFFFFFu);
-        _udpPingMs = static_cast<int>(now - ts);
+        long long interval = arrivalMs - _lastSnapshotArrivalMs;
+        if (_lastSnapshotIntervalMs >= 0)
+        {
+            // RFC 3550 style smoothing of the inter-arrival variation.
+            float deviation = static_cast<float>(std::llabs(interval - _lastSnapshotIntervalMs));
+            float jitter = _snapshotJitterMs.load(std::memory_order_relaxed);
+            _snapshotJitterMs.store(jitter + (deviation - jitter) / 16.0f, std::memory_order_relaxed);
+        }
+        _lastSnapshotIntervalMs = interval;
     }
+    _lastSnapshotArrivalMs = arrivalMs;
+    return true;
 }
 
 bool NetworkClient::writeAll(socket_t fd, const uint8_t *data, std::size_t size)
@@ -514,6 +668,7 @@ NetworkClient::RecvResult NetworkClient::receiveTcpFramed(Packet &p)
 
 void NetworkClient::disconnect()
 {
+    stopReceiveThread();
     if (_tcpFd != -1)
     {
         CLOSE(_tcpFd);
@@ -525,12 +680,15 @@ void NetworkClient::disconnect()
         _udpFd = -1;
     }
     _tcpConnected = false;
+    _tcpConnecting = false;
+    _awaitingAccept = false;
     _udpConnected = false;
     _lobbyCode.clear();
 }
 
 void NetworkClient::disconnectUdp()
 {
+    stopReceiveThread();
     if (_udpFd != -1)
     {
         CLOSE(_udpFd);
@@ -541,27 +699,32 @@ void NetworkClient::disconnectUdp()
 
 bool NetworkClient::ensureUdp()
 {
-    if (_udpFd != -1)
-        return true;
-    _udpFd = socket(AF_INET, SOCK_DGRAM, 0);
-    if (_udpFd < 0)
-        return false;
-    _udpConnected = true;
+    if (_udpFd == -1)
+    {
+        _udpFd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (_udpFd < 0)
+            return false;
+        _udpConnected = true;
+    }
+    if (_threadedReceive)
+        startReceiveThread();
     return true;
 }
 
 void NetworkClient::resetForLobby()
 {
+    stopReceiveThread();
     _lobbyCode.clear();
     _events.clear();
-    _lastSnapshot.clear();
-    _lastSnapshotBullets.clear();
-    _lastSnapshotMonsters.clear();
+    _snapshots.reset();
     _lastPlayerList.clear();
     _tcpRecvBuffer.clear();
     _hasSnapshotSeq = false;
     _snapshotReceived = 0;
     _snapshotLost = 0;
+    _snapshotJitterMs = 0.0f;
+    _lastSnapshotArrivalMs = 0;
+    _lastSnapshotIntervalMs = -1;
     _udpPingMs = -1;
     _udpBytesInWindow = 0;
     _udpBytesOutWindow = 0;
@@ -573,17 +736,19 @@ void NetworkClient::resetForLobby()
 
 void NetworkClient::resetForReconnect()
 {
+    stopReceiveThread();
     _playerId = -1;
     _lobbyCode.clear();
     _events.clear();
-    _lastSnapshot.clear();
-    _lastSnapshotBullets.clear();
-    _lastSnapshotMonsters.clear();
+    _snapshots.reset();
     _lastPlayerList.clear();
     _tcpRecvBuffer.clear();
     _hasSnapshotSeq = false;
     _snapshotReceived = 0;
     _snapshotLost = 0;
+    _snapshotJitterMs = 0.0f;
+    _lastSnapshotArrivalMs = 0;
+    _lastSnapshotIntervalMs = -1;
     _udpPingMs = -1;
     _udpBytesInWindow = 0;
     _udpBytesOutWindow = 0;
@@ -7,15 +7,21 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <string>
+#include <thread>
 // #include <netinet/in.h>
 #ifndef _WIN32
 #include <sys/select.h>
 #endif
 #include "../TransportLayer/Packet.hpp"
+#include "../TransportLayer/UDP/Impairment.hpp"
 #include "../TransportLayer/UDP/UDPSocket.hpp"
 #include "GameState.hpp"
+#include "NetEvent.hpp"
+#include "Snapshot.hpp"
+#include "TripleBuffer.hpp"
 
 /**
  * @brief TCP+UDP client responsible for handshake, lobby, and gameplay packets.
@@ -42,6 +48,21 @@ class NetworkClient
      * @brief Perform the application handshake over TCP.
      */
     bool performHandshake();
+    /**
+     * @brief Start connectToServer() and performHandshake() without blocking.
+     *
+     * pollPackets() completes the TCP connect, answers SERVER_HELLO and queues
+     * NetEventType::Connected once the server sent OK (Refused or Timeout otherwise).
+     * Callers polling getTcpFd() themselves wait for writability while isConnecting().
+     */
+    bool beginConnect();
+    /**
+     * @brief Return true while the TCP connect started by beginConnect() is in progress.
+     */
+    bool isConnecting() const
+    {
+        return _tcpConnecting;
+    }
     /**
      * @brief Send TCP PONG in response to server PING.
      */
@@ -87,6 +108,13 @@ class NetworkClient
     {
         _pseudo = pseudo;
     }
+    /**
+     * @brief Log lobby requests and chat to stdout (on by default; off for many clients in one process).
+     */
+    void setVerbose(bool verbose)
+    {
+        _verbose = verbose;
+    }
     /**
      * @brief Send a UDP ping with client timestamp.
      */
@@ -94,8 +122,26 @@ class NetworkClient
 
     /**
      * @brief Poll TCP/UDP sockets and handle any received packets.
+     *
+     * With threaded receive, UDP is read by the receive thread and this only picks up
+     * the latest decoded snapshot.
      */
     bool pollPackets();
+    /**
+     * @brief Read and decode UDP on a dedicated thread instead of in pollPackets().
+     *
+     * The thread runs while the UDP socket is open; snapshots reach the caller's thread
+     * through a lock-free triple buffer and ping/jitter use arrival timestamps, so slow
+     * frames no longer delay reads or inflate RTT.
+     */
+    void setThreadedReceive(bool enabled);
+    /**
+     * @brief Return true when UDP is read on the receive thread.
+     */
+    bool isThreadedReceive() const
+    {
+        return _threadedReceive;
+    }
     /**
      * @brief Close TCP and UDP sockets and reset state.
      */
@@ -128,6 +174,21 @@ class NetworkClient
      */
     void updateServerAddress(const std::string &ip, uint16_t port);
 
+    /**
+     * @brief TCP socket, or INVALID_SOCKET_FD (for callers multiplexing many clients).
+     */
+    socket_t getTcpFd() const
+    {
+        return _tcpFd;
+    }
+    /**
+     * @brief UDP socket, or INVALID_SOCKET_FD.
+     */
+    socket_t getUdpFd() const
+    {
+        return _udpFd;
+    }
+
     /**
      * @brief Get server-assigned player id.
      */
@@ -154,21 +215,28 @@ class NetworkClient
      */
     const std::vector<PlayerState> &getLastSnapshot() const
     {
-        return _lastSnapshot;
+        return _snapshots.readBuffer().players;
     }
     /**
      * @brief Get last received bullet snapshots.
      */
     const std::vector<BulletState> &getLastSnapshotBullets() const
     {
-        return _lastSnapshotBullets;
+        return _snapshots.readBuffer().bullets;
     }
     /**
      * @brief Get last received monster snapshots.
      */
     const std::vector<MonsterState> &getLastSnapshotMonsters() const
     {
-        return _lastSnapshotMonsters;
+        return _snapshots.readBuffer().monsters;
+    }
+    /**
+     * @brief Steady-clock time (ms) the last snapshot was read from the socket.
+     */
+    long long getLastSnapshotTimeMs() const
+    {
+        return _snapshots.readBuffer().receivedAtMs;
     }
     /**
      * @brief Get last received player list from TCP.
@@ -180,7 +248,7 @@ class NetworkClient
     /**
      * @brief Get pending network events.
      */
-    const std::vector<std::string> &getEvents() const
+    const std::vector<NetEvent> &getEvents() const
     {
         return _events;
     }
@@ -196,7 +264,21 @@ class NetworkClient
      */
     int getUdpPingMs() const
     {
-        return _udpPingMs;
+        return _udpPingMs.load(std::memory_order_relaxed);
+    }
+    /**
+     * @brief Number of UDP pongs received, to tell when getUdpPingMs() is a new sample.
+     */
+    uint32_t getUdpPongCount() const
+    {
+        return _udpPongCount.load(std::memory_order_relaxed);
+    }
+    /**
+     * @brief Smoothed variation of the snapshot inter-arrival time, in ms.
+     */
+    float getSnapshotJitterMs() const
+    {
+        return _snapshotJitterMs.load(std::memory_order_relaxed);
     }
     /**
      * @brief Estimated snapshot loss percentage.
@@ -211,6 +293,25 @@ class NetworkClient
      */
     float getUdpTxKbps();
 
+    /**
+     * @brief Run UDP sends and receives through a simulated bad network (inbound uses seed + 1).
+     *
+     * Delayed datagrams only move when pollPackets() or pumpImpairment() runs (or the
+     * receive thread, for inbound), so call one of them every frame.
+     */
+    void setImpairment(const Network::TransportLayer::Impairment::Config &config);
+
+    /**
+     * @brief Send and deliver the delayed datagrams that are due.
+     * @return true if a datagram was delivered.
+     */
+    bool pumpImpairment();
+
+    /**
+     * @brief Both directions of the simulated network added up (not synchronized with the receive thread).
+     */
+    Network::TransportLayer::Impairment::Stats getImpairmentStats() const;
+
   private:
     /**
      * @brief Result of a framed TCP receive attempt.
@@ -221,43 +322,64 @@ class NetworkClient
         Incomplete,
         Ok
     };
+    Packet makeClientHello() const;
+    bool finishConnect();
     bool readTcpPacket(Packet &p);
-    bool readUdpPacket(Packet &p);
+    bool readUdpDatagram(uint8_t *buffer, std::size_t capacity, std::size_t &len, long long &arrivalMs);
+    void receiveUdpDatagram(const uint8_t *data, std::size_t len, long long arrivalMs);
+    bool deliverDelayedUdp();
+    bool sendUdpBytes(const uint8_t *data, std::size_t size);
     bool sendPacketTcp(const Packet &p);
     bool sendPacketUdp(const Packet &p);
     void handleTcpPacket(const Packet &p);
-    void handleUdpPacket(const Packet &p);
+    void handleUdpDatagram(const uint8_t *data, std::size_t len, long long arrivalMs);
+    bool trackSnapshotArrival(uint16_t seq, bool hasSeq, long long arrivalMs);
+    void startReceiveThread();
+    void stopReceiveThread();
+    void receiveLoop();
     bool writeAll(socket_t fd, const uint8_t *data, std::size_t size);
     RecvResult receiveTcpFramed(Packet &p);
 
     socket_t _tcpFd = -1;
     socket_t _udpFd = -1;
     bool _tcpConnected = false;
+    bool _tcpConnecting = false;  ///< beginConnect() waiting for the socket to become writable
+    bool _awaitingAccept = false; ///< beginConnect() handshake waiting for SERVER_HELLO/OK
     bool _udpConnected = false;
     sockaddr_in _tcpAddr{};
     sockaddr_in _udpAddr{};
     int _playerId = -1;
     std::string _lobbyCode;
     std::string _pseudo;
+    bool _verbose = true;
 
-    std::vector<PlayerState> _lastSnapshot;
-    std::vector<BulletState> _lastSnapshotBullets;
-    std::vector<MonsterState> _lastSnapshotMonsters;
+    TripleBuffer<Snapshot> _snapshots; ///< written by whoever reads UDP, read by pollPackets' caller
     std::vector<PlayerState> _lastPlayerList;
-    std::vector<std::string> _events;
+    std::vector<NetEvent> _events;
     std::vector<uint8_t> _tcpRecvBuffer;
     uint16_t _lastSnapshotSeq = 0;
     bool _hasSnapshotSeq = false;
-    uint64_t _snapshotReceived = 0;
-    uint64_t _snapshotLost = 0;
-    int _udpPingMs = -1;
+    std::atomic<uint64_t> _snapshotReceived{0};
+    std::atomic<uint64_t> _snapshotLost{0};
+    std::atomic<int> _udpPingMs{-1};
+    std::atomic<uint32_t> _udpPongCount{0};
+    std::atomic<float> _snapshotJitterMs{0.0f};
+    long long _lastSnapshotArrivalMs = 0;
+    long long _lastSnapshotIntervalMs = -1;
     uint32_t _udpLastPingSentMs = 0;
-    uint64_t _udpBytesInWindow = 0;
+    std::atomic<uint64_t> _udpBytesInWindow{0};
     uint64_t _udpBytesOutWindow = 0;
     long long _udpRateWindowStartMs = 0;
     float _udpRxKbps = 0.0f;
     float _udpTxKbps = 0.0f;
 
+    Network::TransportLayer::Impairment _udpOut; ///< main thread
+    Network::TransportLayer::Impairment _udpIn;  ///< whoever reads UDP
+
+    bool _threadedReceive = false;
+    std::atomic<bool> _rxRunning{false};
+    std::thread _rxThread;
+
     long long nowMs() const;
     void updateUdpRates(long long nowMs);
 };
@@ -0,0 +1,51 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Decoded UDP world snapshot
+*/
+
+#pragma once
+
+#include "GameState.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief One decoded SNAPSHOT packet with its arrival time.
+ *
+ * The vectors are reserved for the largest section a packet can carry, so decoding into
+ * a reused Snapshot never allocates.
+ */
+struct Snapshot
+{
+    static constexpr std::size_t kMaxEntries = 255; ///< section counts are one byte
+
+    Snapshot()
+    {
+        players.reserve(kMaxEntries);
+        bullets.reserve(kMaxEntries);
+        monsters.reserve(kMaxEntries);
+    }
+
+    /**
+     * @brief Empty the snapshot, keeping its capacity.
+     */
+    void clear()
+    {
+        players.clear();
+        bullets.clear();
+        monsters.clear();
+        seq = 0;
+        hasSeq = false;
+        receivedAtMs = 0;
+    }
+
+    std::vector<PlayerState> players;
+    std::vector<BulletState> bullets;
+    std::vector<MonsterState> monsters;
+    uint16_t seq = 0;
+    bool hasSeq = false;
+    long long receivedAtMs = 0; ///< steady-clock time the datagram was read from the socket
+};
@@ -0,0 +1,113 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** SNAPSHOT payload decoder
+*/
+
+#include "SnapshotDecoder.hpp"
+
+namespace
+{
+constexpr std::size_t kBulletSize = 6;
+constexpr std::size_t kMonsterSize = 6;
+
+inline int readId(const uint8_t *p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+/**
+ * @brief Offset right after the monster section, or 0 if the layout does not fit.
+ */
+std::size_t sectionsEnd(const uint8_t *payload, std::size_t size, std::size_t perPlayer)
+{
+    std::size_t off = 1 + payload[0] * perPlayer;
+    if (off > size)
+        return 0;
+    if (off == size)
+        return off;
+    off += 1 + payload[off] * kBulletSize;
+    if (off > size)
+        return 0;
+    if (off == size)
+        return off;
+    off += 1 + payload[off] * kMonsterSize;
+    return off > size ? 0 : off;
+}
+} // namespace
+
+SnapshotDecoder::Layout SnapshotDecoder::detectLayout(const uint8_t *payload, std::size_t size)
+{
+    if (size == 0)
+        return Layout::Invalid;
+    if (sectionsEnd(payload, size, static_cast<std::size_t>(Layout::Scored)) != 0)
+        return Layout::Scored;
+    if (sectionsEnd(payload, size, static_cast<std::size_t>(Layout::Compact)) != 0)
+        return Layout::Compact;
+    return Layout::Invalid;
+}
+
+bool SnapshotDecoder::decode(const uint8_t *payload, std::size_t size, Snapshot &out)
+{
+    out.players.clear();
+    out.bullets.clear();
+    out.monsters.clear();
+    out.seq = 0;
+    out.hasSeq = false;
+
+    Layout layout = detectLayout(payload, size);
+    if (layout == Layout::Invalid)
+        return false;
+    const std::size_t perPlayer = static_cast<std::size_t>(layout);
+    const bool hasScore = layout == Layout::Scored;
+
+    // detectLayout() validated every section bound, so the reads below stay in range.
+    std::size_t off = 0;
+    out.players.resize(payload[off++]);
+    for (auto &player : out.players)
+    {
+        const uint8_t *p = payload + off;
+        player.id = readId(p);
+        player.x = p[2];
+        player.y = p[3];
+        player.hp = p[4];
+        player.score = hasScore ? static_cast<uint16_t>((p[5] << 8) | p[6]) : 0;
+        off += perPlayer;
+    }
+    if (off == size)
+        return true;
+
+    out.bullets.resize(payload[off++]);
+    for (auto &bullet : out.bullets)
+    {
+        const uint8_t *p = payload + off;
+        bullet.id = readId(p);
+        bullet.x = p[2];
+        bullet.y = p[3];
+        bullet.vx = static_cast<int8_t>(p[4]);
+        bullet.vy = static_cast<int8_t>(p[5]);
+        off += kBulletSize;
+    }
+    if (off == size)
+        return true;
+
+    out.monsters.resize(payload[off++]);
+    for (auto &monster : out.monsters)
+    {
+        const uint8_t *p = payload + off;
+        monster.id = readId(p);
+        monster.x = p[2];
+        monster.y = p[3];
+        monster.hp = p[4];
+        monster.type = p[5];
+        off += kMonsterSize;
+    }
+
+    if (size >= off + 2)
+    {
+        out.seq = static_cast<uint16_t>(readId(payload + off));
+        out.hasSeq = true;
+    }
+    return true;
+}
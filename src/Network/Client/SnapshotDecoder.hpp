@@ -0,0 +1,48 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** SNAPSHOT payload decoder
+*/
+
+#pragma once
+
+#include "Snapshot.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Decoding of SNAPSHOT payloads into reusable Snapshot slots.
+ *
+ * Payload: player count, players (7 bytes with score, 5 without), then optionally a bullet
+ * count and 6-byte bullets, a monster count and 6-byte monsters, and a 16-bit sequence number.
+ */
+namespace SnapshotDecoder
+{
+/**
+ * @brief Bytes per player entry.
+ */
+enum class Layout : uint8_t
+{
+    Invalid = 0,
+    Compact = 5, ///< id, x, y, hp
+    Scored = 7   ///< id, x, y, hp, score
+};
+
+/**
+ * @brief Find the player layout of a payload by walking its section counts only.
+ *
+ * The scored layout is preferred when both fit, as the server sends it.
+ */
+Layout detectLayout(const uint8_t *payload, std::size_t size);
+
+/**
+ * @brief Decode a SNAPSHOT payload in a single pass.
+ *
+ * The vectors of out are resized in place; they never allocate once they reached
+ * Snapshot::kMaxEntries. out.receivedAtMs is left to the caller.
+ *
+ * @return false if the payload matches no layout (out is then left empty).
+ */
+bool decode(const uint8_t *payload, std::size_t size, Snapshot &out);
+} // namespace SnapshotDecoder
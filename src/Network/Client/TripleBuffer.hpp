@@ -0,0 +1,86 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Lock-free single-producer/single-consumer triple buffer
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Hands the latest value from one producer thread to one consumer thread without locks.
+ *
+ * The producer fills writeBuffer() and publish()es it; the consumer calls update() and
+ * reads readBuffer(). Three slots rotate through an atomic "middle" index, so neither
+ * side ever waits and the consumer always gets the most recent published value;
+ * intermediate values the consumer did not pick up are overwritten.
+ *
+ * @tparam T Slot type with a clear() member; slots are reused, so containers inside keep
+ *           their capacity.
+ */
+template <typename T> class TripleBuffer
+{
+  public:
+    /**
+     * @brief Slot owned by the producer.
+     */
+    T &writeBuffer()
+    {
+        return _slots[_write];
+    }
+
+    /**
+     * @brief Make the write slot the latest value and take the previous middle slot to write into.
+     */
+    void publish()
+    {
+        uint8_t previous = _middle.exchange(static_cast<uint8_t>(_write | kFresh), std::memory_order_acq_rel);
+        _write = previous & kIndexMask;
+    }
+
+    /**
+     * @brief Swap in the latest published value, if any.
+     *
+     * @return true if readBuffer() changed since the last call.
+     */
+    bool update()
+    {
+        if ((_middle.load(std::memory_order_acquire) & kFresh) == 0)
+            return false;
+        uint8_t previous = _middle.exchange(_read, std::memory_order_acq_rel);
+        _read = previous & kIndexMask;
+        return true;
+    }
+
+    /**
+     * @brief Slot owned by the consumer.
+     */
+    const T &readBuffer() const
+    {
+        return _slots[_read];
+    }
+
+    /**
+     * @brief Clear every slot (neither side may be running).
+     */
+    void reset()
+    {
+        for (auto &slot : _slots)
+            slot.clear();
+        _write = 0;
+        _middle.store(1, std::memory_order_relaxed);
+        _read = 2;
+    }
+
+  private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFresh = 0x4;
+
+    T _slots[3]{};
+    uint8_t _write = 0;
+    std::atomic<uint8_t> _middle{1};
+    uint8_t _read = 2;
+};
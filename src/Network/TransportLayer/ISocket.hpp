@@ -24,6 +24,9 @@
 #define SOCKET_ERROR_CODE WSAGetLastError()
 typedef SOCKET socket_t;
 #define INVALID_SOCKET_FD INVALID_SOCKET
+#define SEND_NOWAIT_FLAGS 0 // Windows has no per-call flag, sockets stay blocking there
+#define SOCKET_WOULD_BLOCK(err) ((err) == WSAEWOULDBLOCK)
+#define POLL(fds, count, timeoutMs) WSAPoll(fds, count, timeoutMs)
 using ssize_t = std::ptrdiff_t;
 
 #else
@@ -33,6 +36,7 @@ using ssize_t = std::ptrdiff_t;
 #include <errno.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <sys/select.h>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -43,6 +47,13 @@ using ssize_t = std::ptrdiff_t;
 #define SOCKET_ERROR_CODE errno
 typedef int socket_t;
 #define INVALID_SOCKET_FD -1
+#ifdef MSG_NOSIGNAL
+#define SEND_NOWAIT_FLAGS (MSG_DONTWAIT | MSG_NOSIGNAL)
+#else
+#define SEND_NOWAIT_FLAGS MSG_DONTWAIT
+#endif
+#define SOCKET_WOULD_BLOCK(err) ((err) == EAGAIN || (err) == EWOULDBLOCK)
+#define POLL(fds, count, timeoutMs) ::poll(fds, count, timeoutMs)
 
 #endif
 
@@ -9,41 +9,67 @@
 
 std::vector<uint8_t> Packet::serialize() const
 {
-    if (payload.size() > UINT8_MAX)
-        throw std::runtime_error("Payload too large");
-
     std::vector<uint8_t> buffer;
     buffer.reserve(4 + payload.size());
+    serializeTo(buffer);
+    return buffer;
+}
 
-    buffer.push_back(static_cast<uint8_t>(header >> 8));
-    buffer.push_back(static_cast<uint8_t>(header & 0xFF));
+void Packet::serializeTo(std::vector<uint8_t> &out) const
+{
+    if (payload.size() > UINT8_MAX)
+        throw std::runtime_error("Payload too large");
 
-    buffer.push_back(static_cast<uint8_t>(type));
-    buffer.push_back(static_cast<uint8_t>(payload.size()));
+    out.push_back(static_cast<uint8_t>(header >> 8));
+    out.push_back(static_cast<uint8_t>(header & 0xFF));
 
-    buffer.insert(buffer.end(), payload.begin(), payload.end());
+    out.push_back(static_cast<uint8_t>(type));
+    out.push_back(static_cast<uint8_t>(payload.size()));
 
-    return buffer;
+    out.insert(out.end(), payload.begin(), payload.end());
 }
 
 Packet Packet::deserialize(const uint8_t *data, size_t len)
+{
+    Packet p;
+    ParseStatus status = tryDeserialize(data, len, p);
+    if (status != ParseStatus::Ok)
+        throw std::runtime_error(parseStatusName(status));
+    return p;
+}
+
+ParseStatus Packet::tryDeserialize(const uint8_t *data, size_t len, Packet &out)
 {
     if (len < 4)
-        throw std::runtime_error("Packet too small");
+        return ParseStatus::TooShort;
 
     uint16_t magic = (data[0] << 8) | data[1];
-    if (magic != 0x5254)
-        throw std::runtime_error("Bad header");
+    if (magic != PACKET_MAGIC)
+        return ParseStatus::BadMagic;
 
-    Packet p;
-    p.header = magic;
-    p.type = static_cast<PacketType>(data[2]);
-    p.size = data[3];
+    uint8_t size = data[3];
+    if (len < 4 + static_cast<size_t>(size))
+        return ParseStatus::Incomplete;
 
-    if (len < 4 + p.size)
-        throw std::runtime_error("Incomplete payload");
-
-    p.payload.assign(data + 4, data + 4 + p.size);
+    out.header = magic;
+    out.type = static_cast<PacketType>(data[2]);
+    out.size = size;
+    out.payload.assign(data + 4, data + 4 + size);
+    return ParseStatus::Ok;
+}
 
-    return p;
+const char *parseStatusName(ParseStatus status)
+{
+    switch (status)
+    {
+    case ParseStatus::Ok:
+        return "Ok";
+    case ParseStatus::TooShort:
+        return "Packet too small";
+    case ParseStatus::BadMagic:
+        return "Bad header";
+    case ParseStatus::Incomplete:
+        return "Incomplete payload";
+    }
+    return "Unknown";
 }
@@ -42,6 +42,22 @@ enum class PacketType : uint8_t
     PONG_UDP = 19   ///< UDP pong response.
 };
 
+/**
+ * @brief Result of a non-throwing packet parse.
+ */
+enum class ParseStatus : uint8_t
+{
+    Ok,        ///< Packet parsed.
+    TooShort,  ///< Fewer bytes than a header.
+    BadMagic,  ///< Header magic is not PACKET_MAGIC.
+    Incomplete ///< Payload shorter than the size field says.
+};
+
+/**
+ * @brief Human-readable name of a ParseStatus, for logs.
+ */
+const char *parseStatusName(ParseStatus status);
+
 /**
  * @brief Light container for game protocol packets with (de)serialization helpers.
  */
@@ -73,6 +89,16 @@ class Packet
      */
     std::vector<uint8_t> serialize() const;
 
+    /**
+     * @brief Append the serialized packet to an existing buffer.
+     *
+     * Lets callers that add their own framing encode without an intermediate vector.
+     *
+     * @param out Buffer the header, type, size and payload are appended to.
+     * @throws std::runtime_error if the payload does not fit the size field.
+     */
+    void serializeTo(std::vector<uint8_t> &out) const;
+
     /**
      * @brief Deserialize a packet from a raw byte buffer.
      *
@@ -82,4 +108,17 @@ class Packet
      * @throws std::runtime_error if the buffer is invalid.
      */
     static Packet deserialize(const uint8_t *data, size_t len);
+
+    /**
+     * @brief Deserialize without throwing, for bytes straight off the network.
+     *
+     * Garbage costs a few compares instead of an exception unwind, and out's payload
+     * capacity is reused, so parsing into the same Packet does not allocate.
+     *
+     * @param data Pointer to the raw buffer.
+     * @param len Length of the buffer.
+     * @param out Parsed packet; left unspecified unless the result is ParseStatus::Ok.
+     * @return ParseStatus::Ok or why the buffer was rejected.
+     */
+    static ParseStatus tryDeserialize(const uint8_t *data, size_t len, Packet &out);
 };
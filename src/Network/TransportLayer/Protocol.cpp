@@ -10,49 +10,58 @@
 
 std::vector<uint8_t> Protocol::frameTcp(const Packet &packet)
 {
-    std::vector<uint8_t> payload = packet.serialize();
-    if (payload.size() > UINT16_MAX)
+    std::vector<uint8_t> framed;
+    framed.reserve(2 + 4 + packet.payload.size());
+    framed.push_back(0);
+    framed.push_back(0);
+    packet.serializeTo(framed);
+    std::size_t len = framed.size() - 2;
+    if (len > UINT16_MAX)
     {
         throw std::runtime_error("Payload too large for framing");
     }
-    uint16_t len = static_cast<uint16_t>(payload.size());
-    std::vector<uint8_t> framed;
-    framed.reserve(payload.size() + 2);
-    framed.push_back(static_cast<uint8_t>(len >> 8));
-    framed.push_back(static_cast<uint8_t>(len & 0xFF));
-    framed.insert(framed.end(), payload.begin(), payload.end());
+    framed[0] = static_cast<uint8_t>(len >> 8);
+    framed[1] = static_cast<uint8_t>(len & 0xFF);
     return framed;
 }
 
-Protocol::StreamStatus Protocol::extractFromBuffer(std::vector<uint8_t> &recvBuffer, Packet &out)
+Protocol::Frame Protocol::encodeFrame(const Packet &packet)
 {
-    while (recvBuffer.size() >= 2)
+    return std::make_shared<const std::vector<uint8_t>>(frameTcp(packet));
+}
+
+Protocol::StreamStatus Protocol::extractFromBuffer(std::vector<uint8_t> &recvBuffer, Packet &out,
+                                                   std::size_t *malformed)
+{
+    std::size_t offset = 0;
+    StreamStatus status = StreamStatus::Incomplete;
+    while (recvBuffer.size() - offset >= 2)
     {
-        uint16_t len = (static_cast<uint16_t>(recvBuffer[0]) << 8) | recvBuffer[1];
-        if (recvBuffer.size() < 2 + len)
-            return StreamStatus::Incomplete;
+        uint16_t len = (static_cast<uint16_t>(recvBuffer[offset]) << 8) | recvBuffer[offset + 1];
+        if (recvBuffer.size() - offset < 2u + len)
+            break;
 
-        std::vector<uint8_t> pktData(recvBuffer.begin() + 2, recvBuffer.begin() + 2 + len);
-        recvBuffer.erase(recvBuffer.begin(), recvBuffer.begin() + 2 + len);
-        try
-        {
-            out = Packet::deserialize(pktData.data(), pktData.size());
-            return StreamStatus::Ok;
-        }
-        catch (const std::exception &)
+        // Parsed in place; only the consumed bytes are erased, once.
+        const uint8_t *frame = recvBuffer.data() + offset + 2;
+        offset += 2u + len;
+        if (Packet::tryDeserialize(frame, len, out) == ParseStatus::Ok)
         {
-            // malformed packet, skip and continue parsing
-            continue;
+            status = StreamStatus::Ok;
+            break;
         }
+        // malformed packet, skip and continue parsing
+        if (malformed)
+            ++*malformed;
     }
-    return StreamStatus::Incomplete;
+    recvBuffer.erase(recvBuffer.begin(), recvBuffer.begin() + static_cast<std::ptrdiff_t>(offset));
+    return status;
 }
 
 Protocol::StreamStatus Protocol::consumeChunk(const uint8_t *data, std::size_t len, std::vector<uint8_t> &recvBuffer,
-                                              Packet &out)
+                                              Packet &out, std::size_t *malformed)
 {
     if (len == 0)
         return StreamStatus::Incomplete;
     recvBuffer.insert(recvBuffer.end(), data, data + len);
-    return extractFromBuffer(recvBuffer, out);
+    return extractFromBuffer(recvBuffer, out, malformed);
 }
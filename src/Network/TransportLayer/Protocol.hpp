@@ -9,6 +9,7 @@
 
 #include "Packet.hpp"
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace Protocol
@@ -30,17 +31,36 @@ enum class StreamStatus
  */
 std::vector<uint8_t> frameTcp(const Packet &packet);
 
+/**
+ * @brief Immutable, refcounted TCP frame.
+ *
+ * Encoded once and shared by every recipient of a broadcast; each recipient
+ * only holds a reference until its socket has taken the bytes.
+ */
+using Frame = std::shared_ptr<const std::vector<uint8_t>>;
+
+/**
+ * @brief Frame a packet into a shareable buffer.
+ *
+ * @throw std::runtime_error if payload is too large.
+ */
+Frame encodeFrame(const Packet &packet);
+
 /**
  * @brief Try to extract a complete packet from an accumulated stream buffer.
  *
+ * Malformed frames are skipped without throwing; parsing goes on with the next frame.
+ *
  * @param recvBuffer Mutable buffer that stores previous bytes.
  * @param out Parsed packet on success.
+ * @param malformed If set, incremented for every frame skipped.
  * @return StreamStatus
  */
-StreamStatus extractFromBuffer(std::vector<uint8_t> &recvBuffer, Packet &out);
+StreamStatus extractFromBuffer(std::vector<uint8_t> &recvBuffer, Packet &out, std::size_t *malformed = nullptr);
 
 /**
  * @brief Append newly read bytes then attempt extraction.
  */
-StreamStatus consumeChunk(const uint8_t *data, std::size_t len, std::vector<uint8_t> &recvBuffer, Packet &out);
+StreamStatus consumeChunk(const uint8_t *data, std::size_t len, std::vector<uint8_t> &recvBuffer, Packet &out,
+                          std::size_t *malformed = nullptr);
 } // namespace Protocol
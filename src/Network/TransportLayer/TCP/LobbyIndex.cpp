@@ -0,0 +1,57 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Indexed lobby membership for the TCP server
+*/
+
+#include "LobbyIndex.hpp"
+
+LobbyIndex::LobbyId LobbyIndex::intern(const std::string &code)
+{
+    auto it = _ids.find(code);
+    if (it != _ids.end())
+        return it->second;
+    LobbyId id = static_cast<LobbyId>(_lobbies.size());
+    _lobbies.push_back(Lobby{code, {}});
+    _ids.emplace(code, id);
+    return id;
+}
+
+std::optional<LobbyIndex::LobbyId> LobbyIndex::find(const std::string &code) const
+{
+    auto it = _ids.find(code);
+    if (it == _ids.end())
+        return std::nullopt;
+    return it->second;
+}
+
+void LobbyIndex::join(LobbyId id, std::size_t slot)
+{
+    leave(slot);
+    if (slot >= _slotLobby.size())
+    {
+        _slotLobby.resize(slot + 1, INVALID_LOBBY);
+        _slotIndex.resize(slot + 1, 0);
+    }
+    auto &members = _lobbies[id].members;
+    _slotLobby[slot] = id;
+    _slotIndex[slot] = members.size();
+    members.push_back(slot);
+}
+
+LobbyIndex::LobbyId LobbyIndex::leave(std::size_t slot)
+{
+    LobbyId id = lobbyOf(slot);
+    if (id == INVALID_LOBBY)
+        return INVALID_LOBBY;
+
+    auto &members = _lobbies[id].members;
+    std::size_t pos = _slotIndex[slot];
+    std::size_t last = members.back();
+    members[pos] = last;
+    _slotIndex[last] = pos;
+    members.pop_back();
+    _slotLobby[slot] = INVALID_LOBBY;
+    return id;
+}
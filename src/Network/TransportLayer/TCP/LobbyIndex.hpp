@@ -0,0 +1,103 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Indexed lobby membership for the TCP server
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Lobby membership index keyed by interned lobby ids.
+ *
+ * Lobby codes are interned once into dense integer ids so the hot paths
+ * (broadcast, player list, chat) only walk the member slots of one lobby
+ * and never compare strings. Members are client slot indices; removal is
+ * O(1) through a swap-with-last on the member list.
+ */
+class LobbyIndex
+{
+  public:
+    using LobbyId = uint32_t;
+    static constexpr LobbyId INVALID_LOBBY = UINT32_MAX;
+
+    /**
+     * @brief Return the id of a lobby code, creating it when unknown.
+     */
+    LobbyId intern(const std::string &code);
+
+    /**
+     * @brief Lookup an already interned lobby code.
+     */
+    std::optional<LobbyId> find(const std::string &code) const;
+
+    /**
+     * @brief Lobby code of an interned id.
+     */
+    const std::string &code(LobbyId id) const
+    {
+        return _lobbies[id].code;
+    }
+
+    /**
+     * @brief Move a slot into a lobby (leaving its previous lobby first).
+     */
+    void join(LobbyId id, std::size_t slot);
+
+    /**
+     * @brief Remove a slot from its lobby.
+     * @return The lobby it left, or INVALID_LOBBY if it was not in one.
+     */
+    LobbyId leave(std::size_t slot);
+
+    /**
+     * @brief Lobby currently holding a slot (INVALID_LOBBY if none).
+     */
+    LobbyId lobbyOf(std::size_t slot) const
+    {
+        return slot < _slotLobby.size() ? _slotLobby[slot] : INVALID_LOBBY;
+    }
+
+    /**
+     * @brief Member slots of a lobby, in no particular order.
+     */
+    const std::vector<std::size_t> &members(LobbyId id) const
+    {
+        return _lobbies[id].members;
+    }
+
+    /**
+     * @brief Number of members in a lobby.
+     */
+    std::size_t memberCount(LobbyId id) const
+    {
+        return _lobbies[id].members.size();
+    }
+
+    /**
+     * @brief Number of interned lobbies.
+     */
+    std::size_t lobbyCount() const
+    {
+        return _lobbies.size();
+    }
+
+  private:
+    struct Lobby
+    {
+        std::string code;
+        std::vector<std::size_t> members;
+    };
+
+    std::vector<Lobby> _lobbies;
+    std::unordered_map<std::string, LobbyId> _ids;
+    std::vector<LobbyId> _slotLobby;     ///< slot -> lobby id
+    std::vector<std::size_t> _slotIndex; ///< slot -> position in its lobby member list
+};
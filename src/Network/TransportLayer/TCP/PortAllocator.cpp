@@ -0,0 +1,32 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** UDP port allocation for lobby game servers
+*/
+
+#include "PortAllocator.hpp"
+
+uint16_t PortAllocator::acquire()
+{
+    uint16_t port = 0;
+    if (!_free.empty())
+    {
+        port = _free.front();
+        _free.pop_front();
+    }
+    else if (_next < _last)
+    {
+        port = _next++;
+    }
+    if (port != 0)
+        _used.insert(port);
+    return port;
+}
+
+void PortAllocator::release(uint16_t port)
+{
+    if (_used.erase(port) == 0)
+        return;
+    _free.push_back(port);
+}
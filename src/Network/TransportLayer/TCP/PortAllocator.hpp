@@ -0,0 +1,48 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** UDP port allocation for lobby game servers
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <unordered_set>
+
+/**
+ * @brief Hands out UDP ports from a fixed range and takes them back.
+ *
+ * Released ports are reused oldest first, so a long-running server never
+ * wraps around onto a port that is still held by a live game server.
+ */
+class PortAllocator
+{
+  public:
+    PortAllocator(uint16_t first = 50000, uint16_t last = 65000) : _next(first), _last(last)
+    {
+    }
+
+    /**
+     * @brief Take a free port.
+     * @return 0 when the range is exhausted.
+     */
+    uint16_t acquire();
+
+    /**
+     * @brief Give a port back (ignored if it was not handed out).
+     */
+    void release(uint16_t port);
+
+    std::size_t inUse() const
+    {
+        return _used.size();
+    }
+
+  private:
+    uint16_t _next;
+    uint16_t _last;
+    std::deque<uint16_t> _free;
+    std::unordered_set<uint16_t> _used;
+};
@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <random>
 #include <string>
@@ -20,6 +21,9 @@
 namespace
 {
 constexpr uint8_t kDefaultPlayerHp = 5;
+constexpr std::size_t kMaxQueuedBytes = 256 * 1024; // per client, beyond that new frames are dropped
+constexpr int kMaxLobbyRestarts = 3;
+constexpr long kGameServerTimeout = 5; // seconds without a heartbeat (sent every second) before a kill
 std::string sanitizePseudo(const std::string &raw)
 {
     std::string out;
@@ -37,18 +41,21 @@ std::string sanitizePseudo(const std::string &raw)
 }
 } // namespace
 
-TCPServer::TCPServer(uint16_t port, SessionManager &sessions, ChildProcessManager *childMgr)
-    : _sessions(sessions), _childMgr(childMgr)
+TCPServer::TCPServer(uint16_t port, SessionManager &sessions, ChildProcessManager *childMgr, WarmPool *pool,
+                     MetricsEndpoint *metrics)
+    : _sessions(sessions), _childMgr(childMgr), _pool(pool), _metricsEndpoint(metrics)
 {
-    for (auto &c : _clients)
+    for (std::size_t i = 0; i < _clients.size(); i++)
     {
-        c.fd = INVALID_SOCKET_FD;
+        _clients[i].fd = INVALID_SOCKET_FD;
+        _clients[i].slot = i;
     }
     if (!_serverSocket.bindAndListen(port, INADDR_ANY, MAX_CLIENT))
     {
         throw std::runtime_error("Failed to start TCP server");
     }
 
+    describeMetrics();
     std::cout << "[SERVER] TCPServer started on port " << port << std::endl;
 }
 
@@ -77,13 +84,25 @@ Packet TCPServer::makeLobbyPacket(PacketType type, const std::string &payload)
     return Packet{type, std::vector<uint8_t>(payload.begin(), payload.end())};
 }
 
-void TCPServer::broadcastToLobby(const std::string &lobbyCode, const Packet &packet)
+void TCPServer::broadcastToLobby(LobbyIndex::LobbyId lobby, const Packet &packet)
 {
-    for (auto &c : _clients)
+    if (lobby == LobbyIndex::INVALID_LOBBY)
+        return;
+    Protocol::Frame frame;
+    try
+    {
+        frame = Protocol::encodeFrame(packet);
+    }
+    catch (const std::exception &)
+    {
+        return;
+    }
+    for (std::size_t slot : _lobbyIndex.members(lobby))
     {
-        if (c.fd == INVALID_SOCKET_FD || !c.handshakeDone || c.lobbyCode != lobbyCode)
+        Client &c = _clients[slot];
+        if (c.fd == INVALID_SOCKET_FD || !c.handshakeDone)
             continue;
-        sendPacket(c.fd, packet);
+        queueFrame(c, frame);
     }
 }
 
@@ -105,6 +124,67 @@ bool TCPServer::sendPacket(socket_t fd, const Packet &packet)
     return this->writeAll(fd, framed.data(), framed.size());
 }
 
+bool TCPServer::sendPacket(Client &client, const Packet &packet)
+{
+    if (client.fd == INVALID_SOCKET_FD)
+    {
+        return false;
+    }
+    Protocol::Frame frame;
+    try
+    {
+        frame = Protocol::encodeFrame(packet);
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    return queueFrame(client, frame);
+}
+
+bool TCPServer::queueFrame(Client &client, const Protocol::Frame &frame)
+{
+    if (client.fd == INVALID_SOCKET_FD || !frame)
+        return false;
+    if (client.outBytes + frame->size() > kMaxQueuedBytes)
+    {
+        std::cerr << "[SERVER] client " << client.id << " output queue full, dropping frame\n";
+        _metrics.add("rtype_tcp_frames_dropped_total", 1);
+        return false;
+    }
+    client.outQueue.push_back(frame);
+    client.outBytes += frame->size();
+    return flushClient(client);
+}
+
+bool TCPServer::flushClient(Client &client)
+{
+    while (!client.outQueue.empty())
+    {
+        const auto &frame = *client.outQueue.front();
+        ssize_t n = writeFd(client.fd, frame.data() + client.outOffset, frame.size() - client.outOffset,
+                            SEND_NOWAIT_FLAGS);
+        if (n < 0 && SOCKET_WOULD_BLOCK(SOCKET_ERROR_CODE))
+            return true;
+        if (n <= 0)
+        {
+            // The read side reports the disconnect; just stop holding frames for this socket.
+            client.outQueue.clear();
+            client.outOffset = 0;
+            client.outBytes = 0;
+            return false;
+        }
+        client.outOffset += static_cast<std::size_t>(n);
+        client.outBytes -= static_cast<std::size_t>(n);
+        if (client.outOffset == frame.size())
+        {
+            client.outQueue.pop_front();
+            client.outOffset = 0;
+        }
+    }
+    return true;
+}
+
 TCPServer::RecvResult TCPServer::receivePacket(socket_t fd, Packet &packet, std::vector<uint8_t> &recvBuffer)
 {
     if (fd == INVALID_SOCKET_FD)
@@ -119,7 +199,10 @@ TCPServer::RecvResult TCPServer::receivePacket(socket_t fd, Packet &packet, std:
         return RecvResult::Disconnected;
     }
 
-    auto status = Protocol::consumeChunk(tmp, static_cast<std::size_t>(n), recvBuffer, packet);
+    std::size_t malformed = 0;
+    auto status = Protocol::consumeChunk(tmp, static_cast<std::size_t>(n), recvBuffer, packet, &malformed);
+    if (malformed > 0)
+        _metrics.add("rtype_tcp_frames_malformed_total", malformed);
     if (status == Protocol::StreamStatus::Ok)
         return RecvResult::Ok;
     if (status == Protocol::StreamStatus::Incomplete)
@@ -155,23 +238,28 @@ void TCPServer::resetClient(Client &client)
 {
     removeFromLobby(client);
     _sessions.removeById(client.id);
+    if (client.fd != INVALID_SOCKET_FD)
+        flushClient(client); // best effort for a last REFUSED/DEAD notice
     closeFd(client.fd);
     client.id = 0;
     client.addr = {};
     client.handshakeDone = false;
     client.lastPongTime = 0;
     client.handshakeStart = 0;
+    client.acceptedAt = {};
     client.posX = 0;
     client.posY = 0;
     client.hp = 0;
-    client.lobbyCode.clear();
     client.pseudo.clear();
     client.recvBuffer.clear();
+    client.outQueue.clear();
+    client.outOffset = 0;
+    client.outBytes = 0;
 }
 
-int TCPServer::pollSockets(fd_set &readfds, int maxFd, struct timeval &timeout)
+int TCPServer::pollSockets(fd_set &readfds, fd_set &writefds, int maxFd, struct timeval &timeout)
 {
-    return selectFdSet(maxFd + 1, &readfds, nullptr, nullptr, &timeout);
+    return selectFdSet(maxFd + 1, &readfds, &writefds, nullptr, &timeout);
 }
 
 void TCPServer::acceptNewClient()
@@ -198,6 +286,7 @@ void TCPServer::acceptNewClient()
     {
         sendPacket(clientFd, makeStringPacket(PacketType::REFUSED, "FULL"));
         closeFd(clientFd);
+        _metrics.add("rtype_tcp_connections_total", 1, Metrics::Registry::label("result", "refused"));
         std::cout << "[SERVER] refused new client (FULL)\n";
         return;
     }
@@ -210,7 +299,9 @@ void TCPServer::acceptNewClient()
     _clients[slot].hp = kDefaultPlayerHp;
     _sessions.addSession(_clients[slot].id, clientFd, addr, getCurrentTime());
     _clients[slot].handshakeStart = getCurrentTime();
-    sendPacket(_clients[slot].fd, makeStringPacket(PacketType::SERVER_HELLO, "R-Type Server"));
+    _clients[slot].acceptedAt = std::chrono::steady_clock::now();
+    _metrics.add("rtype_tcp_connections_total", 1, Metrics::Registry::label("result", "accepted"));
+    sendPacket(_clients[slot], makeStringPacket(PacketType::SERVER_HELLO, "R-Type Server"));
 
     std::cout << "[SERVER] client " << _clients[slot].id << " connected (awaiting CLIENT_HELLO)\n";
 }
@@ -222,10 +313,11 @@ void TCPServer::processClientData(Client &client)
     if (res == RecvResult::Disconnected)
     {
         std::cout << "[SERVER] client " << client.id << " disconnected\n";
-        if (client.handshakeDone && !client.lobbyCode.empty())
+        LobbyIndex::LobbyId lobby = lobbyOf(client);
+        if (client.handshakeDone && lobby != LobbyIndex::INVALID_LOBBY)
         {
             std::string sys = "SYS:" + client.pseudo + " disconnected";
-            broadcastToLobby(client.lobbyCode, makeStringPacket(PacketType::MESSAGE, sys));
+            broadcastToLobby(lobby, makeStringPacket(PacketType::MESSAGE, sys));
         }
         resetClient(client);
         return;
@@ -241,7 +333,7 @@ void TCPServer::processClientData(Client &client)
         std::string payloadStr(packet.payload.begin(), packet.payload.end());
         if (packet.type != PacketType::CLIENT_HELLO || payloadStr.rfind("toto", 0) != 0)
         {
-            sendPacket(client.fd, makeStringPacket(PacketType::REFUSED, "BAD_HANDSHAKE"));
+            sendPacket(client, makeStringPacket(PacketType::REFUSED, "BAD_HANDSHAKE"));
             resetClient(client);
             return;
         }
@@ -256,11 +348,14 @@ void TCPServer::processClientData(Client &client)
         {
             pseudo = "Player" + std::to_string(client.id);
         }
-        sendPacket(client.fd, makeIdPacket(PacketType::OK, client.id));
+        sendPacket(client, makeIdPacket(PacketType::OK, client.id));
         client.handshakeDone = true;
         client.pseudo = pseudo;
         client.lastPongTime = getCurrentTime();
         _sessions.setPseudo(client.id, pseudo);
+        auto handshake = std::chrono::steady_clock::now() - client.acceptedAt;
+        _metrics.histogram("rtype_tcp_handshake_seconds")
+            .record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(handshake).count()));
         std::cout << "[SERVER] client " << client.id << " handshake done (awaiting lobby selection)\n";
         return;
     }
@@ -282,16 +377,10 @@ void TCPServer::processClientData(Client &client)
     if (packet.type == PacketType::MESSAGE)
     {
         std::cerr << "message\n";
-        std::string lobbyCode = client.lobbyCode;
-        if (lobbyCode.empty())
-        {
-            auto lobbyOpt = _sessions.getLobbyCode(client.id);
-            if (lobbyOpt.has_value())
-                lobbyCode = *lobbyOpt;
-        }
-        std::cout << "[SERVER] CHAT from id=" << client.id << " lobby=" << (lobbyCode.empty() ? "?" : lobbyCode)
-                  << "\n";
-        if (!lobbyCode.empty())
+        LobbyIndex::LobbyId lobby = lobbyOf(client);
+        std::cout << "[SERVER] CHAT from id=" << client.id
+                  << " lobby=" << (lobby == LobbyIndex::INVALID_LOBBY ? "?" : _lobbyIndex.code(lobby)) << "\n";
+        if (lobby != LobbyIndex::INVALID_LOBBY)
         {
             std::string text(packet.payload.begin(), packet.payload.end());
             std::string clean;
@@ -319,15 +408,9 @@ void TCPServer::processClientData(Client &client)
                     name = "Player" + std::to_string(client.id);
                 }
                 std::string msg = "CHAT:" + name + ": " + clean;
-                int recipients = 0;
-                for (auto &c : _clients)
-                {
-                    if (c.fd != -1 && c.handshakeDone && c.lobbyCode == lobbyCode)
-                        recipients++;
-                }
-                std::cout << "[SERVER] Broadcast lobby=" << lobbyCode << " recipients=" << recipients << " msg=\""
-                          << msg << "\"\n";
-                broadcastToLobby(lobbyCode, makeStringPacket(PacketType::MESSAGE, msg));
+                std::cout << "[SERVER] Broadcast lobby=" << _lobbyIndex.code(lobby)
+                          << " recipients=" << _lobbyIndex.memberCount(lobby) << " msg=\"" << msg << "\"\n";
+                broadcastToLobby(lobby, makeStringPacket(PacketType::MESSAGE, msg));
             }
         }
         else
@@ -355,10 +438,11 @@ void TCPServer::processClientData(Client &client)
                         recipients++;
                 }
                 std::cout << "[SERVER] Broadcast ALL recipients=" << recipients << " msg=\"" << msg << "\"\n";
+                Protocol::Frame frame = Protocol::encodeFrame(makeStringPacket(PacketType::MESSAGE, msg));
                 for (auto &c : _clients)
                 {
                     if (c.fd != -1 && c.handshakeDone)
-                        sendPacket(c.fd, makeStringPacket(PacketType::MESSAGE, msg));
+                        queueFrame(c, frame);
                 }
             }
         }
@@ -378,12 +462,13 @@ long TCPServer::getCurrentTime()
 
 void TCPServer::sendPingToAll()
 {
+    Protocol::Frame ping = Protocol::encodeFrame(Packet(PacketType::PING, {}));
     for (auto &c : _clients)
     {
         if (c.fd != -1 && c.handshakeDone)
         {
             std::cout << "[SERVER] Sending PING to client " << c.id << std::endl;
-            sendPacket(c.fd, Packet(PacketType::PING, {}));
+            queueFrame(c, ping);
         }
     }
 }
@@ -401,7 +486,7 @@ void TCPServer::checkHeartbeat()
         {
             if (now - c.handshakeStart > 3)
             {
-                sendPacket(c.fd, makeStringPacket(PacketType::REFUSED, "TIMEOUT"));
+                sendPacket(c, makeStringPacket(PacketType::REFUSED, "TIMEOUT"));
                 resetClient(c);
             }
             continue;
@@ -410,98 +495,99 @@ void TCPServer::checkHeartbeat()
         {
             std::cout << "[SERVER] Client " << c.id << " timed out (no PONG for " << (now - c.lastPongTime) << "s)"
                       << std::endl;
-            if (c.handshakeDone && !c.lobbyCode.empty())
+            LobbyIndex::LobbyId lobby = lobbyOf(c);
+            if (c.handshakeDone && lobby != LobbyIndex::INVALID_LOBBY)
             {
                 std::string sys = "SYS:" + c.pseudo + " disconnected";
-                broadcastToLobby(c.lobbyCode, makeStringPacket(PacketType::MESSAGE, sys));
+                broadcastToLobby(lobby, makeStringPacket(PacketType::MESSAGE, sys));
             }
             resetClient(c);
         }
     }
 }
 
-void TCPServer::processIpcMessages()
+void TCPServer::checkGameServers()
+{
+    if (!_childMgr)
+        return;
+    long now = getCurrentTime();
+    for (auto &kv : _lobbies)
+    {
+        // No IPC: the server was told to stop (NoPlayers) and is exiting on its own.
+        LobbyInfo &info = kv.second;
+        if (info.childPid < 0 || !info.ipc || now - info.lastHeartbeat <= kGameServerTimeout)
+            continue;
+        std::cerr << "[PARENT] UDP server pid=" << info.childPid << " lobby=" << _lobbyIndex.code(kv.first)
+                  << " missed heartbeats for " << (now - info.lastHeartbeat) << "s, killing it" << std::endl;
+        _metrics.add("rtype_game_server_hangs_total", 1);
+        _childMgr->forceKill(info.childPid);
+        info.lastHeartbeat = now; // reaped shortly; do not kill it again meanwhile
+    }
+}
+
+void TCPServer::processIpcMessages(const fd_set &readfds)
 {
     for (auto &kv : _lobbies)
     {
+        const LobbyIndex::LobbyId lobby = kv.first;
         auto &ipc = kv.second.ipc;
-        if (!ipc)
+        if (!ipc || ipc->fd() == INVALID_SOCKET_FD || !FD_ISSET(ipc->fd(), &readfds))
             continue;
         while (ipc)
         {
             auto msgOpt = ipc->recv(0);
             if (!msgOpt.has_value())
                 break;
-            const std::string &msg = *msgOpt;
-            if (msg.rfind("BOSS_DEAD:", 0) == 0)
-            {
-                std::string lobbyCode = msg.substr(10);
-                if (!lobbyCode.empty())
-                {
-                    broadcastToLobby(lobbyCode, makeStringPacket(PacketType::MESSAGE, "SYS:Boss defeated - win"));
-                }
-                continue;
-            }
-            if (msg.rfind("NO_PLAYERS:", 0) == 0)
+            const IpcMessage &msg = *msgOpt;
+            // The channel is owned by a single lobby, so the code carried by the message is not needed here.
+            switch (msg.type)
             {
-                std::string lobbyCode = msg.substr(11);
-                if (!lobbyCode.empty())
-                {
-                    broadcastToLobby(lobbyCode,
-                                     makeStringPacket(PacketType::MESSAGE, "SYS:No players left - game over"));
-                    auto lobbyIt = _lobbies.find(lobbyCode);
-                    if (lobbyIt != _lobbies.end())
-                    {
-                        lobbyIt->second.udpPort = 0;
-                        if (lobbyIt->second.ipc)
-                        {
-                            lobbyIt->second.ipc->close();
-                            lobbyIt->second.ipc.reset();
-                        }
-                    }
-                    if (_childMgr)
-                    {
-                        _childMgr->forget(lobbyCode);
-                    }
-                }
+            case IpcType::Heartbeat:
+                kv.second.lastHeartbeat = getCurrentTime();
                 break;
-            }
-            if (msg.rfind("BOSS:", 0) == 0)
-            {
-                std::string lobbyCode = msg.substr(5);
-                if (!lobbyCode.empty())
-                {
-                    broadcastToLobby(lobbyCode, makeStringPacket(PacketType::MESSAGE, "SYS:Boss spawned"));
-                }
-                continue;
-            }
-            if (msg.rfind("DEAD:", 0) == 0)
-            {
-                int id = 0;
-                try
-                {
-                    id = std::stoi(msg.substr(5));
-                }
-                catch (const std::exception &)
+            case IpcType::BossDead:
+                broadcastToLobby(lobby, makeStringPacket(PacketType::MESSAGE, "SYS:Boss defeated - win"));
+                break;
+            case IpcType::BossSpawned:
+                broadcastToLobby(lobby, makeStringPacket(PacketType::MESSAGE, "SYS:Boss spawned"));
+                break;
+            case IpcType::NoPlayers:
+                broadcastToLobby(lobby, makeStringPacket(PacketType::MESSAGE, "SYS:No players left - game over"));
+                kv.second.udpPort = 0;
+                ipc->close();
+                ipc.reset();
+                if (_childMgr)
                 {
-                    continue;
+                    _childMgr->terminate(_lobbyIndex.code(lobby));
                 }
-                if (id <= 0)
-                    continue;
-                for (auto &c : _clients)
+                break;
+            case IpcType::Metric:
+                recordGameMetric(lobby, msg);
+                break;
+            case IpcType::Stat:
+                kv.second.pendingStats.apply(msg);
+                break;
+            case IpcType::StatsEnd:
+                recordGameStats(lobby, kv.second, msg.value);
+                break;
+            case IpcType::PlayerDead:
+                if (msg.value <= 0)
+                    break;
+                for (std::size_t slot : _lobbyIndex.members(lobby))
                 {
-                    if (c.fd != -1 && c.id == id)
+                    Client &c = _clients[slot];
+                    if (c.fd != -1 && c.id == msg.value)
                     {
-                        if (!c.lobbyCode.empty())
-                        {
-                            std::string sys = "SYS:" + c.pseudo + " died";
-                            broadcastToLobby(c.lobbyCode, makeStringPacket(PacketType::MESSAGE, sys));
-                        }
-                        sendPacket(c.fd, makeStringPacket(PacketType::MESSAGE, "DEAD"));
+                        std::string sys = "SYS:" + c.pseudo + " died";
+                        broadcastToLobby(lobby, makeStringPacket(PacketType::MESSAGE, sys));
+                        sendPacket(c, makeStringPacket(PacketType::MESSAGE, "DEAD"));
                         removeFromLobby(c);
                         break;
                     }
                 }
+                break;
+            default:
+                break;
             }
         }
     }
@@ -513,17 +599,26 @@ void TCPServer::run()
 
     while (true)
     {
-        processIpcMessages();
+        if (_pool)
+        {
+            _pool->pollReady();
+            _pool->refill([this]() { return allocatePort(); });
+        }
         long now = getCurrentTime();
         if (now - lastPing >= 5)
         {
             sendPingToAll();
             checkHeartbeat();
+            checkGameServers();
+            logChildUsage();
+            requestGameStats();
             lastPing = now;
         }
 
         fd_set readfds;
+        fd_set writefds;
         FD_ZERO(&readfds);
+        FD_ZERO(&writefds);
 
         int maxFd = _serverSocket.getSocketFd();
         FD_SET(_serverSocket.getSocketFd(), &readfds);
@@ -533,6 +628,8 @@ void TCPServer::run()
             if (c.fd != -1)
             {
                 FD_SET(c.fd, &readfds);
+                if (!c.outQueue.empty())
+                    FD_SET(c.fd, &writefds);
                 maxFd = maxFd > c.fd ? maxFd : c.fd;
             }
         }
@@ -547,12 +644,20 @@ void TCPServer::run()
                 maxFd = std::max(maxFd, ipcFd);
             }
         }
+        int childFd = _childMgr ? _childMgr->signalFd() : -1;
+        if (childFd != -1)
+        {
+            FD_SET(childFd, &readfds);
+            maxFd = std::max(maxFd, childFd);
+        }
+        if (_metricsEndpoint)
+            _metricsEndpoint->addFds(readfds, writefds, maxFd);
 
         struct timeval tv;
         tv.tv_sec = 0;
         tv.tv_usec = 1000;
 
-        int activity = pollSockets(readfds, maxFd, tv);
+        int activity = pollSockets(readfds, writefds, maxFd, tv);
         if (activity < 0)
         {
             continue;
@@ -564,16 +669,12 @@ void TCPServer::run()
             continue;
         }
 
-        for (const auto &kv : _lobbies)
+        processIpcMessages(readfds);
+        if (_metricsEndpoint)
+            _metricsEndpoint->process(readfds, writefds, [this]() { return renderMetrics(); });
+        if (childFd != -1 && FD_ISSET(childFd, &readfds))
         {
-            if (!kv.second.ipc)
-                continue;
-            int ipcFd = kv.second.ipc->fd();
-            if (ipcFd != -1 && FD_ISSET(ipcFd, &readfds))
-            {
-                processIpcMessages();
-                break;
-            }
+            handleChildExits();
         }
 
         if (FD_ISSET(_serverSocket.getSocketFd(), &readfds))
@@ -581,6 +682,14 @@ void TCPServer::run()
             acceptNewClient();
         }
 
+        for (auto &c : _clients)
+        {
+            if (c.fd != INVALID_SOCKET_FD && FD_ISSET(c.fd, &writefds))
+            {
+                flushClient(c);
+            }
+        }
+
         for (auto &c : _clients)
         {
             if (c.fd != -INVALID_SOCKET_FD && FD_ISSET(c.fd, &readfds))
@@ -591,9 +700,9 @@ void TCPServer::run()
     }
 }
 
-ssize_t TCPServer::writeFd(socket_t fd, const uint8_t *data, std::size_t size)
+ssize_t TCPServer::writeFd(socket_t fd, const uint8_t *data, std::size_t size, int flags)
 {
-    return ::send(fd, reinterpret_cast<const char *>(data), size, 0);
+    return ::send(fd, reinterpret_cast<const char *>(data), size, flags);
 }
 
 ssize_t TCPServer::readFd(socket_t fd, uint8_t *data, std::size_t size)
@@ -625,17 +734,21 @@ bool TCPServer::writeAll(socket_t fd, const uint8_t *data, std::size_t size)
     }
     return true;
 }
-Packet TCPServer::buildPlayerListPacket(const std::string &lobbyCode) const
+Packet TCPServer::buildPlayerListPacket(LobbyIndex::LobbyId lobby) const
 {
     std::vector<uint8_t> payload;
-    payload.reserve(1 + _clients.size() * 5);
-
     payload.push_back(0); // placeholder for count
+    if (lobby == LobbyIndex::INVALID_LOBBY)
+        return Packet(PacketType::PLAYER_LIST, payload);
+
+    const auto &members = _lobbyIndex.members(lobby);
+    payload.reserve(1 + members.size() * 5);
     uint8_t count = 0;
 
-    for (const auto &c : _clients)
+    for (std::size_t slot : members)
     {
-        if (c.fd == -1 || !c.handshakeDone || c.lobbyCode != lobbyCode)
+        const Client &c = _clients[slot];
+        if (c.fd == -1 || !c.handshakeDone)
             continue;
         ++count;
         payload.push_back(static_cast<uint8_t>((c.id >> 8) & 0xFF));
@@ -649,35 +762,38 @@ Packet TCPServer::buildPlayerListPacket(const std::string &lobbyCode) const
     return Packet(PacketType::PLAYER_LIST, payload);
 }
 
-void TCPServer::sendPlayerListToClient(const Client &client)
+void TCPServer::sendPlayerListToClient(Client &client)
 {
-    Packet list = buildPlayerListPacket(client.lobbyCode);
-    sendPacket(client.fd, list);
+    Packet list = buildPlayerListPacket(lobbyOf(client));
+    sendPacket(client, list);
 }
 
 void TCPServer::broadcastNewPlayer(const Client &newClient)
 {
+    LobbyIndex::LobbyId lobby = lobbyOf(newClient);
+    if (lobby == LobbyIndex::INVALID_LOBBY)
+        return;
     std::vector<uint8_t> payload{static_cast<uint8_t>((newClient.id >> 8) & 0xFF),
                                  static_cast<uint8_t>(newClient.id & 0xFF), newClient.posX, newClient.posY,
                                  newClient.hp};
-    Packet pkt(PacketType::NEW_PLAYER, payload);
+    Protocol::Frame frame = Protocol::encodeFrame(Packet(PacketType::NEW_PLAYER, payload));
 
-    for (auto &c : _clients)
+    for (std::size_t slot : _lobbyIndex.members(lobby))
     {
-        if (c.fd == -1 || !c.handshakeDone || c.id == newClient.id || c.lobbyCode != newClient.lobbyCode)
+        Client &c = _clients[slot];
+        if (c.fd == -1 || !c.handshakeDone || c.id == newClient.id)
             continue;
-        sendPacket(c.fd, pkt);
+        queueFrame(c, frame);
     }
 }
 
-void TCPServer::refreshLobby(const std::string &code)
+void TCPServer::refreshLobby(LobbyIndex::LobbyId lobby)
 {
-    for (auto &c : _clients)
-    {
-        if (c.fd == -1 || !c.handshakeDone || c.lobbyCode != code)
-            continue;
-        sendPlayerListToClient(c);
-    }
+    if (lobby == LobbyIndex::INVALID_LOBBY)
+        return;
+    // Every member receives the same list: build it once.
+    Packet list = buildPlayerListPacket(lobby);
+    broadcastToLobby(lobby, list);
 }
 
 std::string TCPServer::generateLobbyCode()
@@ -693,46 +809,252 @@ std::string TCPServer::generateLobbyCode()
         {
             ch = chars[dist(rng)];
         }
-    } while (_lobbies.find(code) != _lobbies.end());
+    } while (_lobbyIndex.find(code).has_value());
     return code;
 }
 
 void TCPServer::removeFromLobby(const Client &client)
 {
-    std::string code = client.lobbyCode;
-    auto mapIt = _clientLobby.find(client.id);
-    if (code.empty() && mapIt != _clientLobby.end())
-        code = mapIt->second;
-    if (code.empty())
+    LobbyIndex::LobbyId lobby = _lobbyIndex.leave(client.slot);
+    if (lobby == LobbyIndex::INVALID_LOBBY)
         return;
 
-    auto it = _lobbies.find(code);
-    if (it != _lobbies.end())
-    {
-        auto &vec = it->second.players;
-        vec.erase(std::remove(vec.begin(), vec.end(), client.id), vec.end());
-    }
-    _clientLobby.erase(client.id);
     _sessions.setLobbyCode(client.id, "");
-    refreshLobby(code);
+    refreshLobby(lobby);
 }
 
 uint16_t TCPServer::allocatePort()
 {
-    static uint16_t nextPort = 50000;
-    if (nextPort == 0 || nextPort >= 65000)
-        nextPort = 50000;
-    return nextPort++;
+    return _ports.acquire();
 }
 
-void TCPServer::ensureLobbyProcess(const std::string &code, bool isPublic)
+void TCPServer::handleChildExits()
 {
-    auto it = _lobbies.find(code);
+    for (const ChildExit &exit : _childMgr->reap())
+    {
+        std::cout << "[PARENT] UDP server pid=" << exit.pid << " lobby=" << (exit.idle ? "(pool)" : exit.lobbyCode)
+                  << " port=" << exit.udpPort << " exited";
+        if (exit.signal)
+            std::cout << " on signal " << exit.signal;
+        else
+            std::cout << " with code " << exit.exitCode;
+        std::cout << (exit.requested ? " (requested)" : "") << "\n";
+        bool failed = !exit.requested && (exit.signal != 0 || exit.exitCode != 0);
+        _metrics.add("rtype_game_server_exits_total", 1,
+                     Metrics::Registry::label("reason", failed ? "crash" : (exit.requested ? "requested" : "exit")));
+
+        if (exit.idle)
+        {
+            if (_pool)
+                _pool->forget(exit.pid);
+            _ports.release(exit.udpPort);
+            continue;
+        }
+
+        auto known = _lobbyIndex.find(exit.lobbyCode);
+        auto it = known.has_value() ? _lobbies.find(*known) : _lobbies.end();
+        if (it == _lobbies.end() || it->second.childPid != exit.pid)
+        {
+            // Lobby already moved on to another server (or never had one): just free the port.
+            _ports.release(exit.udpPort);
+            continue;
+        }
+
+        LobbyInfo &info = it->second;
+        if (info.ipc)
+        {
+            info.ipc->close();
+            info.ipc.reset();
+        }
+        info.childPid = -1;
+        bool crashed = !exit.requested && (exit.signal != 0 || exit.exitCode != 0);
+        if (crashed && _lobbyIndex.memberCount(*known) > 0 && info.restarts < kMaxLobbyRestarts)
+        {
+            // Same port: the clients already aim their UDP traffic at it.
+            ++info.restarts;
+            ensureLobbyProcess(*known, info.isPublic);
+            broadcastToLobby(*known, makeStringPacket(PacketType::MESSAGE, "SYS:Game server restarted"));
+            continue;
+        }
+        if (info.udpPort == exit.udpPort)
+            info.udpPort = 0;
+        _ports.release(exit.udpPort);
+        _metrics.removeSeries(Metrics::Registry::label("lobby", exit.lobbyCode));
+    }
+}
+
+void TCPServer::describeMetrics()
+{
+    using Kind = Metrics::Registry::Kind;
+    _metrics.describe("rtype_tcp_clients", Kind::Gauge, "Connected TCP clients.");
+    _metrics.describe("rtype_tcp_clients_in_lobby", Kind::Gauge, "Clients currently in a lobby.");
+    _metrics.describe("rtype_lobbies", Kind::Gauge, "Lobbies with at least one member.");
+    _metrics.describe("rtype_game_servers", Kind::Gauge, "Lobbies with a running UDP game server.");
+    _metrics.describe("rtype_tcp_connections_total", Kind::Counter, "Accepted and refused TCP connections.");
+    _metrics.describe("rtype_tcp_handshake_seconds", Kind::Summary, "Accept to CLIENT_HELLO handled.", 1e-6);
+    _metrics.describe("rtype_lobby_create_seconds", Kind::Summary, "CREATE_LOBBY received to LOBBY_OK sent.", 1e-6);
+    _metrics.describe("rtype_tcp_frames_dropped_total", Kind::Counter, "Frames dropped on full client queues.");
+    _metrics.describe("rtype_tcp_frames_malformed_total", Kind::Counter, "Received frames skipped as malformed.");
+    _metrics.describe("rtype_game_server_exits_total", Kind::Counter, "UDP game server exits by reason.");
+    _metrics.describe("rtype_game_server_hangs_total", Kind::Counter, "UDP game servers killed for missed heartbeats.");
+    _metrics.describe("rtype_udp_packets_in_total", Kind::Counter, "UDP datagrams handled, all lobbies.");
+    _metrics.describe("rtype_udp_packets_out_total", Kind::Counter, "UDP datagrams sent, all lobbies.");
+    _metrics.describe("rtype_udp_bytes_in_total", Kind::Counter, "UDP bytes handled, all lobbies.");
+    _metrics.describe("rtype_udp_bytes_out_total", Kind::Counter, "UDP bytes sent, all lobbies.");
+    _metrics.describe("rtype_udp_packets_dropped_total", Kind::Counter,
+                      "Unparsable UDP datagrams and failed sends, all lobbies.");
+    _metrics.describe("rtype_snapshots_truncated_total", Kind::Counter,
+                      "Snapshots cut to fit the 255-byte payload, all lobbies.");
+    _metrics.describe("rtype_tick_duration_seconds", Kind::Summary, "Game server simulation step.", 1e-6);
+    _metrics.describe("rtype_snapshot_bytes", Kind::Summary, "Snapshot datagram size.");
+    _metrics.describe("rtype_lobby_packets_per_second", Kind::Gauge, "UDP datagrams per second, by direction.");
+    _metrics.describe("rtype_lobby_bytes_per_second", Kind::Gauge, "UDP bytes per second, by direction.");
+    _metrics.describe("rtype_lobby_entities", Kind::Gauge, "Entities in the last snapshot, by kind.");
+    _metrics.describe("rtype_lobby_entities_dropped", Kind::Gauge, "Entities left out of truncated snapshots.");
+    _metrics.describe("rtype_client_packets_per_second", Kind::Gauge, "UDP datagrams per second per player.");
+    _metrics.describe("rtype_client_bytes_per_second", Kind::Gauge, "UDP bytes per second per player.");
+}
+
+void TCPServer::recordGameMetric(LobbyIndex::LobbyId lobby, const IpcMessage &msg)
+{
+    static const char *const kNames[] = {
+        "rtype_udp_packets_in_total",      // PacketsIn
+        "rtype_udp_packets_out_total",     // PacketsOut
+        "rtype_udp_bytes_in_total",        // BytesIn
+        "rtype_udp_bytes_out_total",       // BytesOut
+        "rtype_udp_packets_dropped_total", // PacketsDropped
+        "rtype_snapshots_truncated_total", // Truncations
+        "rtype_tick_duration_seconds",     // TickMicros
+        "rtype_snapshot_bytes",            // SnapshotBytes
+    };
+    static_assert(sizeof(kNames) / sizeof(kNames[0]) == static_cast<std::size_t>(IpcMetric::Count),
+                  "one exported name per IpcMetric");
+    IpcMetric metric = msg.metric();
+    if (metric >= IpcMetric::Count || msg.value <= 0)
+        return;
+    const char *name = kNames[static_cast<std::size_t>(metric)];
+    if (!isHistogramMetric(metric))
+    {
+        // Counters are summed across lobbies: per-lobby series would vanish with each lobby.
+        _metrics.add(name, static_cast<uint64_t>(msg.value));
+        return;
+    }
+    _metrics.histogram(name, Metrics::Registry::label("lobby", _lobbyIndex.code(lobby)))
+        .recordBucket(msg.metricBucket(), static_cast<uint64_t>(msg.value));
+}
+
+std::string TCPServer::renderMetrics()
+{
+    std::size_t clients = 0;
+    std::size_t inLobby = 0;
+    for (const auto &c : _clients)
+    {
+        if (c.fd == INVALID_SOCKET_FD)
+            continue;
+        ++clients;
+        inLobby += lobbyOf(c) != LobbyIndex::INVALID_LOBBY;
+    }
+    std::size_t lobbies = 0;
+    std::size_t servers = 0;
+    for (const auto &kv : _lobbies)
+    {
+        lobbies += _lobbyIndex.memberCount(kv.first) > 0;
+        servers += kv.second.childPid != -1;
+    }
+    _metrics.set("rtype_tcp_clients", static_cast<double>(clients));
+    _metrics.set("rtype_tcp_clients_in_lobby", static_cast<double>(inLobby));
+    _metrics.set("rtype_lobbies", static_cast<double>(lobbies));
+    _metrics.set("rtype_game_servers", static_cast<double>(servers));
+    return _metrics.renderPrometheus();
+}
+
+void TCPServer::logChildUsage()
+{
+    if (!_childMgr)
+        return;
+    for (const ChildUsage &u : _childMgr->sample())
+    {
+        std::cout << "[PARENT] usage pid=" << u.pid << " lobby=" << (u.lobbyCode.empty() ? "(pool)" : u.lobbyCode)
+                  << " cpu=" << std::fixed << std::setprecision(1) << u.cpuPercent << "% rss=" << u.rssKb << "kB\n";
+    }
+}
+
+void TCPServer::requestGameStats()
+{
+    for (auto &kv : _lobbies)
+    {
+        if (!kv.second.ipc)
+            continue;
+        kv.second.pendingStats = GameStats{};
+        kv.second.ipc->send(IpcMessage::make(IpcType::StatsRequest));
+    }
+}
+
+void TCPServer::recordGameStats(LobbyIndex::LobbyId lobby, LobbyInfo &info, int32_t expected)
+{
+    using Registry = Metrics::Registry;
+    GameStats stats = std::move(info.pendingStats);
+    info.pendingStats = GameStats{};
+    if (stats.messages != expected)
+        return; // part of the reply did not fit the ring
+    const std::string lobbyLabel = Registry::label("lobby", _lobbyIndex.code(lobby));
+    auto playerLabel = [&lobbyLabel](uint16_t id) {
+        return lobbyLabel + "," + Registry::label("player", std::to_string(id));
+    };
+    for (const auto &kv : info.stats.clients)
+    {
+        if (stats.clients.count(kv.first) == 0)
+            _metrics.removeSeries(playerLabel(kv.first));
+    }
+    auto setRates = [this](const char *prefix, const std::string &labels, const TrafficRates &r) {
+        const std::string in = labels + "," + Registry::label("direction", "in");
+        const std::string out = labels + "," + Registry::label("direction", "out");
+        _metrics.set(std::string(prefix) + "_packets_per_second", r.packetsIn, in);
+        _metrics.set(std::string(prefix) + "_packets_per_second", r.packetsOut, out);
+        _metrics.set(std::string(prefix) + "_bytes_per_second", r.bytesIn, in);
+        _metrics.set(std::string(prefix) + "_bytes_per_second", r.bytesOut, out);
+    };
+    setRates("rtype_lobby", lobbyLabel, stats.lobbyRates());
+    for (const auto &kv : stats.clients)
+        setRates("rtype_client", playerLabel(kv.first), kv.second);
+    const std::pair<IpcStat, const char *> kinds[] = {
+        {IpcStat::Players, "player"}, {IpcStat::Bullets, "bullet"}, {IpcStat::Monsters, "monster"}};
+    for (const auto &kind : kinds)
+        _metrics.set("rtype_lobby_entities", stats.get(kind.first),
+                     lobbyLabel + "," + Registry::label("kind", kind.second));
+    _metrics.set("rtype_lobby_entities_dropped", stats.get(IpcStat::EntitiesDropped), lobbyLabel);
+    info.stats = std::move(stats);
+}
+
+void TCPServer::ensureLobbyProcess(LobbyIndex::LobbyId lobby, bool isPublic)
+{
+    auto it = _lobbies.find(lobby);
     if (it == _lobbies.end())
         return;
+    if (_pool && it->second.udpPort == 0)
+    {
+        auto slot = _pool->claim(_lobbyIndex.code(lobby));
+        if (slot.has_value())
+        {
+            if (it->second.ipc)
+                it->second.ipc->close();
+            it->second.udpPort = slot->udpPort;
+            it->second.ipc = std::move(slot->ipc);
+            it->second.childPid = slot->pid;
+            it->second.lastHeartbeat = getCurrentTime();
+            std::cout << "[PARENT] lobby " << _lobbyIndex.code(lobby) << " claimed pooled UDP server port="
+                      << it->second.udpPort << " (" << _pool->readyCount() << " ready left)\n";
+            return;
+        }
+    }
     if (it->second.udpPort == 0)
     {
         it->second.udpPort = allocatePort();
+        if (it->second.udpPort == 0)
+        {
+            std::cerr << "[PARENT] No UDP port left for lobby " << _lobbyIndex.code(lobby) << std::endl;
+            return;
+        }
     }
     if (_childMgr)
     {
@@ -744,7 +1066,9 @@ void TCPServer::ensureLobbyProcess(const std::string &code, bool isPublic)
                 std::cerr << "[PARENT] Failed to bind IPC" << std::endl;
             }
         }
-        _childMgr->spawn(code, it->second.udpPort, it->second.ipc->getport());
+        it->second.childPid = _childMgr->spawn(_lobbyIndex.code(lobby), it->second.udpPort,
+                                               it->second.ipc->endpoint(), it->second.ipc->childFds());
+        it->second.lastHeartbeat = getCurrentTime();
         std::cout << "[PARENT] UDP servers active " << _childMgr->activeCount() << "/" << _childMgr->maxCount() << "\n";
     }
     (void)isPublic;
@@ -755,26 +1079,30 @@ bool TCPServer::assignLobby(Client &client, const std::string &code, bool create
 {
     removeFromLobby(client);
 
-    auto it = _lobbies.find(code);
+    auto known = _lobbyIndex.find(code);
+    if (!known.has_value() && !createIfMissing)
+        return false;
+    LobbyIndex::LobbyId lobby = known.has_value() ? *known : _lobbyIndex.intern(code);
+
+    auto it = _lobbies.find(lobby);
     if (it == _lobbies.end())
     {
         if (!createIfMissing)
             return false;
-        _lobbies[code] = LobbyInfo{isPublic, {}, 0};
-        it = _lobbies.find(code);
-        ensureLobbyProcess(code, isPublic);
+        LobbyInfo info;
+        info.isPublic = isPublic;
+        it = _lobbies.emplace(lobby, std::move(info)).first;
+        ensureLobbyProcess(lobby, isPublic);
     }
 
-    if (!allowFull && it->second.players.size() >= MAX_CLIENT)
+    if (!allowFull && _lobbyIndex.memberCount(lobby) >= MAX_CLIENT)
         return false;
 
-    it->second.players.push_back(client.id);
-    client.lobbyCode = code;
-    _clientLobby[client.id] = code;
+    _lobbyIndex.join(lobby, client.slot);
     _sessions.setLobbyCode(client.id, code);
     if (it->second.udpPort == 0)
     {
-        ensureLobbyProcess(code, isPublic);
+        ensureLobbyProcess(lobby, isPublic);
     }
     return true;
 }
@@ -794,18 +1122,25 @@ void TCPServer::handleLobbyPacket(Client &client, const Packet &packet)
     if (packet.type == PacketType::CREATE_LOBBY)
     {
         std::cout << "[SERVER] client " << client.id << " requested CREATE_LOBBY\n";
+        auto requestStart = std::chrono::steady_clock::now();
         std::string code = generateLobbyCode();
         if (!assignLobby(client, code, true, false, true))
         {
-            sendPacket(client.fd, makeLobbyPacket(PacketType::LOBBY_ERROR, "INVALID_STATE"));
+            sendPacket(client, makeLobbyPacket(PacketType::LOBBY_ERROR, "INVALID_STATE"));
             return;
         }
         std::cout << "[SERVER] client " << client.id << " joined lobby " << code << "\n";
+        LobbyIndex::LobbyId lobby = lobbyOf(client);
         // For now, send code|port in the payload so the client can aim UDP correctly.
-        uint16_t port = _lobbies[code].udpPort ? _lobbies[code].udpPort : 4243;
+        uint16_t port = _lobbies[lobby].udpPort ? _lobbies[lobby].udpPort : 4243;
         std::string payload = code + "|" + std::to_string(port);
-        sendPacket(client.fd, makeLobbyPacket(PacketType::LOBBY_OK, payload));
-        refreshLobby(code);
+        sendPacket(client, makeLobbyPacket(PacketType::LOBBY_OK, payload));
+        auto latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                               requestStart)
+                             .count();
+        _metrics.histogram("rtype_lobby_create_seconds").record(static_cast<uint64_t>(latencyUs));
+        std::cout << "[SERVER] lobby " << code << " created in " << latencyUs << "us\n";
+        refreshLobby(lobby);
         sendPlayerListToClient(client);
         broadcastNewPlayer(client);
         return;
@@ -821,20 +1156,21 @@ void TCPServer::handleLobbyPacket(Client &client, const Packet &packet)
         std::cout << "[SERVER] client " << client.id << " requested JOIN_LOBBY " << code << "\n";
         if (!isAutoPublic)
         {
-            auto it = _lobbies.find(code);
+            auto known = _lobbyIndex.find(code);
+            auto it = known.has_value() ? _lobbies.find(*known) : _lobbies.end();
             if (it == _lobbies.end())
             {
-                sendPacket(client.fd, makeLobbyPacket(PacketType::LOBBY_ERROR, "UNKNOWN_CODE"));
+                sendPacket(client, makeLobbyPacket(PacketType::LOBBY_ERROR, "UNKNOWN_CODE"));
                 return;
             }
-            if (it->second.players.size() >= MAX_CLIENT)
+            if (_lobbyIndex.memberCount(*known) >= MAX_CLIENT)
             {
-                sendPacket(client.fd, makeLobbyPacket(PacketType::LOBBY_ERROR, "FULL"));
+                sendPacket(client, makeLobbyPacket(PacketType::LOBBY_ERROR, "FULL"));
                 return;
             }
             if (!assignLobby(client, code, false, it->second.isPublic))
             {
-                sendPacket(client.fd, makeLobbyPacket(PacketType::LOBBY_ERROR, "INVALID_STATE"));
+                sendPacket(client, makeLobbyPacket(PacketType::LOBBY_ERROR, "INVALID_STATE"));
                 return;
             }
         }
@@ -842,15 +1178,16 @@ void TCPServer::handleLobbyPacket(Client &client, const Packet &packet)
         {
             if (!assignLobby(client, code, true, true, false))
             {
-                sendPacket(client.fd, makeLobbyPacket(PacketType::LOBBY_ERROR, "INVALID_STATE"));
+                sendPacket(client, makeLobbyPacket(PacketType::LOBBY_ERROR, "INVALID_STATE"));
                 return;
             }
         }
         std::cout << "[SERVER] client " << client.id << " joined lobby " << code << "\n";
-        uint16_t port = _lobbies[code].udpPort ? _lobbies[code].udpPort : 4243;
+        LobbyIndex::LobbyId lobby = lobbyOf(client);
+        uint16_t port = _lobbies[lobby].udpPort ? _lobbies[lobby].udpPort : 4243;
         std::string payload = code + "|" + std::to_string(port);
-        sendPacket(client.fd, makeLobbyPacket(PacketType::LOBBY_OK, payload));
-        refreshLobby(code);
+        sendPacket(client, makeLobbyPacket(PacketType::LOBBY_OK, payload));
+        refreshLobby(lobby);
         sendPlayerListToClient(client);
         broadcastNewPlayer(client);
     }
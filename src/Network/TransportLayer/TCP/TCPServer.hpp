@@ -7,12 +7,21 @@
 
 #pragma once
 
+#include "../../../Metrics/Registry.hpp"
 #include "../../SessionManager.hpp"
 #include "../Packet.hpp"
+#include "../Protocol.hpp"
 #include "ChildProcessManager.hpp"
 #include "IpcChannel.hpp"
+#include "IpcStats.hpp"
+#include "LobbyIndex.hpp"
+#include "MetricsEndpoint.hpp"
+#include "PortAllocator.hpp"
 #include "TCPSocket.hpp"
+#include "WarmPool.hpp"
 #include <array>
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -36,8 +45,11 @@ class TCPServer
      * @brief Construct a new TCPServer bound to the given port.
      *
      * @param port TCP port to listen on.
+     * @param pool Optional pool of pre-spawned UDP servers claimed by new lobbies.
+     * @param metrics Optional listening endpoint serving the metrics registry to Prometheus.
      */
-    TCPServer(uint16_t port, SessionManager &sessions, ChildProcessManager *childMgr = nullptr);
+    TCPServer(uint16_t port, SessionManager &sessions, ChildProcessManager *childMgr = nullptr,
+              WarmPool *pool = nullptr, MetricsEndpoint *metrics = nullptr);
 
     /**
      * @brief Destroy the TCPServer, closing the listening socket.
@@ -56,18 +68,23 @@ class TCPServer
     struct Client
     {
         int id = 0;
+        std::size_t slot = 0;
         socket_t fd = INVALID_SOCKET_FD;
         sockaddr_in addr{};
         bool handshakeDone = false;
         long lastPongTime = 0;
         long handshakeStart = 0;
-        std::string lobbyCode;
+        std::chrono::steady_clock::time_point acceptedAt{}; ///< for the handshake latency metric
         std::string pseudo;
 
         uint8_t posX = 0;
         uint8_t posY = 0;
         uint8_t hp = 0;
         std::vector<uint8_t> recvBuffer;
+
+        std::deque<Protocol::Frame> outQueue; ///< Frames waiting for the socket, shared with other recipients.
+        std::size_t outOffset = 0;            ///< Bytes of outQueue.front() already sent.
+        std::size_t outBytes = 0;             ///< Bytes still queued, across all frames.
     };
 
     /**
@@ -90,6 +107,11 @@ class TCPServer
      */
     void checkHeartbeat();
 
+    /**
+     * @brief Kill game servers that stopped sending IpcType::Heartbeat; handleChildExits() restarts them.
+     */
+    void checkGameServers();
+
     /**
      * @brief Get current time in milliseconds.
      */
@@ -115,13 +137,32 @@ class TCPServer
      *
      * @return Number of ready descriptors or -1 on error.
      */
-    int pollSockets(fd_set &readfds, int maxFd, struct timeval &timeout);
+    int pollSockets(fd_set &readfds, fd_set &writefds, int maxFd, struct timeval &timeout);
 
     /**
-     * @brief Send a packet to a specific client fd.
+     * @brief Send a packet directly to a raw fd (blocking, for sockets without a client slot).
      */
     bool sendPacket(socket_t fd, const Packet &packet);
 
+    /**
+     * @brief Encode a packet and queue it on a client's output buffer.
+     */
+    bool sendPacket(Client &client, const Packet &packet);
+
+    /**
+     * @brief Queue an already encoded frame on a client and try to flush it.
+     *
+     * @return false if the frame was dropped (client gone or output queue full).
+     */
+    bool queueFrame(Client &client, const Protocol::Frame &frame);
+
+    /**
+     * @brief Write as much of the client's output queue as the socket accepts without blocking.
+     *
+     * @return false on a socket error (the queue is discarded).
+     */
+    bool flushClient(Client &client);
+
     /**
      * @brief Result of a receive attempt.
      */
@@ -155,7 +196,7 @@ class TCPServer
     /**
      * @brief Write raw bytes to a socket fd.
      */
-    ssize_t writeFd(socket_t fd, const uint8_t *data, std::size_t size);
+    ssize_t writeFd(socket_t fd, const uint8_t *data, std::size_t size, int flags = 0);
 
     /**
      * @brief Read raw bytes from a socket fd.
@@ -175,12 +216,12 @@ class TCPServer
     /**
      * @brief Build the packet containing the list of connected players.
      */
-    Packet buildPlayerListPacket(const std::string &lobbyCode) const;
+    Packet buildPlayerListPacket(LobbyIndex::LobbyId lobby) const;
 
     /**
      * @brief Send the current player list to a single client.
      */
-    void sendPlayerListToClient(const Client &client);
+    void sendPlayerListToClient(Client &client);
 
     /**
      * @brief Notify all clients of a newly connected player.
@@ -203,10 +244,18 @@ class TCPServer
      */
     void removeFromLobby(const Client &client);
 
+    /**
+     * @brief Lobby the client currently belongs to (INVALID_LOBBY if none).
+     */
+    LobbyIndex::LobbyId lobbyOf(const Client &client) const
+    {
+        return _lobbyIndex.lobbyOf(client.slot);
+    }
+
     /**
      * @brief Resend the player list to all members of a lobby.
      */
-    void refreshLobby(const std::string &code);
+    void refreshLobby(LobbyIndex::LobbyId lobby);
 
     /**
      * @brief Auto-match the client into a public lobby.
@@ -222,8 +271,48 @@ class TCPServer
      * @brief Handle lobby-related packets for a client.
      */
     void handleLobbyPacket(Client &client, const Packet &packet);
-    void processIpcMessages();
-    void broadcastToLobby(const std::string &lobbyCode, const Packet &packet);
+    /**
+     * @brief Drain the IPC channels of the lobbies whose wakeup descriptor is ready.
+     */
+    void processIpcMessages(const fd_set &readfds);
+
+    /**
+     * @brief Reap exited game servers: release their port, restart the ones whose lobby still has players.
+     */
+    void handleChildExits();
+
+    /**
+     * @brief Log CPU and RSS of every game server.
+     */
+    void logChildUsage();
+
+    /**
+     * @brief Ask every lobby's game server for its traffic stats (IpcType::StatsRequest).
+     */
+    void requestGameStats();
+
+    /**
+     * @brief Declare the metric families exposed on the metrics endpoint.
+     */
+    void describeMetrics();
+
+    /**
+     * @brief Fold a metric delta forwarded by a lobby's game server into the registry.
+     */
+    void recordGameMetric(LobbyIndex::LobbyId lobby, const IpcMessage &msg);
+
+    struct LobbyInfo;
+
+    /**
+     * @brief Keep a complete stats reply (IpcType::StatsEnd) and export it as per-lobby and per-client gauges.
+     */
+    void recordGameStats(LobbyIndex::LobbyId lobby, LobbyInfo &info, int32_t expected);
+
+    /**
+     * @brief Refresh the gauges and render the registry for a scrape.
+     */
+    std::string renderMetrics();
+    void broadcastToLobby(LobbyIndex::LobbyId lobby, const Packet &packet);
 
   private:
     Network::TransportLayer::TCPSocket _serverSocket;
@@ -233,15 +322,22 @@ class TCPServer
     struct LobbyInfo
     {
         bool isPublic = false;
-        std::vector<int> players;
         uint16_t udpPort = 0;
-        uint16_t ipcPort = 0;
         std::unique_ptr<IpcChannel> ipc;
+        long lastHeartbeat = 0; ///< getCurrentTime() of the last child heartbeat (or of its start)
+        int childPid = -1;      ///< game server currently serving the lobby
+        int restarts = 0;       ///< crash restarts so far
+        GameStats stats;        ///< last complete reply to a StatsRequest
+        GameStats pendingStats; ///< reply being received
     };
-    std::unordered_map<std::string, LobbyInfo> _lobbies;
-    std::unordered_map<int, std::string> _clientLobby;
-    ChildProcessManager *_childMgr = nullptr; // optional, not wired yet
+    LobbyIndex _lobbyIndex;
+    PortAllocator _ports;
+    std::unordered_map<LobbyIndex::LobbyId, LobbyInfo> _lobbies;
+    ChildProcessManager *_childMgr = nullptr;    // optional, not wired yet
+    WarmPool *_pool = nullptr;                   // optional, lobbies fall back to spawn() when empty
+    MetricsEndpoint *_metricsEndpoint = nullptr; // optional, metrics are still collected without it
+    Metrics::Registry _metrics;
 
     uint16_t allocatePort();
-    void ensureLobbyProcess(const std::string &code, bool isPublic);
+    void ensureLobbyProcess(LobbyIndex::LobbyId lobby, bool isPublic);
 };
@@ -6,10 +6,9 @@
 */
 
 #include "GameWorld.hpp"
+#include "../../../Log/Logger.hpp"
 #include <algorithm>
-#include <chrono>
 #include <cmath>
-#include <iostream>
 #include <limits>
 #include <random>
 
@@ -20,8 +19,6 @@ constexpr float bossHalf = 22.0f;
 constexpr float bulletHalf = 3.0f;   // ~6x6 in client
 constexpr float playerHalfX = 16.5f; // ~33x17 in client
 constexpr float playerHalfY = 8.5f;
-constexpr bool kLogSpawn = false;
-constexpr bool kLogBullets = false;
 constexpr uint8_t kDefaultPlayerHp = 5;
 constexpr long long kPlayerHitCooldownMs = 500;
 constexpr int kKillScore = 10;
@@ -77,9 +74,8 @@ void GameWorld::addShot(int id, uint8_t posX, uint8_t posY, int8_t velX, int8_t
     b.velY = std::clamp<int8_t>(velY, -maxSpeed, maxSpeed);
     _bullets.push_back(b);
 
-    const std::string prefix = _logPrefix.empty() ? "[UDP] " : _logPrefix;
-    std::cout << prefix << "Player " << id << " fired bullet " << b.id << " from " << static_cast<int>(posX) << ","
-              << static_cast<int>(posY) << " vel " << static_cast<int>(velX) << "," << static_cast<int>(velY) << "\n";
+    RTYPE_LOG_DEBUG("%sPlayer %d fired bullet %d from %d,%d vel %d,%d", logPrefix(), id, b.id, posX, posY, velX,
+                    velY);
 }
 
 void GameWorld::removePlayer(int id)
@@ -105,7 +101,6 @@ void GameWorld::removePlayer(int id)
 
 void GameWorld::spawnMonster(long long nowMs)
 {
-    static std::mt19937 rng(static_cast<unsigned long>(std::chrono::steady_clock::now().time_since_epoch().count()));
     std::uniform_int_distribution<int> yDist(20, 235);
     std::uniform_int_distribution<int> ampDist(8, 18);
     std::uniform_real_distribution<float> freqDist(2.5f, 5.0f);
@@ -115,17 +110,17 @@ void GameWorld::spawnMonster(long long nowMs)
     MonsterState m;
     m.id = (_nextMonsterId++ & 0xFFFF);
     m.x = 255.0f;
-    m.baseY = static_cast<float>(yDist(rng));
+    m.baseY = static_cast<float>(yDist(_rng));
     m.y = m.baseY;
     m.hp = 3;
-    int t = typeDist(rng);
+    int t = typeDist(_rng);
     m.kind = t == 0 ? MonsterKind::Sine : MonsterKind::ZigZag;
 
     if (m.kind == MonsterKind::Sine)
     {
-        m.amplitude = static_cast<float>(ampDist(rng));
+        m.amplitude = static_cast<float>(ampDist(_rng));
         m.phase = 0.0f;
-        m.freq = freqDist(rng);
+        m.freq = freqDist(_rng);
         m.speedX = -1.3f;
     }
     else
@@ -137,14 +132,9 @@ void GameWorld::spawnMonster(long long nowMs)
     }
     _monsters.push_back(m);
 
-    _monsterSpawnIntervalMs = intervalDist(rng);
+    _monsterSpawnIntervalMs = intervalDist(_rng);
     _lastMonsterSpawnMs = nowMs;
-    if (kLogSpawn)
-    {
-        const std::string prefix = _logPrefix.empty() ? "[UDP] " : _logPrefix;
-        std::cout << prefix << "Spawned monster " << m.id << " at y=" << m.baseY << " kind=" << static_cast<int>(m.kind)
-                  << "\n";
-    }
+    RTYPE_LOG_DEBUG("%sSpawned monster %d at y=%g kind=%d", logPrefix(), m.id, m.baseY, static_cast<int>(m.kind));
 }
 
 bool GameWorld::shouldSpawnBoss() const
@@ -179,8 +169,7 @@ void GameWorld::spawnBoss(long long nowMs)
     _bossSpawnedFlag = true;
     _bossSpawnedOnce = true;
 
-    const std::string prefix = _logPrefix.empty() ? "[UDP] " : _logPrefix;
-    std::cout << prefix << "Spawned BOSS " << m.id << "\n";
+    RTYPE_LOG_INFO("%sSpawned BOSS %d", logPrefix(), m.id);
 }
 
 bool GameWorld::takeBossSpawned()
@@ -206,7 +195,6 @@ bool GameWorld::takeNoPlayers()
 
 void GameWorld::spawnBossBullet(const MonsterState &boss, long long nowMs)
 {
-    static std::mt19937 rng(static_cast<unsigned long>(std::chrono::steady_clock::now().time_since_epoch().count()));
     std::uniform_int_distribution<int> vxDist(kBossBulletMinVx, kBossBulletMaxVx);
     std::uniform_int_distribution<int> vyDist(-kBossBulletMaxVy, kBossBulletMaxVy);
 
@@ -215,23 +203,22 @@ void GameWorld::spawnBossBullet(const MonsterState &boss, long long nowMs)
     b.ownerId = -boss.id;
     b.x = static_cast<uint8_t>(std::clamp<int>(static_cast<int>(boss.x), 0, 255));
     b.y = static_cast<uint8_t>(std::clamp<int>(static_cast<int>(boss.y), 0, 255));
-    b.velX = static_cast<int8_t>(vxDist(rng));
-    b.velY = static_cast<int8_t>(vyDist(rng));
+    b.velX = static_cast<int8_t>(vxDist(_rng));
+    b.velY = static_cast<int8_t>(vyDist(_rng));
     _bullets.push_back(b);
     (void)nowMs;
 }
 
 void GameWorld::updateBossMovement(MonsterState &boss, long long nowMs, float dtSec)
 {
-    static std::mt19937 rng(static_cast<unsigned long>(std::chrono::steady_clock::now().time_since_epoch().count()));
     std::uniform_real_distribution<float> speedDist(-2.2f, 2.2f);
     std::uniform_int_distribution<int> intervalDist(800, 1600);
 
     if (nowMs >= boss.nextPatternMs)
     {
-        boss.speedX = speedDist(rng);
-        boss.speedY = speedDist(rng) * 0.7f;
-        boss.nextPatternMs = nowMs + intervalDist(rng);
+        boss.speedX = speedDist(_rng);
+        boss.speedY = speedDist(_rng) * 0.7f;
+        boss.nextPatternMs = nowMs + intervalDist(_rng);
     }
 
     boss.x += boss.speedX * dtSec * 32.0f;
@@ -265,225 +252,262 @@ void GameWorld::updateBossMovement(MonsterState &boss, long long nowMs, float dt
 
 void GameWorld::tick(long long nowMs, long long deltaMs)
 {
-    bool bossActive = hasBoss();
-    bool bossWanted = shouldSpawnBoss();
-    if (bossWanted && !bossActive)
+    RTYPE_PROFILE_SCOPE(_profiler, "tick");
     {
-        spawnBoss(nowMs);
-        bossActive = true;
-    }
+        RTYPE_PROFILE_SCOPE(_profiler, "tick.spawn");
+        bool bossActive = hasBoss();
+        bool bossWanted = shouldSpawnBoss();
+        if (bossWanted && !bossActive)
+        {
+            spawnBoss(nowMs);
+            bossActive = true;
+        }
 
-    if (!bossActive && nowMs - _lastMonsterSpawnMs >= _monsterSpawnIntervalMs)
-    {
-        spawnMonster(nowMs);
+        if (!bossActive && nowMs - _lastMonsterSpawnMs >= _monsterSpawnIntervalMs)
+        {
+            spawnMonster(nowMs);
+        }
     }
 
-    for (auto &kv : _players)
     {
-        auto &p = kv.second;
-        int nx = static_cast<int>(p.x) + p.velX;
-        int ny = static_cast<int>(p.y) + p.velY;
-        nx = std::clamp(nx, 0, 255);
-        ny = std::clamp(ny, 0, 255);
-        p.x = static_cast<uint8_t>(nx);
-        p.y = static_cast<uint8_t>(ny);
-        p.velX = 0;
-        p.velY = 0;
+        RTYPE_PROFILE_SCOPE(_profiler, "tick.players");
+        for (auto &kv : _players)
+        {
+            auto &p = kv.second;
+            int nx = static_cast<int>(p.x) + p.velX;
+            int ny = static_cast<int>(p.y) + p.velY;
+            nx = std::clamp(nx, 0, 255);
+            ny = std::clamp(ny, 0, 255);
+            p.x = static_cast<uint8_t>(nx);
+            p.y = static_cast<uint8_t>(ny);
+            p.velX = 0;
+            p.velY = 0;
+        }
     }
 
-    for (auto &kv : _players)
     {
-        auto &p = kv.second;
-        if (p.hp == 0)
-            continue;
-        for (const auto &m : _monsters)
+        RTYPE_PROFILE_SCOPE(_profiler, "tick.collide.monsters");
+        for (auto &kv : _players)
         {
-            float half = (m.kind == MonsterKind::Boss) ? bossHalf : monsterHalf;
-            float dx = std::fabs(m.x - static_cast<float>(p.x));
-            float dy = std::fabs(m.y - static_cast<float>(p.y));
-            if (dx <= half + playerHalfX && dy <= half + playerHalfY)
+            auto &p = kv.second;
+            if (p.hp == 0)
+                continue;
+            for (const auto &m : _monsters)
             {
-                if (nowMs - p.lastHitMs >= kPlayerHitCooldownMs)
+                float half = (m.kind == MonsterKind::Boss) ? bossHalf : monsterHalf;
+                float dx = std::fabs(m.x - static_cast<float>(p.x));
+                float dy = std::fabs(m.y - static_cast<float>(p.y));
+                if (dx <= half + playerHalfX && dy <= half + playerHalfY)
                 {
-                    int newHp = std::max(0, static_cast<int>(p.hp) - 1);
-                    p.hp = static_cast<uint8_t>(newHp);
-                    p.lastHitMs = nowMs;
+                    if (nowMs - p.lastHitMs >= kPlayerHitCooldownMs)
+                    {
+                        int newHp = std::max(0, static_cast<int>(p.hp) - 1);
+                        p.hp = static_cast<uint8_t>(newHp);
+                        p.lastHitMs = nowMs;
+                    }
+                    break;
                 }
-                break;
             }
         }
     }
 
-    auto it = _bullets.begin();
-    while (it != _bullets.end())
     {
-        int nx = static_cast<int>(it->x) + it->velX;
-        int ny = static_cast<int>(it->y) + it->velY;
-        if (nx < 0 || nx > 255 || ny < 0 || ny > 255)
+        RTYPE_PROFILE_SCOPE(_profiler, "tick.bullets");
+        auto it = _bullets.begin();
+        while (it != _bullets.end())
         {
-            it = _bullets.erase(it);
-            continue;
+            int nx = static_cast<int>(it->x) + it->velX;
+            int ny = static_cast<int>(it->y) + it->velY;
+            if (nx < 0 || nx > 255 || ny < 0 || ny > 255)
+            {
+                it = _bullets.erase(it);
+                continue;
+            }
+            it->x = static_cast<uint8_t>(nx);
+            it->y = static_cast<uint8_t>(ny);
+            ++it;
         }
-        it->x = static_cast<uint8_t>(nx);
-        it->y = static_cast<uint8_t>(ny);
-        ++it;
     }
 
-    std::vector<bool> eraseBullet(_bullets.size(), false);
-    for (std::size_t bi = 0; bi < _bullets.size(); ++bi)
     {
-        const auto &b = _bullets[bi];
-        if (b.ownerId >= 0)
-            continue;
-        for (auto &kv : _players)
+        RTYPE_PROFILE_SCOPE(_profiler, "tick.collide.bullets");
+        std::vector<bool> eraseBullet(_bullets.size(), false);
+        for (std::size_t bi = 0; bi < _bullets.size(); ++bi)
         {
-            auto &p = kv.second;
-            if (p.hp == 0)
+            const auto &b = _bullets[bi];
+            if (b.ownerId >= 0)
                 continue;
-            float dx = std::fabs(static_cast<float>(b.x) - static_cast<float>(p.x));
-            float dy = std::fabs(static_cast<float>(b.y) - static_cast<float>(p.y));
-            if (dx <= bulletHalf + playerHalfX && dy <= bulletHalf + playerHalfY)
+            for (auto &kv : _players)
             {
-                if (nowMs - p.lastHitMs >= kPlayerHitCooldownMs)
+                auto &p = kv.second;
+                if (p.hp == 0)
+                    continue;
+                float dx = std::fabs(static_cast<float>(b.x) - static_cast<float>(p.x));
+                float dy = std::fabs(static_cast<float>(b.y) - static_cast<float>(p.y));
+                if (dx <= bulletHalf + playerHalfX && dy <= bulletHalf + playerHalfY)
                 {
-                    int newHp = std::max(0, static_cast<int>(p.hp) - 1);
-                    p.hp = static_cast<uint8_t>(newHp);
-                    p.lastHitMs = nowMs;
+                    if (nowMs - p.lastHitMs >= kPlayerHitCooldownMs)
+                    {
+                        int newHp = std::max(0, static_cast<int>(p.hp) - 1);
+                        p.hp = static_cast<uint8_t>(newHp);
+                        p.lastHitMs = nowMs;
+                    }
+                    eraseBullet[bi] = true;
+                    break;
                 }
-                eraseBullet[bi] = true;
-                break;
             }
         }
-    }
 
-    std::vector<int> bulletsToErase;
-    for (std::size_t bi = 0; bi < _bullets.size(); ++bi)
-    {
-        if (eraseBullet[bi])
-            continue;
-        const auto &b = _bullets[bi];
-        if (b.ownerId < 0)
-            continue;
-        bool hit = false;
-        for (auto &m : _monsters)
+        std::vector<int> bulletsToErase;
+        for (std::size_t bi = 0; bi < _bullets.size(); ++bi)
         {
-            if (m.hp <= 0)
+            if (eraseBullet[bi])
                 continue;
-            float half = (m.kind == MonsterKind::Boss) ? bossHalf : monsterHalf;
-            float dx = std::fabs(m.x - static_cast<float>(b.x));
-            float dy = std::fabs(m.y - static_cast<float>(b.y));
-            if (dx <= half + bulletHalf && dy <= half + bulletHalf)
+            const auto &b = _bullets[bi];
+            if (b.ownerId < 0)
+                continue;
+            bool hit = false;
+            for (auto &m : _monsters)
             {
-                m.hp = static_cast<int8_t>(m.hp - 1);
                 if (m.hp <= 0)
+                    continue;
+                float half = (m.kind == MonsterKind::Boss) ? bossHalf : monsterHalf;
+                float dx = std::fabs(m.x - static_cast<float>(b.x));
+                float dy = std::fabs(m.y - static_cast<float>(b.y));
+                if (dx <= half + bulletHalf && dy <= half + bulletHalf)
                 {
-                    int maxScore = std::numeric_limits<uint16_t>::max();
-                    int newScore = std::min<int>(_lobbyScore + kKillScore, maxScore);
-                    _lobbyScore = static_cast<uint16_t>(newScore);
+                    m.hp = static_cast<int8_t>(m.hp - 1);
+                    if (m.hp <= 0)
+                    {
+                        int maxScore = std::numeric_limits<uint16_t>::max();
+                        int newScore = std::min<int>(_lobbyScore + kKillScore, maxScore);
+                        _lobbyScore = static_cast<uint16_t>(newScore);
+                    }
+                    hit = true;
+                    break;
                 }
-                hit = true;
-                break;
+            }
+            if (hit)
+            {
+                bulletsToErase.push_back(static_cast<int>(bi));
+                _monsterKilled += 1;
+                RTYPE_LOG_DEBUG("%sMonster killed: %d", logPrefix(), static_cast<int>(_monsterKilled));
             }
         }
-        if (hit)
+        for (std::size_t bi = 0; bi < eraseBullet.size(); ++bi)
         {
-            bulletsToErase.push_back(static_cast<int>(bi));
-            _monsterKilled += 1;
-            std::cerr << "Monster killed: " << (int)_monsterKilled << std::endl;
+            if (eraseBullet[bi])
+                bulletsToErase.push_back(static_cast<int>(bi));
+        }
+        std::sort(bulletsToErase.rbegin(), bulletsToErase.rend());
+        for (int idx : bulletsToErase)
+        {
+            if (idx >= 0 && static_cast<std::size_t>(idx) < _bullets.size())
+                _bullets.erase(_bullets.begin() + idx);
         }
-    }
-    for (std::size_t bi = 0; bi < eraseBullet.size(); ++bi)
-    {
-        if (eraseBullet[bi])
-            bulletsToErase.push_back(static_cast<int>(bi));
-    }
-    std::sort(bulletsToErase.rbegin(), bulletsToErase.rend());
-    for (int idx : bulletsToErase)
-    {
-        if (idx >= 0 && static_cast<std::size_t>(idx) < _bullets.size())
-            _bullets.erase(_bullets.begin() + idx);
     }
 
-    auto mIt = _monsters.begin();
-    while (mIt != _monsters.end())
     {
-        if (mIt->hp <= 0)
+        RTYPE_PROFILE_SCOPE(_profiler, "tick.cull");
+        auto mIt = _monsters.begin();
+        while (mIt != _monsters.end())
         {
-            if (mIt->kind == MonsterKind::Boss)
+            if (mIt->hp <= 0)
             {
-                _bossDefeatedFlag = true;
+                if (mIt->kind == MonsterKind::Boss)
+                {
+                    _bossDefeatedFlag = true;
+                }
+                mIt = _monsters.erase(mIt);
+            }
+            else
+            {
+                ++mIt;
             }
-            mIt = _monsters.erase(mIt);
-        }
-        else
-        {
-            ++mIt;
         }
     }
 
-    float dtSec = static_cast<float>(deltaMs) / 1000.0f;
-    auto mit = _monsters.begin();
-    while (mit != _monsters.end())
     {
-        if (mit->kind == MonsterKind::Boss)
+        RTYPE_PROFILE_SCOPE(_profiler, "tick.monsters");
+        float dtSec = static_cast<float>(deltaMs) / 1000.0f;
+        auto mit = _monsters.begin();
+        while (mit != _monsters.end())
         {
-            updateBossMovement(*mit, nowMs, dtSec);
-            if (nowMs >= mit->nextShotMs)
+            if (mit->kind == MonsterKind::Boss)
             {
-                static std::mt19937 rng(
-                    static_cast<unsigned long>(std::chrono::steady_clock::now().time_since_epoch().count()));
-                std::uniform_int_distribution<int> intervalDist(350, 700);
-                spawnBossBullet(*mit, nowMs);
-                mit->nextShotMs = nowMs + intervalDist(rng);
+                updateBossMovement(*mit, nowMs, dtSec);
+                if (nowMs >= mit->nextShotMs)
+                {
+                    std::uniform_int_distribution<int> intervalDist(350, 700);
+                    spawnBossBullet(*mit, nowMs);
+                    mit->nextShotMs = nowMs + intervalDist(_rng);
+                }
+                ++mit;
+                continue;
             }
-            ++mit;
-            continue;
-        }
 
-        mit->phase += mit->freq * dtSec;
-        mit->x += mit->speedX * dtSec * 32.0f;
-        float oscillation = 0.0f;
-        if (mit->kind == MonsterKind::Sine)
-        {
-            oscillation = std::sin(mit->phase);
-        }
-        else
-        { // ZigZag: alternate up/down every ~0.4s
-            float period = 0.4f;
-            float phaseT = std::fmod(static_cast<float>(nowMs) / 1000.0f, period * 2.0f);
-            oscillation = (phaseT < period) ? 1.0f : -1.0f;
-        }
-        mit->y = mit->baseY + mit->amplitude * oscillation;
-        if (mit->x < -5.0f || mit->y < -5.0f || mit->y > 260.0f)
-        {
-            mit = _monsters.erase(mit);
-        }
-        else
-        {
-            ++mit;
+            mit->phase += mit->freq * dtSec;
+            mit->x += mit->speedX * dtSec * 32.0f;
+            float oscillation = 0.0f;
+            if (mit->kind == MonsterKind::Sine)
+            {
+                oscillation = std::sin(mit->phase);
+            }
+            else
+            { // ZigZag: alternate up/down every ~0.4s
+                float period = 0.4f;
+                float phaseT = std::fmod(static_cast<float>(nowMs) / 1000.0f, period * 2.0f);
+                oscillation = (phaseT < period) ? 1.0f : -1.0f;
+            }
+            mit->y = mit->baseY + mit->amplitude * oscillation;
+            if (mit->x < -5.0f || mit->y < -5.0f || mit->y > 260.0f)
+            {
+                mit = _monsters.erase(mit);
+            }
+            else
+            {
+                ++mit;
+            }
         }
     }
 
-    if (kLogBullets && !_bullets.empty())
+#if RTYPE_LOG_MIN_LEVEL == 0
+    if (!_bullets.empty())
     {
-        const std::string prefix = _logPrefix.empty() ? "[UDP] " : _logPrefix;
-        std::cout << prefix << "Bullets: ";
+        std::string line;
         for (const auto &b : _bullets)
-        {
-            std::cout << b.id << "(" << static_cast<int>(b.x) << "," << static_cast<int>(b.y) << ") ";
-        }
-        std::cout << "\n";
+            line += std::to_string(b.id) + "(" + std::to_string(b.x) + "," + std::to_string(b.y) + ") ";
+        RTYPE_LOG_DEBUG("%sBullets: %s", logPrefix(), line.c_str());
     }
+#endif
 }
 
 Packet GameWorld::buildSnapshotPacket()
 {
+    RTYPE_PROFILE_SCOPE(_profiler, "snapshot.build");
+    // Three counts and the sequence number always fit; entities take what is left, players first.
+    constexpr std::size_t kFixedBytes = 5;
+    std::size_t budget = UINT8_MAX - kFixedBytes;
+    std::size_t players = std::min(_players.size(), budget / 7);
+    budget -= players * 7;
+    std::size_t monsters = std::min(_monsters.size(), budget / 6);
+    budget -= monsters * 6;
+    std::size_t bullets = std::min(_bullets.size(), budget / 6);
+    _lastSnapshot.players = static_cast<uint16_t>(players);
+    _lastSnapshot.bullets = static_cast<uint16_t>(bullets);
+    _lastSnapshot.monsters = static_cast<uint16_t>(monsters);
+    _lastSnapshot.dropped =
+        static_cast<uint16_t>(_players.size() + _monsters.size() + _bullets.size() - players - monsters - bullets);
+
     std::vector<uint8_t> payload;
-    payload.reserve(2 + _players.size() * 7 + _bullets.size() * 6 + _monsters.size() * 6);
+    payload.reserve(kFixedBytes + players * 7 + bullets * 6 + monsters * 6);
 
-    payload.push_back(static_cast<uint8_t>(_players.size()));
+    payload.push_back(static_cast<uint8_t>(players));
+    std::size_t written = 0;
     for (const auto &kv : _players)
     {
+        if (written++ == players)
+            break;
         const auto &p = kv.second;
         payload.push_back(static_cast<uint8_t>((p.id >> 8) & 0xFF));
         payload.push_back(static_cast<uint8_t>(p.id & 0xFF));
@@ -494,20 +518,41 @@ Packet GameWorld::buildSnapshotPacket()
         payload.push_back(static_cast<uint8_t>(_lobbyScore & 0xFF));
     }
 
-    payload.push_back(static_cast<uint8_t>(_bullets.size()));
-    for (const auto &b : _bullets)
-    {
+    auto pushBullet = [&payload](const BulletState &b) {
         payload.push_back(static_cast<uint8_t>((b.id >> 8) & 0xFF));
         payload.push_back(static_cast<uint8_t>(b.id & 0xFF));
         payload.push_back(b.x);
         payload.push_back(b.y);
         payload.push_back(static_cast<uint8_t>(b.velX));
         payload.push_back(static_cast<uint8_t>(b.velY));
+    };
+    payload.push_back(static_cast<uint8_t>(bullets));
+    if (bullets == _bullets.size())
+    {
+        for (const auto &b : _bullets)
+            pushBullet(b);
+    }
+    else
+    {
+        // Truncated: hostile bullets (negative owner) can hurt, keep them before the players' own.
+        written = 0;
+        for (int pass = 0; pass < 2 && written < bullets; ++pass)
+        {
+            for (const auto &b : _bullets)
+            {
+                if ((b.ownerId < 0) != (pass == 0))
+                    continue;
+                pushBullet(b);
+                if (++written == bullets)
+                    break;
+            }
+        }
     }
 
-    payload.push_back(static_cast<uint8_t>(_monsters.size()));
-    for (const auto &m : _monsters)
+    payload.push_back(static_cast<uint8_t>(monsters));
+    for (std::size_t i = 0; i < monsters; ++i)
     {
+        const auto &m = _monsters[i];
         payload.push_back(static_cast<uint8_t>((m.id >> 8) & 0xFF));
         payload.push_back(static_cast<uint8_t>(m.id & 0xFF));
         payload.push_back(static_cast<uint8_t>(std::clamp<int>(static_cast<int>(m.x), 0, 255)));
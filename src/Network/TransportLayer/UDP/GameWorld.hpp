@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "../../../Metrics/Profiler.hpp"
 #include "../Packet.hpp"
 #ifndef _WIN32
 #include <netinet/in.h>
@@ -18,6 +19,7 @@ constexpr double HALF_PI = PI / 2.0;
 
 #endif
 #include <cstdint>
+#include <random>
 #include <unordered_map>
 #include <vector>
 
@@ -90,7 +92,14 @@ class GameWorld
         long long nextShotMs = 0;
     };
 
-    GameWorld() = default;
+    /**
+     * @brief World whose spawns and boss patterns come from an RNG seeded with `seed`.
+     *
+     * Same seed and same inputs (packets, tick times) give the same snapshots; rtype-replay relies on it.
+     */
+    explicit GameWorld(uint32_t seed = std::random_device{}()) : _rng(seed)
+    {
+    }
 
     /**
      * @brief Register a player on HELLO_UDP.
@@ -117,10 +126,32 @@ class GameWorld
      */
     void tick(long long nowMs, long long deltaMs);
 
+    /**
+     * @brief Entities written to the last snapshot, and those left out to fit the payload cap.
+     */
+    struct SnapshotInfo
+    {
+        uint16_t players = 0;
+        uint16_t bullets = 0;
+        uint16_t monsters = 0;
+        uint16_t dropped = 0; ///< entities omitted, 0 unless the snapshot was truncated
+    };
+
     /**
      * @brief Build a UDP snapshot packet of current world state.
+     *
+     * The payload never exceeds the 255 bytes of the size field: past that, bullets fired by
+     * players are left out first, then hostile bullets, then monsters (see lastSnapshot()).
      */
     Packet buildSnapshotPacket();
+
+    /**
+     * @brief What the last buildSnapshotPacket() wrote.
+     */
+    const SnapshotInfo &lastSnapshot() const
+    {
+        return _lastSnapshot;
+    }
     /**
      * @brief Consume boss-spawned flag (one-shot).
      */
@@ -155,6 +186,13 @@ class GameWorld
     {
         _logPrefix = prefix;
     }
+    /**
+     * @brief Profiler receiving the tick and snapshot sections (RTYPE_PROFILING builds only).
+     */
+    void setProfiler(Metrics::Profiler *profiler)
+    {
+        _profiler = profiler;
+    }
 
   private:
     void spawnMonster(long long nowMs);
@@ -163,6 +201,10 @@ class GameWorld
     bool shouldSpawnBoss() const;
     bool hasBoss() const;
     void updateBossMovement(MonsterState &boss, long long nowMs, float dtSec);
+    const char *logPrefix() const
+    {
+        return _logPrefix.empty() ? "[UDP] " : _logPrefix.c_str();
+    }
 
     std::unordered_map<int, PlayerState> _players;
     std::vector<BulletState> _bullets;
@@ -178,6 +220,9 @@ class GameWorld
     bool _hadPlayers = false;
     bool _noPlayersFlag = false;
     uint16_t _lobbyScore = 0;
+    SnapshotInfo _lastSnapshot;
     uint16_t _snapshotSeq = 0;
+    std::mt19937 _rng;
     std::string _logPrefix;
+    Metrics::Profiler *_profiler = nullptr;
 };
@@ -0,0 +1,136 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** UDPSocket behind a simulated bad network
+*/
+
+#ifndef IMPAIREDUDPSOCKET_HPP_
+#define IMPAIREDUDPSOCKET_HPP_
+
+#include "Impairment.hpp"
+#include "UDPSocket.hpp"
+#include <chrono>
+#include <cstring>
+
+namespace Network::TransportLayer
+{
+/**
+ * @brief UDPSocket whose sends and receives can go through an Impairment line each.
+ *
+ * Without setImpairment() every call goes straight to the socket. With it, writeByte()
+ * queues the datagram and flush() sends the ones that are due; readByte() drains the
+ * socket into the inbound line and returns the next due datagram. Writes and flush()
+ * must come from one thread, reads from one (possibly other) thread.
+ */
+class ImpairedUDPSocket
+{
+  public:
+    bool bindTo(std::uint16_t port, std::uint32_t address = INADDR_ANY)
+    {
+        return _socket.bindTo(port, address);
+    }
+
+    std::uint16_t localPort() const
+    {
+        return _socket.localPort();
+    }
+
+    /**
+     * @brief Impair both directions with `config` (inbound uses seed + 1). Call before any traffic.
+     */
+    void setImpairment(const Impairment::Config &config)
+    {
+        Impairment::Config inbound = config;
+        inbound.seed = config.seed + 1;
+        _out.configure(config);
+        _in.configure(inbound);
+    }
+
+    bool impaired() const
+    {
+        return _out.enabled();
+    }
+
+    /**
+     * @return size when the datagram was sent or queued, -1 on error.
+     */
+    ssize_t writeByte(const char *data, std::size_t size, const sockaddr_in &destAddr)
+    {
+        if (!_out.enabled())
+            return _socket.writeByte(data, size, destAddr);
+        if (data == nullptr || size == 0)
+            return -1;
+        _out.push(reinterpret_cast<const uint8_t *>(data), size, destAddr, nowMs());
+        flush();
+        return static_cast<ssize_t>(size);
+    }
+
+    /**
+     * @brief Send the queued outbound datagrams that are due.
+     */
+    void flush()
+    {
+        if (!_out.enabled())
+            return;
+        long long now = nowMs();
+        while (_out.pop(now, _sending))
+            _socket.writeByte(reinterpret_cast<const char *>(_sending.bytes.data()), _sending.bytes.size(),
+                              _sending.addr);
+    }
+
+    /**
+     * @return bytes of the next due datagram, or -1 when there is none.
+     */
+    ssize_t readByte(char *buffer, std::size_t size)
+    {
+        if (!_in.enabled())
+        {
+            ssize_t n = _socket.readByte(buffer, size);
+            _senderAddr = _socket.getSenderAddr();
+            return n;
+        }
+        long long now = nowMs();
+        ssize_t n;
+        while ((n = _socket.readByte(buffer, size)) > 0)
+            _in.push(reinterpret_cast<const uint8_t *>(buffer), static_cast<std::size_t>(n), _socket.getSenderAddr(),
+                     now);
+        if (!_in.pop(now, _receiving))
+            return -1;
+        std::size_t len = std::min(size, _receiving.bytes.size());
+        std::memcpy(buffer, _receiving.bytes.data(), len);
+        _senderAddr = _receiving.addr;
+        return static_cast<ssize_t>(len);
+    }
+
+    sockaddr_in getSenderAddr() const
+    {
+        return _senderAddr;
+    }
+
+    const Impairment::Stats &outboundStats() const
+    {
+        return _out.stats();
+    }
+    const Impairment::Stats &inboundStats() const
+    {
+        return _in.stats();
+    }
+
+  private:
+    static long long nowMs()
+    {
+        using namespace std::chrono;
+        return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    UDPSocket _socket;
+    Impairment _out;
+    Impairment _in;
+    Impairment::Datagram _sending;   ///< writer thread
+    Impairment::Datagram _receiving; ///< reader thread
+    sockaddr_in _senderAddr{};
+};
+} // namespace Network::TransportLayer
+
+#endif /* !IMPAIREDUDPSOCKET_HPP_ */
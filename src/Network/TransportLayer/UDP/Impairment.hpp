@@ -0,0 +1,246 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Simulated bad network for UDP datagrams
+*/
+
+#ifndef IMPAIRMENT_HPP_
+#define IMPAIRMENT_HPP_
+
+#ifndef _WIN32
+#include <netinet/in.h>
+#else
+#include <winsock2.h>
+#endif
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Network::TransportLayer
+{
+/**
+ * @brief One direction of a simulated link: datagrams go in, and come out later, twice, or never.
+ *
+ * Each datagram is dropped with probability loss, otherwise delayed by latency +/- jitter;
+ * a "reordered" one is held back a further max(2 * jitter, 20) ms so later datagrams overtake
+ * it, and a duplicated one is delivered a second time with its own delay. Every decision
+ * comes from a seeded RNG, so a run can be repeated. Not thread-safe: one line per thread
+ * and direction.
+ */
+class Impairment
+{
+  public:
+    /**
+     * @brief Link parameters; all zero means a perfect link.
+     */
+    struct Config
+    {
+        int latencyMs = 0;      ///< one-way delay
+        int jitterMs = 0;       ///< uniform +/- around the latency
+        float lossPct = 0;      ///< datagrams dropped
+        float duplicatePct = 0; ///< datagrams delivered twice
+        float reorderPct = 0;   ///< datagrams held back behind later ones
+        uint32_t seed = 1;
+
+        bool enabled() const
+        {
+            return latencyMs > 0 || jitterMs > 0 || lossPct > 0 || duplicatePct > 0 || reorderPct > 0;
+        }
+
+        /**
+         * @brief Parse "latency=80,jitter=20,loss=2,dup=1,reorder=5,seed=7" (any subset, any order).
+         * @return false on an unknown key or a malformed value.
+         */
+        static bool parse(const std::string &spec, Config &out)
+        {
+            Config cfg = out;
+            std::size_t pos = 0;
+            while (pos < spec.size())
+            {
+                std::size_t end = spec.find(',', pos);
+                if (end == std::string::npos)
+                    end = spec.size();
+                std::string item = spec.substr(pos, end - pos);
+                pos = end + 1;
+                std::size_t eq = item.find('=');
+                if (eq == std::string::npos)
+                    return false;
+                std::string key = item.substr(0, eq);
+                const char *text = item.c_str() + eq + 1;
+                char *rest = nullptr;
+                double value = std::strtod(text, &rest);
+                if (rest == text || *rest != '\0' || value < 0)
+                    return false;
+                if (key == "latency")
+                    cfg.latencyMs = static_cast<int>(value);
+                else if (key == "jitter")
+                    cfg.jitterMs = static_cast<int>(value);
+                else if (key == "loss")
+                    cfg.lossPct = static_cast<float>(value);
+                else if (key == "dup")
+                    cfg.duplicatePct = static_cast<float>(value);
+                else if (key == "reorder")
+                    cfg.reorderPct = static_cast<float>(value);
+                else if (key == "seed")
+                    cfg.seed = static_cast<uint32_t>(value);
+                else
+                    return false;
+            }
+            out = cfg;
+            return true;
+        }
+
+        /**
+         * @brief The spec back, for logs.
+         */
+        std::string describe() const
+        {
+            char buf[128];
+            std::snprintf(buf, sizeof(buf), "latency=%d jitter=%d loss=%.1f%% dup=%.1f%% reorder=%.1f%% seed=%u",
+                          latencyMs, jitterMs, lossPct, duplicatePct, reorderPct, seed);
+            return buf;
+        }
+    };
+
+    /**
+     * @brief What the line did so far.
+     */
+    struct Stats
+    {
+        uint64_t submitted = 0;
+        uint64_t dropped = 0;
+        uint64_t duplicated = 0;
+        uint64_t reordered = 0;
+        uint64_t delivered = 0;
+    };
+
+    /**
+     * @brief A datagram released by the line.
+     */
+    struct Datagram
+    {
+        std::vector<uint8_t> bytes;
+        sockaddr_in addr{};
+    };
+
+    Impairment() = default;
+
+    explicit Impairment(const Config &config)
+    {
+        configure(config);
+    }
+
+    /**
+     * @brief Apply new parameters and restart the RNG from config.seed (pending datagrams are kept).
+     */
+    void configure(const Config &config)
+    {
+        _config = config;
+        _rng.seed(config.seed);
+    }
+
+    const Config &config() const
+    {
+        return _config;
+    }
+
+    bool enabled() const
+    {
+        return _config.enabled();
+    }
+
+    /**
+     * @brief Put a datagram on the line at nowMs; it is released by pop() zero, one or two times.
+     * @param addr Destination (outbound) or sender (inbound), handed back with the datagram.
+     */
+    void push(const uint8_t *data, std::size_t size, const sockaddr_in &addr, long long nowMs)
+    {
+        ++_stats.submitted;
+        if (roll(_config.lossPct))
+        {
+            ++_stats.dropped;
+            return;
+        }
+        int copies = 1;
+        if (roll(_config.duplicatePct))
+        {
+            ++_stats.duplicated;
+            copies = 2;
+        }
+        for (int i = 0; i < copies; ++i)
+        {
+            long long delay = _config.latencyMs;
+            if (_config.jitterMs > 0)
+                delay += std::uniform_int_distribution<int>(-_config.jitterMs, _config.jitterMs)(_rng);
+            if (roll(_config.reorderPct))
+            {
+                ++_stats.reordered;
+                delay += std::max(2 * _config.jitterMs, 20);
+            }
+            Pending p;
+            p.dueMs = nowMs + std::max<long long>(delay, 0);
+            p.order = _nextOrder++;
+            p.datagram.bytes.assign(data, data + size);
+            p.datagram.addr = addr;
+            _pending.push(std::move(p));
+        }
+    }
+
+    /**
+     * @brief Take the next datagram due by nowMs, in due-time order.
+     * @return false when nothing is due yet.
+     */
+    bool pop(long long nowMs, Datagram &out)
+    {
+        if (_pending.empty() || _pending.top().dueMs > nowMs)
+            return false;
+        out = std::move(const_cast<Pending &>(_pending.top()).datagram);
+        _pending.pop();
+        ++_stats.delivered;
+        return true;
+    }
+
+    std::size_t pending() const
+    {
+        return _pending.size();
+    }
+
+    const Stats &stats() const
+    {
+        return _stats;
+    }
+
+  private:
+    struct Pending
+    {
+        long long dueMs = 0;
+        uint64_t order = 0; ///< keeps equal due times in submission order
+        Datagram datagram;
+
+        bool operator>(const Pending &other) const
+        {
+            return dueMs != other.dueMs ? dueMs > other.dueMs : order > other.order;
+        }
+    };
+
+    bool roll(float pct)
+    {
+        return pct > 0 && std::uniform_real_distribution<float>(0.0f, 100.0f)(_rng) < pct;
+    }
+
+    Config _config;
+    Stats _stats;
+    std::mt19937 _rng{1};
+    uint64_t _nextOrder = 0;
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>> _pending;
+};
+} // namespace Network::TransportLayer
+
+#endif /* !IMPAIRMENT_HPP_ */
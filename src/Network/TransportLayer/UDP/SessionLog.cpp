@@ -0,0 +1,180 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Binary record of a UDP lobby session
+*/
+
+#include "SessionLog.hpp"
+#include <algorithm>
+
+namespace
+{
+constexpr char kMagic[4] = {'R', 'T', 'R', 'P'};
+constexpr uint16_t kVersion = 1;
+} // namespace
+
+uint32_t fnv1a(const uint8_t *data, std::size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+SessionLogWriter::~SessionLogWriter()
+{
+    close();
+}
+
+bool SessionLogWriter::open(const std::string &path, const std::string &lobby, uint32_t seed)
+{
+    close();
+    _file = std::fopen(path.c_str(), "wb");
+    if (!_file)
+        return false;
+    std::fwrite(kMagic, 1, sizeof(kMagic), _file);
+    put(kVersion, 2);
+    put(seed, 4);
+    put(lobby.size(), 2);
+    std::fwrite(lobby.data(), 1, lobby.size(), _file);
+    return true;
+}
+
+void SessionLogWriter::close()
+{
+    if (!_file)
+        return;
+    std::fclose(_file);
+    _file = nullptr;
+}
+
+void SessionLogWriter::put(uint64_t value, int bytes)
+{
+    uint8_t buf[8];
+    for (int i = 0; i < bytes; ++i)
+        buf[i] = static_cast<uint8_t>(value >> (8 * i));
+    std::fwrite(buf, 1, static_cast<std::size_t>(bytes), _file);
+}
+
+void SessionLogWriter::packet(uint32_t tick, long long arrivedMs, const sockaddr_in &from, const Packet &packet)
+{
+    put(static_cast<uint8_t>(SessionEventKind::Packet), 1);
+    put(tick, 4);
+    put(static_cast<uint64_t>(arrivedMs), 8);
+    put(ntohl(from.sin_addr.s_addr), 4);
+    put(ntohs(from.sin_port), 2);
+    put(static_cast<uint8_t>(packet.type), 1);
+    put(packet.payload.size(), 2);
+    std::fwrite(packet.payload.data(), 1, packet.payload.size(), _file);
+}
+
+void SessionLogWriter::tick(uint32_t tick, long long nowMs, long long deltaMs)
+{
+    put(static_cast<uint8_t>(SessionEventKind::Tick), 1);
+    put(tick, 4);
+    put(static_cast<uint64_t>(nowMs), 8);
+    put(static_cast<uint64_t>(deltaMs), 8);
+}
+
+void SessionLogWriter::broadcast(uint32_t tick, long long nowMs)
+{
+    put(static_cast<uint8_t>(SessionEventKind::Broadcast), 1);
+    put(tick, 4);
+    put(static_cast<uint64_t>(nowMs), 8);
+}
+
+void SessionLogWriter::snapshot(uint32_t tick, const std::vector<uint8_t> &payload)
+{
+    put(static_cast<uint8_t>(SessionEventKind::Snapshot), 1);
+    put(tick, 4);
+    put(fnv1a(payload.data(), payload.size()), 4);
+    put(payload.size(), 2);
+}
+
+SessionLogReader::~SessionLogReader()
+{
+    if (_file)
+        std::fclose(_file);
+}
+
+bool SessionLogReader::get(uint64_t &value, int bytes)
+{
+    uint8_t buf[8];
+    if (std::fread(buf, 1, static_cast<std::size_t>(bytes), _file) != static_cast<std::size_t>(bytes))
+        return false;
+    value = 0;
+    for (int i = 0; i < bytes; ++i)
+        value |= static_cast<uint64_t>(buf[i]) << (8 * i);
+    return true;
+}
+
+bool SessionLogReader::open(const std::string &path)
+{
+    _file = std::fopen(path.c_str(), "rb");
+    if (!_file)
+        return false;
+    char magic[4];
+    uint64_t version = 0;
+    uint64_t seed = 0;
+    uint64_t lobbyLen = 0;
+    if (std::fread(magic, 1, sizeof(magic), _file) != sizeof(magic) || !std::equal(magic, magic + 4, kMagic) ||
+        !get(version, 2) || version != kVersion || !get(seed, 4) || !get(lobbyLen, 2))
+        return false;
+    _seed = static_cast<uint32_t>(seed);
+    _lobby.resize(lobbyLen);
+    return std::fread(&_lobby[0], 1, lobbyLen, _file) == lobbyLen;
+}
+
+bool SessionLogReader::next(SessionEvent &event)
+{
+    uint64_t kind = 0;
+    uint64_t tick = 0;
+    uint64_t a = 0;
+    uint64_t b = 0;
+    if (!get(kind, 1) || !get(tick, 4))
+        return false;
+    event.kind = static_cast<SessionEventKind>(kind);
+    event.tick = static_cast<uint32_t>(tick);
+    switch (event.kind)
+    {
+    case SessionEventKind::Packet: {
+        uint64_t addr = 0;
+        uint64_t port = 0;
+        uint64_t type = 0;
+        uint64_t len = 0;
+        if (!get(a, 8) || !get(addr, 4) || !get(port, 2) || !get(type, 1) || !get(len, 2))
+            return false;
+        event.timeMs = static_cast<long long>(a);
+        event.from = sockaddr_in{};
+        event.from.sin_family = AF_INET;
+        event.from.sin_addr.s_addr = htonl(static_cast<uint32_t>(addr));
+        event.from.sin_port = htons(static_cast<uint16_t>(port));
+        event.packet.type = static_cast<PacketType>(type);
+        event.packet.payload.resize(len);
+        event.packet.size = static_cast<uint8_t>(len);
+        return len == 0 || std::fread(event.packet.payload.data(), 1, len, _file) == len;
+    }
+    case SessionEventKind::Tick:
+        if (!get(a, 8) || !get(b, 8))
+            return false;
+        event.timeMs = static_cast<long long>(a);
+        event.deltaMs = static_cast<long long>(b);
+        return true;
+    case SessionEventKind::Broadcast:
+        if (!get(a, 8))
+            return false;
+        event.timeMs = static_cast<long long>(a);
+        return true;
+    case SessionEventKind::Snapshot:
+        if (!get(a, 4) || !get(b, 2))
+            return false;
+        event.hash = static_cast<uint32_t>(a);
+        event.size = static_cast<uint16_t>(b);
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,123 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Binary record of a UDP lobby session
+*/
+
+#pragma once
+
+#include "../Packet.hpp"
+#ifndef _WIN32
+#include <netinet/in.h>
+#else
+#include <winsock2.h>
+#endif
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief What a game server loop did, in the order it did it.
+ */
+enum class SessionEventKind : uint8_t
+{
+    Packet = 1,    ///< inbound packet handled
+    Tick = 2,      ///< updateSimulation(timeMs, deltaMs)
+    Broadcast = 3, ///< broadcastSnapshot() at timeMs
+    Snapshot = 4   ///< a snapshot was built (hash and size, to check a replay)
+};
+
+/**
+ * @brief One record of a session log.
+ */
+struct SessionEvent
+{
+    SessionEventKind kind = SessionEventKind::Tick;
+    uint32_t tick = 0;     ///< ticks run before this event
+    long long timeMs = 0;  ///< arrival time (Packet) or simulation time (Tick, Broadcast)
+    long long deltaMs = 0; ///< Tick only
+    sockaddr_in from{};    ///< Packet only
+    Packet packet;         ///< Packet only
+    uint32_t hash = 0;     ///< Snapshot only: FNV-1a of the payload
+    uint16_t size = 0;     ///< Snapshot only: payload bytes
+};
+
+/**
+ * @brief FNV-1a hash (snapshot payloads, per-lobby seeds).
+ */
+uint32_t fnv1a(const uint8_t *data, std::size_t size);
+
+/**
+ * @brief Appends a session to a file: header (lobby, RNG seed) then one record per event.
+ *
+ * Integers are little-endian; a Packet record costs 22 bytes plus its payload.
+ * Writes go through stdio buffering, so recording costs no syscall per packet.
+ */
+class SessionLogWriter
+{
+  public:
+    SessionLogWriter() = default;
+    ~SessionLogWriter();
+    SessionLogWriter(const SessionLogWriter &) = delete;
+    SessionLogWriter &operator=(const SessionLogWriter &) = delete;
+
+    /**
+     * @return false if the file cannot be created.
+     */
+    bool open(const std::string &path, const std::string &lobby, uint32_t seed);
+    bool isOpen() const
+    {
+        return _file != nullptr;
+    }
+    void close();
+
+    void packet(uint32_t tick, long long arrivedMs, const sockaddr_in &from, const Packet &packet);
+    void tick(uint32_t tick, long long nowMs, long long deltaMs);
+    void broadcast(uint32_t tick, long long nowMs);
+    void snapshot(uint32_t tick, const std::vector<uint8_t> &payload);
+
+  private:
+    void put(uint64_t value, int bytes);
+
+    FILE *_file = nullptr;
+};
+
+/**
+ * @brief Reads back a file written by SessionLogWriter.
+ */
+class SessionLogReader
+{
+  public:
+    SessionLogReader() = default;
+    ~SessionLogReader();
+    SessionLogReader(const SessionLogReader &) = delete;
+    SessionLogReader &operator=(const SessionLogReader &) = delete;
+
+    /**
+     * @return false if the file is missing or not a session log.
+     */
+    bool open(const std::string &path);
+
+    /**
+     * @brief Next event; false at the end of the file or on a truncated record.
+     */
+    bool next(SessionEvent &event);
+
+    const std::string &lobby() const
+    {
+        return _lobby;
+    }
+    uint32_t seed() const
+    {
+        return _seed;
+    }
+
+  private:
+    bool get(uint64_t &value, int bytes);
+
+    FILE *_file = nullptr;
+    std::string _lobby;
+    uint32_t _seed = 0;
+};
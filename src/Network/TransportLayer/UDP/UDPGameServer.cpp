@@ -6,7 +6,9 @@
 */
 
 #include "UDPGameServer.hpp"
-#include <iostream>
+#include "../../../Log/Logger.hpp"
+#include "../../../Metrics/ThreadCpu.hpp"
+#include <algorithm>
 #include <sstream>
 #include <thread>
 
@@ -16,19 +18,33 @@ constexpr std::size_t UDP_BUFFER_SIZE = 1024;
 }
 
 UDPGameServer::UDPGameServer(uint16_t port, SessionManager &sessions, long long snapshotIntervalMs,
-                             std::string lobbyCode)
-    : _port(port), _snapshotIntervalMs(snapshotIntervalMs), _sessions(sessions), _expectedLobby(std::move(lobbyCode))
+                             std::string lobbyCode, uint32_t seed)
+    : _sessions(sessions), _port(port), _snapshotIntervalMs(snapshotIntervalMs), _expectedLobby(std::move(lobbyCode)),
+      _seed(seed)
 {
     if (!_socket.bindTo(port))
     {
         throw std::runtime_error("Failed to bind UDP socket");
     }
-    std::cout << logPrefix() << "Listening on port " << port << std::endl;
+    if (port == 0)
+        _port = _socket.localPort();
+    refreshLogPrefix();
+    RTYPE_LOG_INFO("%sListening on port %u", _logPrefix.c_str(), static_cast<unsigned>(_port));
+    init();
+}
+
+UDPGameServer::UDPGameServer(Headless, SessionManager &sessions, std::string lobbyCode, uint32_t seed)
+    : _sessions(sessions), _port(0), _snapshotIntervalMs(0), _expectedLobby(std::move(lobbyCode)), _seed(seed),
+      _headless(true)
+{
+    refreshLogPrefix();
+    init();
+}
+
+void UDPGameServer::init()
+{
     if (!_expectedLobby.empty())
-    {
-        _worlds[_expectedLobby] = GameWorld{};
-        _worlds[_expectedLobby].setLogPrefix(logPrefix());
-    }
+        worldFor(_expectedLobby);
     _sessions.setOnRemove([this](int id) {
         auto itLobby = _playerLobby.find(id);
         if (itLobby != _playerLobby.end())
@@ -47,6 +63,45 @@ UDPGameServer::UDPGameServer(uint16_t port, SessionManager &sessions, long long
     });
 }
 
+GameWorld &UDPGameServer::worldFor(const std::string &lobbyCode)
+{
+    auto it = _worlds.find(lobbyCode);
+    if (it != _worlds.end())
+        return it->second;
+    // Each lobby gets its own stream, derived from the server seed so a recording replays from one number.
+    uint32_t seed = _seed ^ fnv1a(reinterpret_cast<const uint8_t *>(lobbyCode.data()), lobbyCode.size());
+    GameWorld &world = _worlds.emplace(lobbyCode, GameWorld(seed)).first->second;
+    world.setLogPrefix(_logPrefix);
+    world.setProfiler(&_profiler);
+    return world;
+}
+
+void UDPGameServer::setLobby(const std::string &lobbyCode)
+{
+    _expectedLobby = lobbyCode;
+    refreshLogPrefix();
+    _worlds.clear();
+    if (!_expectedLobby.empty())
+        worldFor(_expectedLobby);
+}
+
+void UDPGameServer::setRecordFile(const std::string &path)
+{
+    _recordFile = path;
+}
+
+void UDPGameServer::setImpairment(const Network::TransportLayer::Impairment::Config &config)
+{
+    _socket.setImpairment(config);
+    RTYPE_LOG_INFO("%sSimulated network: %s", _logPrefix.c_str(), config.describe().c_str());
+}
+
+void UDPGameServer::setTraceFile(const std::string &path)
+{
+    _traceFile = path;
+    _profiler.enableTrace();
+}
+
 UDPGameServer::~UDPGameServer()
 {
     _running = false;
@@ -64,16 +119,46 @@ long long UDPGameServer::nowMs() const
 
 bool UDPGameServer::sendPacketTo(const Packet &packet, const sockaddr_in &to)
 {
-    auto data = packet.serialize();
-    return _socket.writeByte(reinterpret_cast<const char *>(data.data()), data.size(), to) ==
-           static_cast<ssize_t>(data.size());
+    auto data = packet.serialize(); // throws on oversized payloads, in a replay too
+    if (_headless)
+        return true;
+    bool sent = _socket.writeByte(reinterpret_cast<const char *>(data.data()), data.size(), to) ==
+                static_cast<ssize_t>(data.size());
+    if (!sent)
+    {
+        _metrics.add(IpcMetric::PacketsDropped, 1);
+        return false;
+    }
+    _metrics.add(IpcMetric::PacketsOut, 1);
+    _metrics.add(IpcMetric::BytesOut, data.size());
+    _traffic.sent(to, data.size());
+    return true;
+}
+
+void UDPGameServer::noteSnapshot(const Packet &snapshot, const GameWorld &world)
+{
+    const GameWorld::SnapshotInfo &info = world.lastSnapshot();
+    _traffic.snapshot(4 + snapshot.payload.size(), info.players, info.bullets, info.monsters, info.dropped);
+    _metrics.sample(IpcMetric::SnapshotBytes, 4 + snapshot.payload.size());
+    if (info.dropped > 0)
+    {
+        _metrics.add(IpcMetric::Truncations, 1);
+        RTYPE_LOG_WARN("%sSnapshot truncated to %zu bytes: %u entities left out", _logPrefix.c_str(),
+                       snapshot.payload.size(), static_cast<unsigned>(info.dropped));
+    }
+    if (_recorder.isOpen())
+        _recorder.snapshot(_ticks, snapshot.payload);
+    if (_replayHashes)
+        _replayHashes->push_back(fnv1a(snapshot.payload.data(), snapshot.payload.size()));
 }
 
 void UDPGameServer::broadcastSnapshot()
 {
+    RTYPE_PROFILE_SCOPE(&_profiler, "server.broadcast");
     for (auto &kv : _worlds)
     {
         Packet snap = kv.second.buildSnapshotPacket();
+        noteSnapshot(snap, kv.second);
         for (const auto &player : kv.second.players())
         {
             sendPacketTo(snap, player.second.addr);
@@ -85,7 +170,7 @@ void UDPGameServer::handleHello(const Packet &packet, const sockaddr_in &from)
 {
     if (packet.payload.size() < 2)
     {
-        std::cerr << logPrefix() << "HELLO_UDP payload too small\n";
+        RTYPE_LOG_WARN("%sHELLO_UDP payload too small", _logPrefix.c_str());
         return;
     }
     int id = (packet.payload[0] << 8) | packet.payload[1];
@@ -101,22 +186,22 @@ void UDPGameServer::handleHello(const Packet &packet, const sockaddr_in &from)
         _sessions.setUdpAddr(id, from);
     }
 
-    GameWorld &world = _worlds[lobbyCode];
-    world.setLogPrefix(logPrefix());
+    GameWorld &world = worldFor(lobbyCode);
     world.registerPlayer(id, x, y, from);
+    _traffic.identify(from, id);
     _playerLobby[id] = lobbyCode;
     // Send a fresh snapshot immediately so the client sees the lobby state without waiting the next tick.
     Packet snap = world.buildSnapshotPacket();
+    noteSnapshot(snap, world);
     sendPacketTo(snap, from);
-    std::cout << logPrefix() << "Registered client id=" << id << " at " << static_cast<int>(x) << ","
-              << static_cast<int>(y) << "\n";
+    RTYPE_LOG_INFO("%sRegistered client id=%d at %d,%d", _logPrefix.c_str(), id, x, y);
 }
 
 void UDPGameServer::handleInput(const Packet &packet, const sockaddr_in &from)
 {
     if (packet.payload.size() < 7)
     {
-        std::cerr << logPrefix() << "INPUT payload too small\n";
+        RTYPE_LOG_WARN("%sINPUT payload too small", _logPrefix.c_str());
         return;
     }
     int id = (packet.payload[0] << 8) | packet.payload[1];
@@ -148,14 +233,8 @@ void UDPGameServer::handleInput(const Packet &packet, const sockaddr_in &from)
         lobbyIt = _playerLobby.find(id);
     }
 
-    auto worldIt = _worlds.find(lobbyIt->second);
-    if (worldIt == _worlds.end())
-    {
-        worldIt = _worlds.emplace(lobbyIt->second, GameWorld{}).first;
-    }
-    worldIt->second.setLogPrefix(logPrefix());
-
-    worldIt->second.updateInput(id, velX, velY, dir, from);
+    worldFor(lobbyIt->second).updateInput(id, velX, velY, dir, from);
+    _traffic.identify(from, id);
 }
 
 void UDPGameServer::handleShoot(const Packet &packet)
@@ -190,14 +269,7 @@ void UDPGameServer::handleShoot(const Packet &packet)
         }
         lobbyIt = _playerLobby.find(id);
     }
-    auto worldIt = _worlds.find(lobbyIt->second);
-    if (worldIt == _worlds.end())
-    {
-        worldIt = _worlds.emplace(lobbyIt->second, GameWorld{}).first;
-    }
-    worldIt->second.setLogPrefix(logPrefix());
-
-    worldIt->second.addShot(id, posX, posY, velX, velY);
+    worldFor(lobbyIt->second).addShot(id, posX, posY, velX, velY);
 }
 
 void UDPGameServer::handlePacket(const Packet &packet, const sockaddr_in &from)
@@ -228,15 +300,29 @@ void UDPGameServer::run()
 
     _lastSnapshotMs = nowMs();
     _lastTickMs = _lastSnapshotMs;
+    _lastProfileReportMs = _lastSnapshotMs;
+    if (!_recordFile.empty())
+    {
+        if (_recorder.open(_recordFile, _expectedLobby, _seed))
+            RTYPE_LOG_INFO("%sRecording to %s (seed %u)", _logPrefix.c_str(), _recordFile.c_str(), _seed);
+        else
+            RTYPE_LOG_ERROR("%sUnable to record to %s", _logPrefix.c_str(), _recordFile.c_str());
+    }
 
     while (_running)
     {
         {
+            RTYPE_PROFILE_SCOPE(&_profiler, "server.drain");
             std::lock_guard<std::mutex> lock(_queueMutex);
             while (!_incoming.empty())
             {
                 auto item = _incoming.front();
                 _incoming.pop();
+                _metrics.add(IpcMetric::PacketsIn, 1);
+                _metrics.add(IpcMetric::BytesIn, 4 + item.pkt.payload.size());
+                _traffic.received(item.from, 4 + item.pkt.payload.size());
+                if (_recorder.isOpen())
+                    _recorder.packet(_ticks, item.arrivedMs, item.from, item.pkt);
                 handlePacket(item.pkt, item.from);
             }
         }
@@ -244,16 +330,61 @@ void UDPGameServer::run()
         long long now = nowMs();
         if (now - _lastTickMs >= _tickIntervalMs)
         {
+            if (_recorder.isOpen())
+                _recorder.tick(_ticks, now, now - _lastTickMs);
+            auto tickStart = std::chrono::steady_clock::now();
+            uint64_t cpuStart = Metrics::threadCpuNs();
             updateSimulation(now, now - _lastTickMs);
+            _tickCpuNs += Metrics::threadCpuNs() - cpuStart;
+            ++_ticks;
+            auto tickNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                                tickStart);
+            _tickNs.record(static_cast<uint64_t>(tickNs.count()));
+            _metrics.sample(IpcMetric::TickMicros, static_cast<uint64_t>(tickNs.count() / 1000));
             _lastTickMs = now;
+            if (_ipc)
+                serviceIpcRequests();
         }
 
         if (now - _lastSnapshotMs >= _snapshotIntervalMs)
         {
+            if (_recorder.isOpen())
+                _recorder.broadcast(_ticks, now);
             broadcastSnapshot();
             _lastSnapshotMs = now;
         }
-        _ipc->send("RUNNING");
+        if (_ipc && now - _lastHeartbeatMs >= _heartbeatIntervalMs)
+        {
+            int32_t players = 0;
+            for (const auto &kv : _worlds)
+                players += static_cast<int32_t>(kv.second.players().size());
+            _ipc->send(IpcMessage::make(IpcType::Heartbeat, players, _expectedLobby));
+            _lastHeartbeatMs = now;
+        }
+        if (now - _lastMetricsMs >= _metricsIntervalMs)
+        {
+            _traffic.roll(now);
+            if (_ipc)
+            {
+                _metrics.add(IpcMetric::PacketsDropped, _rxDropped.exchange(0));
+                _metrics.flush(*_ipc);
+            }
+            _lastMetricsMs = now;
+        }
+        if (now - _lastProfileReportMs >= _profileReportIntervalMs)
+        {
+            if (_profiler.hasSamples())
+            {
+                std::stringstream report;
+                _profiler.report(report, _logPrefix);
+                std::string line;
+                while (std::getline(report, line))
+                    RTYPE_LOG_INFO("%s", line.c_str());
+            }
+            _profiler.reset();
+            _lastProfileReportMs = now;
+        }
+        _socket.flush(); // delayed sends, when the network is impaired
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 
@@ -261,21 +392,43 @@ void UDPGameServer::run()
     {
         _networkThread.join();
     }
+    if (!_traceFile.empty())
+    {
+        if (_profiler.writeChromeTrace(_traceFile, "lobby " + _expectedLobby))
+            RTYPE_LOG_INFO("%sWrote trace %s", _logPrefix.c_str(), _traceFile.c_str());
+        else
+            RTYPE_LOG_ERROR("%sUnable to write trace %s", _logPrefix.c_str(), _traceFile.c_str());
+    }
+    if (_recorder.isOpen())
+    {
+        _recorder.close();
+        RTYPE_LOG_INFO("%sWrote recording %s (%u ticks)", _logPrefix.c_str(), _recordFile.c_str(), _ticks);
+    }
+}
+
+void UDPGameServer::serviceIpcRequests()
+{
+    while (auto msg = _ipc->recv(0))
+    {
+        if (msg->type == IpcType::StatsRequest && !_traffic.report(*_ipc))
+            RTYPE_LOG_WARN("%sIPC ring full, stats reply dropped", _logPrefix.c_str());
+    }
 }
 
 void UDPGameServer::updateSimulation(long long nowMs, long long deltaMs)
 {
+    RTYPE_PROFILE_SCOPE(&_profiler, "server.tick");
     std::vector<std::string> emptyWorlds;
     for (auto &kv : _worlds)
     {
         kv.second.tick(nowMs, deltaMs);
         if (_ipc && kv.second.takeBossSpawned())
         {
-            _ipc->send("BOSS:" + kv.first);
+            _ipc->send(IpcMessage::make(IpcType::BossSpawned, 0, kv.first));
         }
         if (_ipc && kv.second.takeBossDefeated())
         {
-            _ipc->send("BOSS_DEAD:" + kv.first);
+            _ipc->send(IpcMessage::make(IpcType::BossDead, 0, kv.first));
             _running = false;
         }
         std::vector<int> toRemove;
@@ -290,7 +443,7 @@ void UDPGameServer::updateSimulation(long long nowMs, long long deltaMs)
         {
             if (_ipc)
             {
-                _ipc->send("DEAD:" + std::to_string(id));
+                _ipc->send(IpcMessage::make(IpcType::PlayerDead, id, kv.first));
             }
             kv.second.removePlayer(id);
             _playerLobby.erase(id);
@@ -305,7 +458,7 @@ void UDPGameServer::updateSimulation(long long nowMs, long long deltaMs)
         _worlds.erase(code);
         if (_ipc)
         {
-            _ipc->send("NO_PLAYERS:" + code);
+            _ipc->send(IpcMessage::make(IpcType::NoPlayers, 0, code));
         }
         if (!_expectedLobby.empty() && _expectedLobby == code)
         {
@@ -326,19 +479,18 @@ void UDPGameServer::networkLoop()
         ssize_t n = _socket.readByte(reinterpret_cast<char *>(buffer), sizeof(buffer));
         if (n > 0)
         {
-            try
-            {
-                Packet packet = Packet::deserialize(buffer, static_cast<size_t>(n));
-                Incoming inc;
-                inc.pkt = std::move(packet);
-                inc.from = _socket.getSenderAddr();
-                std::lock_guard<std::mutex> lock(_queueMutex);
-                _incoming.push(std::move(inc));
-            }
-            catch (const std::exception &e)
+            Incoming inc;
+            ParseStatus status = Packet::tryDeserialize(buffer, static_cast<size_t>(n), inc.pkt);
+            if (status != ParseStatus::Ok)
             {
-                std::cerr << logPrefix() << "Failed to parse packet: " << e.what() << "\n";
+                ++_rxDropped;
+                RTYPE_LOG_WARN("%sFailed to parse packet: %s", _logPrefix.c_str(), parseStatusName(status));
+                continue;
             }
+            inc.from = _socket.getSenderAddr();
+            inc.arrivedMs = nowMs();
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            _incoming.push(std::move(inc));
         }
         else
         {
@@ -347,10 +499,85 @@ void UDPGameServer::networkLoop()
     }
 }
 
-std::string UDPGameServer::logPrefix() const
+void UDPGameServer::refreshLogPrefix()
 {
     std::ostringstream oss;
     oss << "[UDP lobby=" << (_expectedLobby.empty() ? "?" : _expectedLobby) << " port=" << _port
         << " tid=" << std::this_thread::get_id() << "] ";
-    return oss.str();
+    _logPrefix = oss.str();
+}
+
+bool UDPGameServer::replay(const std::string &path, ReplayResult &result)
+{
+    SessionLogReader reader;
+    if (!reader.open(path))
+    {
+        result.error = "not a session log: " + path;
+        return false;
+    }
+    SessionManager sessions;
+    UDPGameServer server(Headless{}, sessions, reader.lobby(), reader.seed());
+    result.lobby = reader.lobby();
+    result.seed = reader.seed();
+    std::vector<uint32_t> produced;
+    std::vector<uint32_t> recorded;
+    server._replayHashes = &produced;
+
+    SessionEvent event;
+    long long firstTickMs = -1;
+    auto wallStart = std::chrono::steady_clock::now();
+    try
+    {
+        while (reader.next(event))
+        {
+            switch (event.kind)
+            {
+            case SessionEventKind::Packet:
+                server.handlePacket(event.packet, event.from);
+                ++result.packets;
+                break;
+            case SessionEventKind::Tick: {
+                auto start = std::chrono::steady_clock::now();
+                server.updateSimulation(event.timeMs, event.deltaMs);
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+                result.tickNs.record(static_cast<uint64_t>(ns.count()));
+                if (firstTickMs < 0)
+                    firstTickMs = event.timeMs;
+                result.simulatedMs = event.timeMs - firstTickMs;
+                ++result.ticks;
+                break;
+            }
+            case SessionEventKind::Broadcast:
+                server.broadcastSnapshot();
+                break;
+            case SessionEventKind::Snapshot:
+                recorded.push_back(event.hash);
+                break;
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        // The recorded server hit the same exception, if the replay is faithful; its last records follow.
+        result.error = e.what();
+        while (reader.next(event))
+        {
+            if (event.kind == SessionEventKind::Snapshot)
+                recorded.push_back(event.hash);
+        }
+    }
+    result.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+
+    result.snapshots = produced.size();
+    result.recordedSnapshots = recorded.size();
+    std::size_t common = std::min(produced.size(), recorded.size());
+    for (std::size_t i = 0; i < common; ++i)
+    {
+        if (produced[i] == recorded[i])
+            continue;
+        if (result.firstMismatch < 0)
+            result.firstMismatch = static_cast<long long>(i);
+        ++result.mismatches;
+    }
+    return true;
 }
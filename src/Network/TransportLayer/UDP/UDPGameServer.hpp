@@ -11,12 +11,16 @@
 #include "../Packet.hpp"
 #include "GameWorld.hpp"
 #include "IpcChannel.hpp"
-#include "UDPSocket.hpp"
+#include "IpcMetrics.hpp"
+#include "IpcStats.hpp"
+#include "SessionLog.hpp"
+#include "ImpairedUDPSocket.hpp"
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
+#include <random>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -32,20 +36,130 @@
 class UDPGameServer
 {
   public:
+    /**
+     * @param port UDP port to listen on; 0 lets the system pick one (see port()).
+     * @param seed Seeds every lobby's RNG (mixed with the lobby code); written to recordings.
+     */
     explicit UDPGameServer(uint16_t port, SessionManager &sessions, long long snapshotIntervalMs = 500,
-                           std::string lobbyCode = "PUBLIC");
+                           std::string lobbyCode = "PUBLIC", uint32_t seed = std::random_device{}());
     ~UDPGameServer();
 
+    /**
+     * @brief Outcome of replay().
+     */
+    struct ReplayResult
+    {
+        std::string lobby;
+        uint32_t seed = 0;
+        uint64_t packets = 0;
+        uint64_t ticks = 0;
+        uint64_t snapshots = 0;         ///< built by the replay
+        uint64_t recordedSnapshots = 0; ///< built by the recorded server
+        uint64_t mismatches = 0;        ///< snapshots whose hash differs from the recording
+        long long firstMismatch = -1;   ///< index of the first differing snapshot
+        long long simulatedMs = 0;      ///< game time covered by the ticks
+        double wallMs = 0;              ///< time the replay took
+        Metrics::Histogram tickNs;      ///< updateSimulation() durations
+        std::string error;              ///< open failure, or what the simulation threw
+    };
+
+    /**
+     * @brief Re-run a recording headless, as fast as possible, checking every snapshot against it.
+     * @return false if the file cannot be read (see result.error).
+     */
+    static bool replay(const std::string &path, ReplayResult &result);
+
     /**
      * @brief Start the main server loop (blocking).
      */
     void run();
+
+    /**
+     * @brief Make run() return after the current iteration (async-signal-safe).
+     */
+    void stop()
+    {
+        _running = false;
+    }
     void setIpc(IpcChannel *ipc)
     {
         _ipc = ipc;
     }
 
+    /**
+     * @brief Bind the server to a lobby after construction (pooled servers).
+     *
+     * Must be called before run().
+     */
+    void setLobby(const std::string &lobbyCode);
+
+    /**
+     * @brief Keep recent profiler events and write them as Chrome trace JSON when run() returns.
+     */
+    void setTraceFile(const std::string &path);
+
+    /**
+     * @brief Record inbound packets, tick times and the seed to `path` while run() runs (see rtype-replay).
+     */
+    void setRecordFile(const std::string &path);
+
+    /**
+     * @brief Run both directions of the socket through a simulated bad network (RTYPE_NETEM).
+     *
+     * Must be called before run().
+     */
+    void setImpairment(const Network::TransportLayer::Impairment::Config &config);
+
+    /**
+     * @brief Port the server listens on.
+     */
+    uint16_t port() const
+    {
+        return _port;
+    }
+
+    /**
+     * @brief updateSimulation() durations in run(), in ns; read once run() returned.
+     */
+    const Metrics::Histogram &tickNs() const
+    {
+        return _tickNs;
+    }
+
+    /**
+     * @brief Thread CPU time spent in updateSimulation() by run(), in ns; read once run() returned.
+     */
+    uint64_t tickCpuNs() const
+    {
+        return _tickCpuNs;
+    }
+
   private:
+    struct Headless
+    {
+    };
+
+    /**
+     * @brief Server without a socket, used by replay(): packets are fed in, sends are dropped.
+     */
+    UDPGameServer(Headless, SessionManager &sessions, std::string lobbyCode, uint32_t seed);
+    void init();
+
+    /**
+     * @brief World of a lobby, created with its derived seed on first use.
+     */
+    GameWorld &worldFor(const std::string &lobbyCode);
+
+    /**
+     * @brief Account a snapshot built by `world` and hand it to the recorder or the replay check.
+     */
+    void noteSnapshot(const Packet &snapshot, const GameWorld &world);
+
+    /**
+     * @brief Answer the lobby server's pending IPC requests (StatsRequest).
+     */
+    void serviceIpcRequests();
+
     /**
      * @brief Route an incoming packet to the appropriate handler.
      *
@@ -105,26 +219,54 @@ class UDPGameServer
      * @brief Thread loop to read incoming UDP packets without blocking the simulation tick.
      */
     void networkLoop();
-    std::string logPrefix() const;
 
-    Network::TransportLayer::UDPSocket _socket;
+    /**
+     * @brief Rebuild _logPrefix after the lobby changes (tid is the thread calling it).
+     */
+    void refreshLogPrefix();
+
+    Network::TransportLayer::ImpairedUDPSocket _socket;
     std::unordered_map<std::string, GameWorld> _worlds;
     std::unordered_map<int, std::string> _playerLobby;
     SessionManager &_sessions;
     long long _lastSnapshotMs = 0;
     long long _lastTickMs = 0;
-    const uint16_t _port;
+    uint16_t _port; ///< set once bound
     const long long _snapshotIntervalMs;
     std::string _expectedLobby;
+    std::string _logPrefix; ///< built once, not per log line
     const long long _tickIntervalMs = 32; // 16 = ~60 hz (les grand jeux c'est environ 100 ticks/d)
+    const long long _heartbeatIntervalMs = 1000;
+    long long _lastHeartbeatMs = 0;
     struct Incoming
     {
         Packet pkt;
         sockaddr_in from{};
+        long long arrivedMs = 0;
     };
     std::queue<Incoming> _incoming;
     std::mutex _queueMutex;
     std::atomic<bool> _running{false};
     std::thread _networkThread;
     IpcChannel *_ipc = nullptr;
+
+    IpcMetricsWriter _metrics; ///< forwarded to the lobby server every _metricsIntervalMs
+    std::atomic<uint64_t> _rxDropped{0};
+    TrafficStats _traffic; ///< per lobby and client, answered to IpcType::StatsRequest
+    const long long _metricsIntervalMs = 1000;
+    long long _lastMetricsMs = 0;
+
+    Metrics::Profiler _profiler; ///< sections of this lobby's loop, filled in RTYPE_PROFILING builds
+    std::string _traceFile;
+    const long long _profileReportIntervalMs = 10000;
+    long long _lastProfileReportMs = 0;
+
+    const uint32_t _seed;
+    const bool _headless = false;
+    uint32_t _ticks = 0;
+    Metrics::Histogram _tickNs;
+    uint64_t _tickCpuNs = 0;
+    std::string _recordFile;
+    SessionLogWriter _recorder;
+    std::vector<uint32_t> *_replayHashes = nullptr;
 };
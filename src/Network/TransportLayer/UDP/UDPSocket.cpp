@@ -14,6 +14,15 @@ bool UDPSocket::bindTo(std::uint16_t port, std::uint32_t address)
     return bindSock(AF_INET, port, address);
 }
 
+std::uint16_t UDPSocket::localPort() const
+{
+    sockaddr_in addr{};
+    socklen_t addrLen = sizeof(addr);
+    if (getsockname(_socketFd, reinterpret_cast<struct sockaddr *>(&addr), &addrLen) != 0)
+        return 0;
+    return ntohs(addr.sin_port);
+}
+
 ssize_t UDPSocket::writeByte(const char *data, std::size_t size)
 {
     if (data == nullptr || size == 0)
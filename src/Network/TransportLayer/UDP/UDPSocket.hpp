@@ -82,6 +82,13 @@ class UDPSocket : public ASocket
      */
     bool bindTo(std::uint16_t port, std::uint32_t address = INADDR_ANY);
 
+    /**
+     * @brief Get the port the socket is bound to (the one picked by the system after bindTo(0))
+     *
+     * @return The local port, or 0 if the socket is not bound
+     */
+    std::uint16_t localPort() const;
+
   protected:
   private:
     sockaddr_in _senderAddr;
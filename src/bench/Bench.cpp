@@ -0,0 +1,162 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Minimal microbenchmark harness
+*/
+
+#include "Bench.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <thread>
+
+namespace
+{
+constexpr double kMinTimeNs = 200e6; // grow iterations until one run lasts at least 200 ms
+constexpr uint64_t kMaxIterations = 1000000000ULL;
+
+std::string caseName(const Bench::Case &c, const std::vector<long long> &args)
+{
+    std::string name = c.name;
+    for (long long a : args)
+        name += "/" + std::to_string(a);
+    return name;
+}
+
+/**
+ * @brief One finished measurement, kept for the JSON report.
+ */
+struct Result
+{
+    std::string name;
+    uint64_t iterations = 0;
+    double nsPerOp = 0;
+    double itemsPerSec = 0;
+};
+
+std::string jsonEscape(const std::string &text)
+{
+    std::string out;
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+/**
+ * @brief Write results in Google Benchmark's JSON layout, so existing tooling (compare.py, CI dashboards) reads it.
+ */
+bool writeJson(const std::string &path, const char *executable, const std::vector<Result> &results)
+{
+    FILE *out = path == "-" ? stdout : std::fopen(path.c_str(), "w");
+    if (!out)
+    {
+        std::fprintf(stderr, "rtype-bench: cannot open %s\n", path.c_str());
+        return false;
+    }
+    char date[32] = {};
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+#ifdef NDEBUG
+    const char *buildType = "release";
+#else
+    const char *buildType = "debug";
+#endif
+    std::fprintf(out, "{\n  \"context\": {\n");
+    std::fprintf(out, "    \"date\": \"%s\",\n", date);
+    std::fprintf(out, "    \"executable\": \"%s\",\n", jsonEscape(executable).c_str());
+    std::fprintf(out, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+    std::fprintf(out, "    \"library_build_type\": \"%s\"\n  },\n", buildType);
+    std::fprintf(out, "  \"benchmarks\": [");
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const Result &r = results[i];
+        std::fprintf(out, "%s\n    {\n", i ? "," : "");
+        std::fprintf(out, "      \"name\": \"%s\",\n", jsonEscape(r.name).c_str());
+        std::fprintf(out, "      \"run_name\": \"%s\",\n", jsonEscape(r.name).c_str());
+        std::fprintf(out, "      \"run_type\": \"iteration\",\n");
+        std::fprintf(out, "      \"iterations\": %llu,\n", static_cast<unsigned long long>(r.iterations));
+        std::fprintf(out, "      \"real_time\": %.3f,\n", r.nsPerOp);
+        std::fprintf(out, "      \"time_unit\": \"ns\"");
+        if (r.itemsPerSec > 0)
+            std::fprintf(out, ",\n      \"items_per_second\": %.1f", r.itemsPerSec);
+        std::fprintf(out, "\n    }");
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+    if (out != stdout)
+        std::fclose(out);
+    return true;
+}
+} // namespace
+
+std::vector<Bench::Case> &Bench::registry()
+{
+    static std::vector<Case> cases;
+    return cases;
+}
+
+int Bench::runAll(int argc, char **argv)
+{
+    std::string filter;
+    std::string jsonPath;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        if (a == "--filter" && i + 1 < argc)
+            filter = argv[++i];
+        else if (a == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+    }
+    // With --json -, stdout carries the report and the table moves to stderr.
+    FILE *table = jsonPath == "-" ? stderr : stdout;
+
+    std::vector<Result> results;
+    std::fprintf(table, "%-48s %14s %14s %16s\n", "benchmark", "iterations", "ns/op", "items/s");
+    for (const auto &c : registry())
+    {
+        std::vector<std::vector<long long>> argSets = c.argSets;
+        if (argSets.empty())
+            argSets.push_back({});
+        for (const auto &args : argSets)
+        {
+            std::string name = caseName(c, args);
+            if (!filter.empty() && name.find(filter) == std::string::npos)
+                continue;
+
+            uint64_t iterations = 1;
+            while (true)
+            {
+                State state(iterations, args);
+                c.fn(state);
+                double ns = state.elapsedNs();
+                if (ns >= kMinTimeNs || iterations >= kMaxIterations)
+                {
+                    double perOp = ns / static_cast<double>(iterations);
+                    double itemsPerSec = state.itemsProcessed() ? state.itemsProcessed() * 1e9 / ns : 0.0;
+                    std::fprintf(table, "%-48s %14llu %14.1f %16.0f\n", name.c_str(),
+                                 static_cast<unsigned long long>(iterations), perOp, itemsPerSec);
+                    std::fflush(table);
+                    results.push_back(Result{name, iterations, perOp, itemsPerSec});
+                    break;
+                }
+                // Aim slightly past the target, never grow more than 10x per step.
+                double factor = ns > 0 ? (kMinTimeNs * 1.4) / ns : 10.0;
+                factor = factor > 10.0 ? 10.0 : (factor < 2.0 ? 2.0 : factor);
+                iterations = static_cast<uint64_t>(static_cast<double>(iterations) * factor);
+            }
+        }
+    }
+    if (!jsonPath.empty() && !writeJson(jsonPath, argv[0], results))
+        return 1;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    return Bench::runAll(argc, argv);
+}
@@ -0,0 +1,171 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Minimal microbenchmark harness
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace Bench
+ * @brief Small self-contained benchmark harness (Google-Benchmark style, no dependency).
+ *
+ * A benchmark is a free function taking a State; the timed region is the body of
+ * `while (state.keepRunning())`. The runner grows the iteration count until the
+ * measured time is long enough to be stable.
+ */
+namespace Bench
+{
+/**
+ * @brief Per-run state handed to a benchmark function.
+ */
+class State
+{
+  public:
+    State(uint64_t iterations, std::vector<long long> args) : _iterations(iterations), _args(std::move(args))
+    {
+    }
+
+    /**
+     * @brief Loop condition of the timed region.
+     */
+    bool keepRunning()
+    {
+        if (!_started)
+        {
+            _started = true;
+            resumeTiming();
+        }
+        if (_done < _iterations)
+        {
+            ++_done;
+            return true;
+        }
+        pauseTiming();
+        return false;
+    }
+
+    /**
+     * @brief Exclude setup work from the measurement.
+     */
+    void pauseTiming()
+    {
+        if (_running)
+            _elapsed += Clock::now() - _start;
+        _running = false;
+    }
+
+    /**
+     * @brief Resume measurement after pauseTiming().
+     */
+    void resumeTiming()
+    {
+        _start = Clock::now();
+        _running = true;
+    }
+
+    /**
+     * @brief Integer argument registered with the benchmark.
+     */
+    long long arg(std::size_t i) const
+    {
+        return i < _args.size() ? _args[i] : 0;
+    }
+
+    /**
+     * @brief Number of logical items processed (used for items/s).
+     */
+    void setItemsProcessed(uint64_t items)
+    {
+        _items = items;
+    }
+
+    uint64_t iterations() const
+    {
+        return _iterations;
+    }
+    uint64_t itemsProcessed() const
+    {
+        return _items;
+    }
+    double elapsedNs() const
+    {
+        return std::chrono::duration<double, std::nano>(_elapsed).count();
+    }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t _iterations;
+    uint64_t _done = 0;
+    uint64_t _items = 0;
+    bool _started = false;
+    bool _running = false;
+    std::vector<long long> _args;
+    Clock::time_point _start{};
+    Clock::duration _elapsed{};
+};
+
+using Function = void (*)(State &);
+
+/**
+ * @brief Registered benchmark with its argument sets.
+ */
+struct Case
+{
+    std::string name;
+    Function fn = nullptr;
+    std::vector<std::vector<long long>> argSets;
+};
+
+/**
+ * @brief Global list of registered benchmarks.
+ */
+std::vector<Case> &registry();
+
+/**
+ * @brief Static registration helper used by RTYPE_BENCHMARK.
+ */
+struct Registrar
+{
+    Registrar(const char *name, Function fn, std::vector<std::vector<long long>> argSets = {})
+    {
+        registry().push_back(Case{name, fn, std::move(argSets)});
+    }
+};
+
+/**
+ * @brief Keep the compiler from optimizing a computed value away.
+ */
+template <typename T> inline void doNotOptimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const T *volatile sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Run every registered benchmark whose name contains the filter.
+ *
+ * Flags: `--filter TEXT`, `--json PATH` (Google Benchmark JSON layout, `-` for stdout).
+ */
+int runAll(int argc, char **argv);
+} // namespace Bench
+
+#define RTYPE_BENCH_CONCAT_(a, b) a##b
+#define RTYPE_BENCH_CONCAT(a, b) RTYPE_BENCH_CONCAT_(a, b)
+
+/**
+ * @brief Register a benchmark function, optionally with argument sets: RTYPE_BENCHMARK(fn, {{10}, {100}}).
+ */
+#define RTYPE_BENCHMARK(fn, ...)                                                                                       \
+    static const Bench::Registrar RTYPE_BENCH_CONCAT(benchRegistrar_, __LINE__)(#fn, fn, ##__VA_ARGS__)
@@ -0,0 +1,102 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Client draw list benchmarks
+*/
+
+#include "../graphical-client/Raylib/DrawList.hpp"
+#include "Bench.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+namespace
+{
+constexpr uint32_t kPlayerSheet = 3;
+constexpr uint32_t kMonsterSheet = 4;
+
+/**
+ * @brief Queue a busy frame: 4 players, arg(0) monsters and arg(1) bullets, interleaved as the ECS yields them.
+ */
+void fillFrame(Raylib::DrawList &list, long long monsters, long long bullets)
+{
+    long long total = 4 + monsters + bullets;
+    long long m = 0;
+    long long b = 0;
+    for (long long i = 0; i < total; ++i)
+    {
+        float x = static_cast<float>(i % 1280);
+        float y = static_cast<float>((i * 7) % 720);
+        if (i < 4)
+            list.sprite(kPlayerSheet, 166, 86, {0, 0, 33, 17}, {x, y, 33, 17}, {255, 255, 255, 255}, 0);
+        else if ((i % 2 == 0 && m < monsters) || b >= bullets)
+        {
+            list.sprite(kMonsterSheet, 205, 36, {17.0f * (m % 12), 0, 17, 18}, {x, y, 17, 18}, {255, 255, 255, 255}, 0);
+            ++m;
+        }
+        else
+        {
+            list.rect({x, y, 6, 6}, {230, 41, 55, 255}, 1);
+            ++b;
+        }
+    }
+}
+
+/**
+ * @brief Aborts unless a sorted list is expectedRuns runs, one per (layer, texture), layers ascending and
+ * submission order kept in a run; measure() must report one draw call per run.
+ */
+void checkSorted(const Raylib::DrawList &list, std::size_t queued, std::size_t expectedRuns)
+{
+    const std::vector<Raylib::DrawCommand> &cmds = list.commands();
+    std::set<uint64_t> runs;
+    const char *error = cmds.size() != queued ? "commands lost" : nullptr;
+    for (std::size_t i = 0; i < cmds.size() && !error; ++i)
+    {
+        runs.insert(cmds[i].key);
+        if (i == 0)
+            continue;
+        if ((cmds[i].key >> 32) < (cmds[i - 1].key >> 32))
+            error = "layers out of order";
+        else if (cmds[i].key == cmds[i - 1].key && cmds[i].order < cmds[i - 1].order)
+            error = "submission order lost within a run";
+    }
+    if (!error && runs.size() != expectedRuns)
+        error = "unexpected number of (layer, texture) runs";
+    if (!error && list.measure().drawCalls != runs.size())
+        error = "draw calls differ from the (layer, texture) runs";
+    if (error)
+    {
+        std::fprintf(stderr, "BM_DrawListBuildSort: %s (%zu commands, %zu runs, %zu draw calls)\n", error,
+                     cmds.size(), runs.size(), list.measure().drawCalls);
+        std::abort();
+    }
+}
+
+/**
+ * @brief Per-frame cost of building and sorting the draw list.
+ *
+ * The first frame is checked with checkSorted(): 4 + 50 + 500 interleaved quads come down to 3 draw calls.
+ */
+void BM_DrawListBuildSort(Bench::State &state)
+{
+    Raylib::DrawList list;
+    fillFrame(list, state.arg(0), state.arg(1));
+    list.sort();
+    // Player sheet and monster sheet on layer 0, bullets on layer 1.
+    checkSorted(list, static_cast<std::size_t>(4 + state.arg(0) + state.arg(1)), 3);
+    std::size_t commands = 0;
+    while (state.keepRunning())
+    {
+        list.clear();
+        fillFrame(list, state.arg(0), state.arg(1));
+        list.sort();
+        commands += list.commands().size();
+    }
+    Bench::doNotOptimize(list.measure());
+    state.setItemsProcessed(commands);
+}
+RTYPE_BENCHMARK(BM_DrawListBuildSort, {{50, 500}, {200, 5000}});
+} // namespace
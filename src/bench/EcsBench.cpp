@@ -0,0 +1,333 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Client ECS storage benchmarks
+*/
+
+#include "../graphical-client/ecs/Core.hpp"
+#include "../graphical-client/ecs/EntityPool.hpp"
+#include "../graphical-client/ecs/MotionComponents.hpp"
+#include "Bench.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t kLiveEntities = 100000;
+constexpr std::size_t kSceneEntities = 10000;
+
+// Stand-ins for the client components, which pull in raylib.
+struct BenchPosition
+{
+    float x = 0;
+    float y = 0;
+};
+
+struct BenchVelocity
+{
+    float vx = 0;
+    float vy = 0;
+};
+
+struct BenchRect
+{
+    int w = 6;
+    int h = 6;
+};
+
+Entity spawnBullet(ECS &ecs, float i)
+{
+    Entity e = ecs.createEntity();
+    ecs.addComponent(e, BenchPosition{i, i});
+    ecs.addComponent(e, BenchVelocity{2, 0});
+    ecs.addComponent(e, BenchRect{});
+    return e;
+}
+
+/**
+ * @brief Bullets dying and spawning while 100k entities stay alive (slots recycled).
+ *
+ * Each iteration destroys the oldest bullet and creates a new one, so memory must stay flat.
+ */
+void BM_EcsCreateDestroyChurn(Bench::State &state)
+{
+    ECS ecs;
+    std::vector<Entity> live;
+    live.reserve(kLiveEntities);
+    for (std::size_t i = 0; i < kLiveEntities; ++i)
+        live.push_back(spawnBullet(ecs, static_cast<float>(i)));
+    std::size_t oldest = 0;
+    while (state.keepRunning())
+    {
+        ecs.destroyEntity(live[oldest]);
+        live[oldest] = spawnBullet(ecs, static_cast<float>(oldest));
+        oldest = (oldest + 1) % kLiveEntities;
+    }
+    Bench::doNotOptimize(ecs.aliveCount());
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_EcsCreateDestroyChurn);
+
+/**
+ * @brief Packed iteration over entities owning Position and Velocity, half of them also moving.
+ */
+void BM_EcsEachPacked(Bench::State &state)
+{
+    ECS ecs;
+    for (std::size_t i = 0; i < kLiveEntities; ++i)
+    {
+        Entity e = ecs.createEntity();
+        ecs.addComponent(e, BenchPosition{static_cast<float>(i), 0});
+        if (i % 2 == 0)
+            ecs.addComponent(e, BenchVelocity{1, 1});
+    }
+    while (state.keepRunning())
+    {
+        ecs.each<BenchPosition, BenchVelocity>([](Entity, BenchPosition &pos, BenchVelocity &vel) {
+            pos.x += vel.vx;
+            pos.y += vel.vy;
+        });
+    }
+    Bench::doNotOptimize(ecs.getAllComponents<BenchPosition>().data());
+    state.setItemsProcessed(state.iterations() * kLiveEntities / 2);
+}
+RTYPE_BENCHMARK(BM_EcsEachPacked);
+
+/**
+ * @brief Scene of moving entities, as the client holds them in its id -> Entity maps.
+ */
+std::vector<Entity> makeScene(ECS &ecs)
+{
+    std::vector<Entity> scene;
+    for (std::size_t i = 0; i < kSceneEntities; ++i)
+        scene.push_back(spawnBullet(ecs, static_cast<float>(i)));
+    return scene;
+}
+
+/**
+ * @brief Per-entity getComponent through a typeid-keyed hash map, as the ECS used to do.
+ */
+void BM_EcsAccessTypeidMap(Bench::State &state)
+{
+    ECS ecs;
+    std::vector<Entity> scene = makeScene(ecs);
+    std::unordered_map<std::type_index, std::unique_ptr<IComponentArray>> storages;
+    for (Entity e : scene)
+    {
+        auto &positions = storages[typeid(BenchPosition)];
+        if (!positions)
+            positions = std::make_unique<ComponentArray<BenchPosition>>();
+        static_cast<ComponentArray<BenchPosition> *>(positions.get())->add(e, ecs.getComponent<BenchPosition>(e));
+        auto &velocities = storages[typeid(BenchVelocity)];
+        if (!velocities)
+            velocities = std::make_unique<ComponentArray<BenchVelocity>>();
+        static_cast<ComponentArray<BenchVelocity> *>(velocities.get())->add(e, ecs.getComponent<BenchVelocity>(e));
+    }
+    while (state.keepRunning())
+    {
+        for (Entity e : scene)
+        {
+            auto &pos = static_cast<ComponentArray<BenchPosition> *>(storages[typeid(BenchPosition)].get())->get(e);
+            auto &vel = static_cast<ComponentArray<BenchVelocity> *>(storages[typeid(BenchVelocity)].get())->get(e);
+            pos.x += vel.vx;
+        }
+    }
+    state.setItemsProcessed(state.iterations() * kSceneEntities);
+}
+RTYPE_BENCHMARK(BM_EcsAccessTypeidMap);
+
+/**
+ * @brief Per-entity getComponent with storages indexed by component id.
+ */
+void BM_EcsAccessGetComponent(Bench::State &state)
+{
+    ECS ecs;
+    std::vector<Entity> scene = makeScene(ecs);
+    while (state.keepRunning())
+    {
+        for (Entity e : scene)
+        {
+            auto &pos = ecs.getComponent<BenchPosition>(e);
+            auto &vel = ecs.getComponent<BenchVelocity>(e);
+            pos.x += vel.vx;
+        }
+    }
+    Bench::doNotOptimize(ecs.getAllComponents<BenchPosition>().data());
+    state.setItemsProcessed(state.iterations() * kSceneEntities);
+}
+RTYPE_BENCHMARK(BM_EcsAccessGetComponent);
+
+/**
+ * @brief Per-entity access through a view resolved once per pass.
+ */
+void BM_EcsAccessView(Bench::State &state)
+{
+    ECS ecs;
+    std::vector<Entity> scene = makeScene(ecs);
+    while (state.keepRunning())
+    {
+        auto view = ecs.view<BenchPosition, BenchVelocity>();
+        for (Entity e : scene)
+            view.get<BenchPosition>(e).x += view.get<BenchVelocity>(e).vx;
+    }
+    Bench::doNotOptimize(ecs.getAllComponents<BenchPosition>().data());
+    state.setItemsProcessed(state.iterations() * kSceneEntities);
+}
+RTYPE_BENCHMARK(BM_EcsAccessView);
+
+/**
+ * @brief Client-side entity pools, as GraphicClient drives them (its raylib components replaced by BenchRect).
+ *
+ * Spawns and releases follow createBulletEntity/createMonsterEntity and syncBullets/syncMonsters
+ * with the client's own Position, Velocity, PreviousPosition and MonsterKind components.
+ */
+struct ClientPools
+{
+    ECS ecs;
+    EntityPool<Position> bulletPool;
+    std::unordered_map<uint8_t, EntityPool<Position>> monsterPools;
+
+    Entity spawnBullet(float x, float y, float vx, float vy)
+    {
+        Entity e = bulletPool.acquire(ecs, Position{x, y});
+        if (e != INVALID_ENTITY)
+        {
+            ecs.getComponent<Velocity>(e) = Velocity{vx, vy};
+            ecs.getComponent<PreviousPosition>(e) = PreviousPosition{x, y};
+            return e;
+        }
+        e = ecs.createEntity();
+        ecs.addComponent(e, Position{x, y});
+        ecs.addComponent(e, Velocity{vx, vy});
+        ecs.addComponent(e, BenchRect{});
+        ecs.addComponent(e, PreviousPosition{x, y});
+        return e;
+    }
+
+    Entity spawnMonster(float x, float y, uint8_t type)
+    {
+        Entity e = monsterPools[type].acquire(ecs, Position{x, y});
+        if (e != INVALID_ENTITY)
+        {
+            if (ecs.getComponent<MonsterKind>(e).type != type)
+            {
+                std::fprintf(stderr, "EntityPool: monster of type %u reused as type %u\n",
+                             static_cast<unsigned>(ecs.getComponent<MonsterKind>(e).type),
+                             static_cast<unsigned>(type));
+                std::abort();
+            }
+            ecs.getComponent<PreviousPosition>(e) = PreviousPosition{x, y};
+            return e;
+        }
+        e = ecs.createEntity();
+        ecs.addComponent(e, Position{x, y});
+        ecs.addComponent(e, Velocity{0, 0});
+        ecs.addComponent(e, PreviousPosition{x, y});
+        ecs.addComponent(e, MonsterKind{type});
+        ecs.addComponent(e, BenchRect{});
+        return e;
+    }
+
+    void releaseBullet(Entity e)
+    {
+        bulletPool.release(ecs, e);
+    }
+
+    void releaseMonster(Entity e)
+    {
+        monsterPools[ecs.getComponent<MonsterKind>(e).type].release(ecs, e);
+    }
+
+    /**
+     * @brief Largest of the live entity count and every component storage.
+     */
+    std::size_t footprint()
+    {
+        std::size_t parked = bulletPool.size();
+        for (const auto &kv : monsterPools)
+            parked += kv.second.size();
+        return std::max({ecs.aliveCount(), ecs.getAllComponents<Position>().size() + parked,
+                         ecs.getAllComponents<Velocity>().size(), ecs.getAllComponents<PreviousPosition>().size(),
+                         ecs.getAllComponents<MonsterKind>().size(), ecs.getAllComponents<BenchRect>().size()});
+    }
+};
+
+/**
+ * @brief Soak of the client bullet and monster lifecycle: arg(0) frames of snapshot sync with pooled reuse.
+ *
+ * Every frame 40 bullets and 2 monsters leave the snapshot and new ones arrive with server ids
+ * wrapping at 16 bits. The monster mix between three kinds shifts every 10 s, so each per-type
+ * pool both fills and drains. The default 216000 frames is an hour at
+ * 60 FPS. Aborts if the entity or storage footprint grows past its peak of the first minute,
+ * or if a pooled monster comes back with another type.
+ */
+void BM_EcsPooledEntitySoak(Bench::State &state)
+{
+    const long long frames = state.arg(0);
+    constexpr int kBulletsPerFrame = 40;
+    constexpr int kBulletLifetime = 90;
+    constexpr int kMonstersPerFrame = 2;
+    constexpr int kMonsterLifetime = 300;
+    constexpr long long kWarmFrames = 3600;
+    while (state.keepRunning())
+    {
+        ClientPools client;
+        std::unordered_map<int, Entity> bullets;
+        std::unordered_map<int, Entity> monsters;
+        uint16_t nextBullet = 0;
+        uint16_t nextMonster = 0;
+        std::size_t warmPeak = 0;
+        std::size_t peak = 0;
+        auto expire = [](std::unordered_map<int, Entity> &live, uint16_t first, int count, auto release) {
+            for (int i = 0; i < count; ++i)
+            {
+                auto it = live.find(static_cast<uint16_t>(first + i));
+                if (it == live.end())
+                    continue;
+                release(it->second);
+                live.erase(it);
+            }
+        };
+        for (long long frame = 0; frame < frames; ++frame)
+        {
+            // Entities spawned a lifetime ago leave the snapshot.
+            if (frame >= kBulletLifetime)
+                expire(bullets, static_cast<uint16_t>(nextBullet - kBulletsPerFrame * kBulletLifetime),
+                       kBulletsPerFrame, [&client](Entity e) { client.releaseBullet(e); });
+            if (frame >= kMonsterLifetime)
+                expire(monsters, static_cast<uint16_t>(nextMonster - kMonstersPerFrame * kMonsterLifetime),
+                       kMonstersPerFrame, [&client](Entity e) { client.releaseMonster(e); });
+            for (int i = 0; i < kBulletsPerFrame; ++i)
+            {
+                float x = static_cast<float>(i);
+                bullets[nextBullet++] = client.spawnBullet(x, x, 2, 0);
+            }
+            // One monster of this 10 s phase's kind, one of the two others in turn.
+            int phase = static_cast<int>(frame / 600 % 3);
+            for (int i = 0; i < kMonstersPerFrame; ++i)
+            {
+                int kind = i == 0 ? phase : (phase + 1 + static_cast<int>(frame % 2)) % 3;
+                monsters[nextMonster++] = client.spawnMonster(200, static_cast<float>(i * 50),
+                                                              static_cast<uint8_t>(1 + kind));
+            }
+            peak = std::max(peak, client.footprint());
+            if (frame + 1 == kWarmFrames)
+                warmPeak = peak;
+        }
+        if (frames > kWarmFrames && peak > warmPeak)
+        {
+            std::fprintf(stderr, "BM_EcsPooledEntitySoak: footprint grew from %zu to %zu\n", warmPeak, peak);
+            std::abort();
+        }
+        Bench::doNotOptimize(bullets.size() + monsters.size());
+    }
+    state.setItemsProcessed(state.iterations() * static_cast<uint64_t>(frames));
+}
+RTYPE_BENCHMARK(BM_EcsPooledEntitySoak, {{216000}});
+} // namespace
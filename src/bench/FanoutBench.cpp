@@ -0,0 +1,64 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** TCP broadcast fan-out benchmarks
+*/
+
+#include "../Network/TransportLayer/Protocol.hpp"
+#include "Bench.hpp"
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace
+{
+Packet chatPacket()
+{
+    std::string msg = "CHAT:Player42: gg everyone, boss is down in 3 2 1";
+    return Packet(PacketType::MESSAGE, std::vector<uint8_t>(msg.begin(), msg.end()));
+}
+
+/**
+ * @brief One frameTcp() per recipient, as sendPacket(fd, packet) used to do.
+ */
+void BM_FanoutFramePerRecipient(Bench::State &state)
+{
+    const std::size_t recipients = static_cast<std::size_t>(state.arg(0));
+    Packet packet = chatPacket();
+    std::vector<std::deque<std::vector<uint8_t>>> queues(recipients);
+    while (state.keepRunning())
+    {
+        for (auto &q : queues)
+            q.push_back(Protocol::frameTcp(packet));
+        state.pauseTiming();
+        for (auto &q : queues)
+            q.clear();
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(state.iterations() * recipients);
+}
+RTYPE_BENCHMARK(BM_FanoutFramePerRecipient, {{4}, {64}, {500}});
+
+/**
+ * @brief One shared frame per broadcast, referenced by every recipient queue.
+ */
+void BM_FanoutSharedFrame(Bench::State &state)
+{
+    const std::size_t recipients = static_cast<std::size_t>(state.arg(0));
+    Packet packet = chatPacket();
+    std::vector<std::deque<Protocol::Frame>> queues(recipients);
+    while (state.keepRunning())
+    {
+        Protocol::Frame frame = Protocol::encodeFrame(packet);
+        for (auto &q : queues)
+            q.push_back(frame);
+        state.pauseTiming();
+        for (auto &q : queues)
+            q.clear();
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(state.iterations() * recipients);
+}
+RTYPE_BENCHMARK(BM_FanoutSharedFrame, {{4}, {64}, {500}});
+} // namespace
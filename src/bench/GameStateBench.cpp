@@ -0,0 +1,62 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Client game state benchmarks
+*/
+
+#include "../Network/Client/GameState.hpp"
+#include "Bench.hpp"
+
+namespace
+{
+constexpr int kLocalId = 3;
+
+/**
+ * @brief Per-frame snapshot apply: clear, upsert 4 players and arg(0) monsters, then check the local player.
+ */
+void BM_GameStateApplySnapshot(Bench::State &state)
+{
+    GameState gs;
+    gs.setLocalPlayerId(kLocalId);
+    const long long monsters = state.arg(0);
+    uint8_t frame = 0;
+    int alive = 0;
+    while (state.keepRunning())
+    {
+        gs.clear();
+        for (int id = 1; id <= 4; ++id)
+            gs.upsertPlayer(id, frame, 40, 3, frame);
+        for (long long m = 0; m < monsters; ++m)
+            gs.upsertMonster(static_cast<int>(m * 17 % 4096), 200, frame, 5, 1);
+        const PlayerState *me = gs.localPlayer();
+        alive += me && me->hp > 0;
+        ++frame;
+    }
+    Bench::doNotOptimize(alive);
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_GameStateApplySnapshot, {{8}, {64}});
+
+/**
+ * @brief HUD lookup of the local player's HP and score, done every rendered frame.
+ */
+void BM_GameStateLocalPlayer(Bench::State &state)
+{
+    GameState gs;
+    gs.setLocalPlayerId(kLocalId);
+    for (int id = 1; id <= 4; ++id)
+        gs.upsertPlayer(id, 10, 40, 3, 100);
+    unsigned total = 0;
+    while (state.keepRunning())
+    {
+        const PlayerState *me = gs.localPlayer();
+        if (me)
+            total += me->hp + me->score;
+        Bench::doNotOptimize(me);
+    }
+    Bench::doNotOptimize(total);
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_GameStateLocalPlayer);
+} // namespace
@@ -0,0 +1,122 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Server simulation benchmarks
+*/
+
+#include "../Log/Logger.hpp"
+#include "../Network/TransportLayer/UDP/GameWorld.hpp"
+#include "Bench.hpp"
+#include <iostream>
+
+namespace
+{
+constexpr long long kTickMs = 32;
+
+/**
+ * @brief Mutes std::cout/std::cerr and the logger while alive (boss spawns are logged).
+ */
+class QuietStreams
+{
+  public:
+    QuietStreams() : _out(std::cout.rdbuf(nullptr)), _err(std::cerr.rdbuf(nullptr)), _level(Log::level())
+    {
+        Log::setLevel(Log::Level::Off);
+    }
+    ~QuietStreams()
+    {
+        Log::setLevel(_level);
+        std::cout.rdbuf(_out);
+        std::cerr.rdbuf(_err);
+        std::cout.clear();
+        std::cerr.clear();
+    }
+
+  private:
+    std::streambuf *_out;
+    std::streambuf *_err;
+    Log::Level _level;
+};
+
+/**
+ * @brief World with arg(0) players and arg(1) player bullets in flight.
+ *
+ * Ten simulated seconds run before the shots are added so a few monsters are on screen.
+ * The world is seeded, so every run simulates the same monsters.
+ */
+GameWorld makeWorld(const Bench::State &state, long long &nowMs)
+{
+    const int players = static_cast<int>(state.arg(0));
+    const int bullets = static_cast<int>(state.arg(1));
+    GameWorld world(1);
+    sockaddr_in addr{};
+    for (int id = 1; id <= players; ++id)
+        world.registerPlayer(id, static_cast<uint8_t>(id * 7), static_cast<uint8_t>(id * 37), addr);
+    nowMs = 0;
+    for (int i = 0; i < 10000 / kTickMs; ++i)
+    {
+        nowMs += kTickMs;
+        world.tick(nowMs, kTickMs);
+    }
+    for (int i = 0; i < bullets; ++i)
+        world.addShot(1 + i % players, static_cast<uint8_t>(10 + (i * 7) % 200), static_cast<uint8_t>((i * 13) % 256),
+                      2, 0);
+    return world;
+}
+
+/**
+ * @brief One GameWorld::tick() from the same starting state (the world is restored untimed).
+ */
+void BM_GameWorldTick(Bench::State &state)
+{
+    QuietStreams quiet;
+    long long nowMs = 0;
+    const GameWorld initial = makeWorld(state, nowMs);
+    GameWorld world = initial;
+    while (state.keepRunning())
+    {
+        state.pauseTiming();
+        world = initial;
+        state.resumeTiming();
+        world.tick(nowMs + kTickMs, kTickMs);
+    }
+    Bench::doNotOptimize(world.players().size());
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_GameWorldTick, {{4, 16}, {4, 128}, {32, 250}});
+
+/**
+ * @brief GameWorld::buildSnapshotPacket() for the same worlds, run once per tick per lobby.
+ */
+void BM_GameWorldBuildSnapshot(Bench::State &state)
+{
+    QuietStreams quiet;
+    long long nowMs = 0;
+    GameWorld world = makeWorld(state, nowMs);
+    while (state.keepRunning())
+    {
+        Packet snapshot = world.buildSnapshotPacket();
+        Bench::doNotOptimize(snapshot.payload.data());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_GameWorldBuildSnapshot, {{4, 16}, {4, 128}, {32, 250}});
+
+/**
+ * @brief Cost of one RTYPE_PROFILE_SCOPE in an RTYPE_PROFILING build; arg(0) = 1 also keeps trace events.
+ */
+void BM_ProfilerScopedTimer(Bench::State &state)
+{
+    Metrics::Profiler profiler;
+    if (state.arg(0))
+        profiler.enableTrace();
+    const std::size_t id = Metrics::Profiler::sectionId("bench.scope");
+    while (state.keepRunning())
+    {
+        Metrics::ScopedTimer timer(&profiler, id);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_ProfilerScopedTimer, {{0}, {1}});
+} // namespace
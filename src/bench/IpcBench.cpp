@@ -0,0 +1,167 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Parent/child IPC benchmarks
+*/
+
+#include "../server/IpcChannel.hpp"
+#include "Bench.hpp"
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+#ifndef _WIN32
+/**
+ * @brief Former transport: one loopback UDP socket pair per lobby carrying ASCII messages.
+ */
+struct UdpTextLink
+{
+    socket_t parent = INVALID_SOCKET_FD;
+    socket_t child = INVALID_SOCKET_FD;
+    sockaddr_in parentAddr{};
+
+    UdpTextLink()
+    {
+        parent = socket(AF_INET, SOCK_DGRAM, 0);
+        child = socket(AF_INET, SOCK_DGRAM, 0);
+        parentAddr.sin_family = AF_INET;
+        parentAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ::bind(parent, reinterpret_cast<sockaddr *>(&parentAddr), sizeof(parentAddr));
+        socklen_t len = sizeof(parentAddr);
+        getsockname(parent, reinterpret_cast<sockaddr *>(&parentAddr), &len);
+    }
+    ~UdpTextLink()
+    {
+        CLOSE(parent);
+        CLOSE(child);
+    }
+
+    bool readable() const
+    {
+        fd_set rfds;
+        FD_ZERO(&rfds);
+        FD_SET(parent, &rfds);
+        timeval tv{0, 0};
+        return select(parent + 1, &rfds, nullptr, nullptr, &tv) > 0;
+    }
+};
+
+/**
+ * @brief One 1 ms child loop per lobby with the former protocol: "RUNNING" every iteration,
+ * the parent draining each channel with select+recv and prefix matching.
+ */
+void BM_IpcUdpTextTick(Bench::State &state)
+{
+    const std::size_t lobbies = static_cast<std::size_t>(state.arg(0));
+    std::vector<std::unique_ptr<UdpTextLink>> links;
+    for (std::size_t i = 0; i < lobbies; ++i)
+        links.push_back(std::make_unique<UdpTextLink>());
+    const std::string running = "RUNNING";
+    uint64_t handled = 0;
+    while (state.keepRunning())
+    {
+        for (auto &l : links)
+            ::sendto(l->child, running.data(), running.size(), 0,
+                     reinterpret_cast<const sockaddr *>(&l->parentAddr), sizeof(l->parentAddr));
+        for (auto &l : links)
+        {
+            while (l->readable())
+            {
+                char buf[1025];
+                ssize_t n = ::recv(l->parent, buf, 1024, 0);
+                if (n <= 0)
+                    break;
+                std::string msg(buf, buf + n);
+                bool known = msg.rfind("BOSS_DEAD:", 0) == 0 || msg.rfind("NO_PLAYERS:", 0) == 0 ||
+                             msg.rfind("BOSS:", 0) == 0 || msg.rfind("DEAD:", 0) == 0;
+                Bench::doNotOptimize(known);
+                ++handled;
+            }
+        }
+    }
+    state.setItemsProcessed(handled);
+}
+RTYPE_BENCHMARK(BM_IpcUdpTextTick, {{100}});
+#endif
+
+struct RingLink
+{
+    IpcChannel parent;
+    IpcChannel child;
+
+    RingLink()
+    {
+        parent.bindServer();
+        child.connectClient(parent.endpoint());
+    }
+};
+
+/**
+ * @brief Cost of one typed message through the ring, per lobby (no rate limiting).
+ */
+void BM_IpcShmRingMessage(Bench::State &state)
+{
+    const std::size_t lobbies = static_cast<std::size_t>(state.arg(0));
+    std::vector<std::unique_ptr<RingLink>> links;
+    for (std::size_t i = 0; i < lobbies; ++i)
+        links.push_back(std::make_unique<RingLink>());
+    uint64_t handled = 0;
+    while (state.keepRunning())
+    {
+        for (auto &l : links)
+            l->child.send(IpcMessage::make(IpcType::Heartbeat, 4, "ABCDEF"));
+        for (auto &l : links)
+        {
+            while (auto msg = l->parent.recv(0))
+            {
+                Bench::doNotOptimize(msg->type);
+                ++handled;
+            }
+        }
+    }
+    state.setItemsProcessed(handled);
+}
+RTYPE_BENCHMARK(BM_IpcShmRingMessage, {{100}});
+
+/**
+ * @brief One 1 ms child loop per lobby with the current protocol: a 1 Hz heartbeat,
+ * the parent only touching the channels that were signalled.
+ */
+void BM_IpcShmRingTick(Bench::State &state)
+{
+    const std::size_t lobbies = static_cast<std::size_t>(state.arg(0));
+    std::vector<std::unique_ptr<RingLink>> links;
+    for (std::size_t i = 0; i < lobbies; ++i)
+        links.push_back(std::make_unique<RingLink>());
+    uint64_t tick = 0;
+    uint64_t handled = 0;
+    std::vector<RingLink *> signalled;
+    while (state.keepRunning())
+    {
+        signalled.clear();
+        for (std::size_t i = 0; i < lobbies; ++i)
+        {
+            if ((tick + i) % 1000 == 0)
+            {
+                links[i]->child.send(IpcMessage::make(IpcType::Heartbeat, 4, "ABCDEF"));
+                signalled.push_back(links[i].get()); // what select() on fd() reports
+            }
+        }
+        for (RingLink *l : signalled)
+        {
+            while (auto msg = l->parent.recv(0))
+            {
+                Bench::doNotOptimize(msg->type);
+                ++handled;
+            }
+        }
+        ++tick;
+    }
+    state.setItemsProcessed(handled);
+}
+RTYPE_BENCHMARK(BM_IpcShmRingTick, {{100}});
+} // namespace
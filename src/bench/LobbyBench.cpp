@@ -0,0 +1,116 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Lobby membership benchmarks
+*/
+
+#include "../Network/TransportLayer/TCP/LobbyIndex.hpp"
+#include "Bench.hpp"
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t kClients = 10000;
+constexpr std::size_t kLobbies = 2000;
+
+/**
+ * @brief Client layout before lobby interning: every slot carries its lobby code.
+ */
+struct LegacyClient
+{
+    int fd = -1;
+    std::string lobbyCode;
+};
+
+std::string lobbyCode(std::size_t i)
+{
+    return "L" + std::to_string(100000 + i);
+}
+
+std::vector<LegacyClient> makeLegacyClients()
+{
+    std::vector<LegacyClient> clients(kClients);
+    for (std::size_t i = 0; i < kClients; ++i)
+    {
+        clients[i].fd = static_cast<int>(i + 3);
+        clients[i].lobbyCode = lobbyCode(i % kLobbies);
+    }
+    return clients;
+}
+
+LobbyIndex makeIndex()
+{
+    LobbyIndex index;
+    for (std::size_t i = 0; i < kClients; ++i)
+        index.join(index.intern(lobbyCode(i % kLobbies)), i);
+    return index;
+}
+
+/**
+ * @brief Broadcast target collection with a linear scan over all clients.
+ */
+void BM_LobbyBroadcastLinearScan(Bench::State &state)
+{
+    auto clients = makeLegacyClients();
+    std::vector<std::string> codes;
+    for (std::size_t i = 0; i < kLobbies; ++i)
+        codes.push_back(lobbyCode(i));
+    std::size_t l = 0;
+    uint64_t sent = 0;
+    while (state.keepRunning())
+    {
+        const std::string &code = codes[l++ % kLobbies];
+        for (const auto &c : clients)
+        {
+            if (c.fd >= 0 && c.lobbyCode == code)
+            {
+                Bench::doNotOptimize(c.fd);
+                ++sent;
+            }
+        }
+    }
+    state.setItemsProcessed(sent);
+}
+RTYPE_BENCHMARK(BM_LobbyBroadcastLinearScan);
+
+/**
+ * @brief Broadcast target collection through the lobby member index.
+ */
+void BM_LobbyBroadcastIndexed(Bench::State &state)
+{
+    auto clients = makeLegacyClients();
+    LobbyIndex index = makeIndex();
+    LobbyIndex::LobbyId l = 0;
+    uint64_t sent = 0;
+    while (state.keepRunning())
+    {
+        for (std::size_t slot : index.members(l++ % kLobbies))
+        {
+            Bench::doNotOptimize(clients[slot].fd);
+            ++sent;
+        }
+    }
+    state.setItemsProcessed(sent);
+}
+RTYPE_BENCHMARK(BM_LobbyBroadcastIndexed);
+
+/**
+ * @brief Clients hopping between lobbies (join implies leave).
+ */
+void BM_LobbyJoinLeaveChurn(Bench::State &state)
+{
+    LobbyIndex index = makeIndex();
+    std::size_t slot = 0;
+    LobbyIndex::LobbyId target = 0;
+    while (state.keepRunning())
+    {
+        index.join(target, slot);
+        slot = (slot + 7919) % kClients;
+        target = (target + 13) % kLobbies;
+    }
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_LobbyJoinLeaveChurn);
+} // namespace
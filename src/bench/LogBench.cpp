@@ -0,0 +1,90 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Logging cost on the game server hot path
+*/
+
+#include "../Log/Logger.hpp"
+#include "Bench.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+#ifdef _WIN32
+constexpr const char *kNullDevice = "NUL";
+#else
+constexpr const char *kNullDevice = "/dev/null";
+#endif
+
+/**
+ * @brief Logger writing to the null device for the lifetime of a benchmark.
+ */
+class NullLogger
+{
+  public:
+    explicit NullLogger(uint32_t rateLimit) : _sink(std::fopen(kNullDevice, "w"))
+    {
+        Log::setRateLimit(rateLimit);
+        Log::start(_sink, _sink);
+    }
+    ~NullLogger()
+    {
+        Log::shutdown();
+        Log::setRateLimit(20);
+        std::fclose(_sink);
+    }
+
+  private:
+    FILE *_sink;
+};
+
+/**
+ * @brief The old path: prefix rebuilt with an ostringstream, line streamed and flushed with std::endl.
+ */
+void BM_LogIostreamLine(Bench::State &state)
+{
+    std::ofstream out(kNullDevice);
+    int id = 0;
+    while (state.keepRunning())
+    {
+        std::ostringstream prefix;
+        prefix << "[UDP lobby=ABCD1234 port=4300 tid=" << std::this_thread::get_id() << "] ";
+        out << prefix.str() << "Player " << 7 << " fired bullet " << ++id << " from " << 30 << "," << 120
+            << " vel " << 6 << "," << 0 << std::endl;
+    }
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_LogIostreamLine);
+
+/**
+ * @brief Same line through the async logger with a cached prefix and no rate limit: format + enqueue.
+ */
+void BM_LogAsyncLine(Bench::State &state)
+{
+    NullLogger logger(0);
+    const std::string prefix = "[UDP lobby=ABCD1234 port=4300 tid=140245] ";
+    int id = 0;
+    while (state.keepRunning())
+        RTYPE_LOG_INFO("%sPlayer %d fired bullet %d from %d,%d vel %d,%d", prefix.c_str(), 7, ++id, 30, 120, 6, 0);
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_LogAsyncLine);
+
+/**
+ * @brief A call site over its per-second budget: only the rate limiter runs.
+ */
+void BM_LogRateLimitedLine(Bench::State &state)
+{
+    NullLogger logger(20);
+    const std::string prefix = "[UDP lobby=ABCD1234 port=4300 tid=140245] ";
+    int id = 0;
+    while (state.keepRunning())
+        RTYPE_LOG_WARN("%sFailed to parse packet: %d", prefix.c_str(), ++id);
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_LogRateLimitedLine);
+} // namespace
@@ -0,0 +1,201 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Packet encoding and TCP framing benchmarks
+*/
+
+#include "../Network/TransportLayer/Protocol.hpp"
+#include "Bench.hpp"
+#include <vector>
+
+namespace
+{
+Packet makePacket(std::size_t payloadSize)
+{
+    std::vector<uint8_t> payload(payloadSize);
+    for (std::size_t i = 0; i < payloadSize; ++i)
+        payload[i] = static_cast<uint8_t>(i * 31);
+    return Packet(PacketType::SNAPSHOT, payload);
+}
+
+/**
+ * @brief Packet::serialize() of an arg(0)-byte payload, as every UDP send does.
+ */
+void BM_PacketSerialize(Bench::State &state)
+{
+    Packet packet = makePacket(static_cast<std::size_t>(state.arg(0)));
+    while (state.keepRunning())
+    {
+        std::vector<uint8_t> bytes = packet.serialize();
+        Bench::doNotOptimize(bytes.data());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_PacketSerialize, {{8}, {64}, {250}});
+
+/**
+ * @brief Packet::deserialize() of an arg(0)-byte payload, as every UDP receive does.
+ */
+void BM_PacketDeserialize(Bench::State &state)
+{
+    std::vector<uint8_t> bytes = makePacket(static_cast<std::size_t>(state.arg(0))).serialize();
+    while (state.keepRunning())
+    {
+        Packet packet = Packet::deserialize(bytes.data(), bytes.size());
+        Bench::doNotOptimize(packet.payload.data());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_PacketDeserialize, {{8}, {64}, {250}});
+
+/**
+ * @brief A hostile datagram: arg(0) 0 = shorter than a header, 1 = bad magic, 2 = size field past the end.
+ */
+std::vector<uint8_t> malformedDatagram(int64_t kind)
+{
+    std::vector<uint8_t> bytes = makePacket(64).serialize();
+    if (kind == 0)
+        bytes.resize(3);
+    else if (kind == 1)
+        bytes[0] = 0x00;
+    else
+        bytes.resize(40);
+    return bytes;
+}
+
+/**
+ * @brief Rejecting a malformed datagram with Packet::deserialize() and a catch, as the game server used to.
+ */
+void BM_PacketRejectThrow(Bench::State &state)
+{
+    std::vector<uint8_t> bytes = malformedDatagram(state.arg(0));
+    std::size_t rejected = 0;
+    while (state.keepRunning())
+    {
+        try
+        {
+            Packet packet = Packet::deserialize(bytes.data(), bytes.size());
+            Bench::doNotOptimize(packet.payload.data());
+        }
+        catch (const std::exception &)
+        {
+            ++rejected;
+        }
+    }
+    Bench::doNotOptimize(rejected);
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_PacketRejectThrow, {{0}, {1}, {2}});
+
+/**
+ * @brief Same datagrams rejected by Packet::tryDeserialize().
+ */
+void BM_PacketRejectStatus(Bench::State &state)
+{
+    std::vector<uint8_t> bytes = malformedDatagram(state.arg(0));
+    Packet packet;
+    std::size_t rejected = 0;
+    while (state.keepRunning())
+        rejected += Packet::tryDeserialize(bytes.data(), bytes.size(), packet) != ParseStatus::Ok;
+    Bench::doNotOptimize(rejected);
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_PacketRejectStatus, {{0}, {1}, {2}});
+
+/**
+ * @brief Packet::tryDeserialize() of a valid arg(0)-byte payload into a reused Packet.
+ */
+void BM_PacketTryDeserialize(Bench::State &state)
+{
+    std::vector<uint8_t> bytes = makePacket(static_cast<std::size_t>(state.arg(0))).serialize();
+    Packet packet;
+    while (state.keepRunning())
+    {
+        ParseStatus status = Packet::tryDeserialize(bytes.data(), bytes.size(), packet);
+        Bench::doNotOptimize(status);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_PacketTryDeserialize, {{8}, {64}, {250}});
+
+/**
+ * @brief Protocol::frameTcp() of an arg(0)-byte payload.
+ */
+void BM_ProtocolFrameTcp(Bench::State &state)
+{
+    Packet packet = makePacket(static_cast<std::size_t>(state.arg(0)));
+    while (state.keepRunning())
+    {
+        std::vector<uint8_t> framed = Protocol::frameTcp(packet);
+        Bench::doNotOptimize(framed.data());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+RTYPE_BENCHMARK(BM_ProtocolFrameTcp, {{8}, {64}, {250}});
+
+/**
+ * @brief One recv() burst of arg(0) framed 32-byte packets fed through consumeChunk/extractFromBuffer.
+ */
+void BM_ProtocolExtractBurst(Bench::State &state)
+{
+    const std::size_t packets = static_cast<std::size_t>(state.arg(0));
+    std::vector<uint8_t> burst;
+    for (std::size_t i = 0; i < packets; ++i)
+    {
+        std::vector<uint8_t> framed = Protocol::frameTcp(makePacket(32));
+        burst.insert(burst.end(), framed.begin(), framed.end());
+    }
+    std::vector<uint8_t> recvBuffer;
+    Packet out;
+    while (state.keepRunning())
+    {
+        std::size_t extracted = 0;
+        auto status = Protocol::consumeChunk(burst.data(), burst.size(), recvBuffer, out);
+        while (status == Protocol::StreamStatus::Ok)
+        {
+            ++extracted;
+            status = Protocol::extractFromBuffer(recvBuffer, out);
+        }
+        Bench::doNotOptimize(extracted);
+    }
+    state.setItemsProcessed(state.iterations() * packets);
+}
+RTYPE_BENCHMARK(BM_ProtocolExtractBurst, {{1}, {16}, {128}});
+
+/**
+ * @brief A recv() burst of 128 frames, arg(0) percent of them malformed (bad magic), through extractFromBuffer.
+ *
+ * Items are frames, so items/s is the rate a hostile client can be rejected at.
+ */
+void BM_ProtocolExtractMalformed(Bench::State &state)
+{
+    const std::size_t frames = 128;
+    const std::size_t badPct = static_cast<std::size_t>(state.arg(0));
+    std::vector<uint8_t> burst;
+    for (std::size_t i = 0; i < frames; ++i)
+    {
+        std::vector<uint8_t> framed = Protocol::frameTcp(makePacket(32));
+        if (i * 100 / frames < badPct)
+            framed[2] = 0x00;
+        burst.insert(burst.end(), framed.begin(), framed.end());
+    }
+    std::vector<uint8_t> recvBuffer;
+    Packet out;
+    std::size_t malformed = 0;
+    while (state.keepRunning())
+    {
+        std::size_t extracted = 0;
+        auto status = Protocol::consumeChunk(burst.data(), burst.size(), recvBuffer, out, &malformed);
+        while (status == Protocol::StreamStatus::Ok)
+        {
+            ++extracted;
+            status = Protocol::extractFromBuffer(recvBuffer, out, &malformed);
+        }
+        Bench::doNotOptimize(extracted);
+    }
+    Bench::doNotOptimize(malformed);
+    state.setItemsProcessed(state.iterations() * frames);
+}
+RTYPE_BENCHMARK(BM_ProtocolExtractMalformed, {{0}, {50}, {100}});
+} // namespace
@@ -0,0 +1,159 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Client snapshot decoding benchmarks
+*/
+
+#include "../Network/Client/SnapshotDecoder.hpp"
+#include "../Network/TransportLayer/Packet.hpp"
+#include "Bench.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t kSnapshots = 10000;
+
+/**
+ * @brief 10k SNAPSHOT datagrams as a 4-player game sends them, sizes varying with the action.
+ *
+ * Every tenth one uses the compact 5-byte player layout so the fallback path is exercised too.
+ */
+std::vector<std::vector<uint8_t>> makeDatagrams()
+{
+    std::vector<std::vector<uint8_t>> datagrams;
+    datagrams.reserve(kSnapshots);
+    for (std::size_t i = 0; i < kSnapshots; ++i)
+    {
+        bool compact = i % 10 == 0;
+        std::size_t players = 1 + i % 4;
+        std::size_t monsters = i % 8;
+        std::size_t perPlayer = compact ? 5 : 7;
+        std::size_t fixed = 1 + players * perPlayer + 1 + 1 + monsters * 6 + 2;
+        std::size_t bullets = (i * 7) % ((UINT8_MAX - fixed) / 6 + 1);
+
+        std::vector<uint8_t> payload;
+        payload.push_back(static_cast<uint8_t>(players));
+        for (std::size_t p = 0; p < players; ++p)
+        {
+            payload.insert(payload.end(), {0, static_cast<uint8_t>(p + 1), static_cast<uint8_t>(i), 40, 3});
+            if (!compact)
+                payload.insert(payload.end(), {static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i)});
+        }
+        payload.push_back(static_cast<uint8_t>(bullets));
+        for (std::size_t b = 0; b < bullets; ++b)
+            payload.insert(payload.end(), {static_cast<uint8_t>(b >> 8), static_cast<uint8_t>(b),
+                                           static_cast<uint8_t>(b * 3), 50, 2, 0});
+        payload.push_back(static_cast<uint8_t>(monsters));
+        for (std::size_t m = 0; m < monsters; ++m)
+            payload.insert(payload.end(), {0, static_cast<uint8_t>(m), 200, static_cast<uint8_t>(m * 9), 5,
+                                           static_cast<uint8_t>(m % 3)});
+        if (!compact)
+            payload.insert(payload.end(), {static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i)});
+        datagrams.push_back(Packet(PacketType::SNAPSHOT, payload).serialize());
+    }
+    return datagrams;
+}
+
+/**
+ * @brief Former NetworkClient path: Packet copy, fresh vectors, and a full re-parse on layout mismatch.
+ */
+bool legacyParse(const Packet &p, std::size_t perPlayer, std::vector<PlayerState> &players,
+                 std::vector<BulletState> &bullets, std::vector<MonsterState> &monsters)
+{
+    std::size_t off = 1 + p.payload[0] * perPlayer;
+    if (p.payload.size() < off)
+        return false;
+    for (std::size_t i = 0; i < p.payload[0]; ++i)
+    {
+        std::size_t idx = 1 + i * perPlayer;
+        uint16_t score = perPlayer == 7 ? (p.payload[idx + 5] << 8) | p.payload[idx + 6] : 0;
+        players.push_back({(p.payload[idx] << 8) | p.payload[idx + 1], p.payload[idx + 2], p.payload[idx + 3],
+                           p.payload[idx + 4], score});
+    }
+    if (off >= p.payload.size())
+        return true;
+    uint8_t bulletCount = p.payload[off++];
+    if (p.payload.size() < off + bulletCount * 6)
+        return false;
+    for (std::size_t i = 0; i < bulletCount; ++i, off += 6)
+        bullets.push_back({(p.payload[off] << 8) | p.payload[off + 1], p.payload[off + 2], p.payload[off + 3],
+                           static_cast<int8_t>(p.payload[off + 4]), static_cast<int8_t>(p.payload[off + 5])});
+    if (off >= p.payload.size())
+        return true;
+    uint8_t monsterCount = p.payload[off++];
+    if (p.payload.size() < off + monsterCount * 6)
+        return false;
+    for (std::size_t i = 0; i < monsterCount; ++i, off += 6)
+        monsters.push_back({(p.payload[off] << 8) | p.payload[off + 1], p.payload[off + 2], p.payload[off + 3],
+                            p.payload[off + 4], p.payload[off + 5]});
+    return true;
+}
+
+/**
+ * @brief Decode 10k snapshots the way NetworkClient used to.
+ */
+void BM_SnapshotDecodeLegacy(Bench::State &state)
+{
+    auto datagrams = makeDatagrams();
+    std::size_t entities = 0;
+    while (state.keepRunning())
+    {
+        for (const auto &datagram : datagrams)
+        {
+            Packet p = Packet::deserialize(datagram.data(), datagram.size());
+            std::vector<PlayerState> players;
+            std::vector<BulletState> bullets;
+            std::vector<MonsterState> monsters;
+            if (!legacyParse(p, 7, players, bullets, monsters))
+            {
+                players.clear();
+                bullets.clear();
+                monsters.clear();
+                legacyParse(p, 5, players, bullets, monsters);
+            }
+            entities += players.size() + bullets.size() + monsters.size();
+        }
+    }
+    Bench::doNotOptimize(entities);
+    state.setItemsProcessed(state.iterations() * kSnapshots);
+}
+RTYPE_BENCHMARK(BM_SnapshotDecodeLegacy);
+
+/**
+ * @brief Decode 10k snapshots in place into one reused slot, as the receive path does now.
+ *
+ * Aborts if the slot's vectors reallocate after the first snapshot, i.e. if decoding allocates.
+ */
+void BM_SnapshotDecode(Bench::State &state)
+{
+    auto datagrams = makeDatagrams();
+    Snapshot snap;
+    const PlayerState *players = snap.players.data();
+    const BulletState *bullets = snap.bullets.data();
+    const MonsterState *monsters = snap.monsters.data();
+    std::size_t entities = 0;
+    while (state.keepRunning())
+    {
+        for (const auto &datagram : datagrams)
+        {
+            if (!SnapshotDecoder::decode(datagram.data() + 4, datagram[3], snap))
+            {
+                std::fprintf(stderr, "BM_SnapshotDecode: valid snapshot rejected\n");
+                std::abort();
+            }
+            entities += snap.players.size() + snap.bullets.size() + snap.monsters.size();
+        }
+    }
+    if (snap.players.data() != players || snap.bullets.data() != bullets || snap.monsters.data() != monsters)
+    {
+        std::fprintf(stderr, "BM_SnapshotDecode: snapshot buffers were reallocated\n");
+        std::abort();
+    }
+    Bench::doNotOptimize(entities);
+    state.setItemsProcessed(state.iterations() * kSnapshots);
+}
+RTYPE_BENCHMARK(BM_SnapshotDecode);
+} // namespace
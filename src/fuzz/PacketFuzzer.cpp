@@ -0,0 +1,32 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Fuzz target: one UDP datagram through the packet and snapshot parsers
+*/
+
+#include "../Network/Client/SnapshotDecoder.hpp"
+#include "../Network/TransportLayer/Packet.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @brief What a game server and a client do with a datagram off the wire.
+ *
+ * A packet that parses must serialize back to the bytes it came from, and a SNAPSHOT
+ * payload goes through the client decoder.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static Packet packet;
+    static Snapshot snapshot;
+    if (Packet::tryDeserialize(data, size, packet) != ParseStatus::Ok)
+        return 0;
+    std::vector<uint8_t> bytes = packet.serialize();
+    if (bytes.size() > size || !std::equal(bytes.begin(), bytes.end(), data))
+        std::abort();
+    if (packet.type == PacketType::SNAPSHOT)
+        SnapshotDecoder::decode(packet.payload.data(), packet.payload.size(), snapshot);
+    return 0;
+}
@@ -0,0 +1,88 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Driver for the fuzz targets when libFuzzer is not available
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+namespace
+{
+bool runFile(const std::filesystem::path &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        return false;
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(bytes.data(), bytes.size());
+    return true;
+}
+
+/**
+ * @brief Random inputs, half of them starting with a valid header so the parsers get past the magic.
+ */
+void runRandom(long runs, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> bytes;
+    for (long i = 0; i < runs; ++i)
+    {
+        bytes.resize(rng() % 600);
+        for (auto &b : bytes)
+            b = static_cast<uint8_t>(rng());
+        if (i % 2 && bytes.size() >= 4)
+        {
+            bytes[0] = 0x52;
+            bytes[1] = 0x54;
+            bytes[3] = static_cast<uint8_t>(rng() % (bytes.size() - 3));
+        }
+        LLVMFuzzerTestOneInput(bytes.data(), bytes.size());
+    }
+}
+} // namespace
+
+/**
+ * @brief Replays the files and directories given (a libFuzzer corpus or crash files), or
+ * runs -runs=N random inputs (-seed=N) when none is given.
+ */
+int main(int argc, char **argv)
+{
+    long runs = 100000;
+    uint32_t seed = 1;
+    std::size_t files = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strncmp(argv[i], "-runs=", 6) == 0)
+            runs = std::atol(argv[i] + 6);
+        else if (std::strncmp(argv[i], "-seed=", 6) == 0)
+            seed = static_cast<uint32_t>(std::atol(argv[i] + 6));
+        else if (std::filesystem::is_directory(argv[i]))
+        {
+            for (const auto &entry : std::filesystem::directory_iterator(argv[i]))
+                files += entry.is_regular_file() && runFile(entry.path());
+        }
+        else if (runFile(argv[i]))
+            ++files;
+        else
+        {
+            std::fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (files == 0)
+        runRandom(runs, seed);
+    std::printf("%s: %zu files, %ld random inputs, no crash\n", argv[0], files, files ? 0L : runs);
+    return 0;
+}
@@ -0,0 +1,43 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Fuzz target: a TCP byte stream through the framing parser
+*/
+
+#include "../Network/TransportLayer/Protocol.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+/**
+ * @brief Feed the input to consumeChunk() in reads cut where the first byte says, as recv() would.
+ *
+ * Every extracted packet must be well formed, and the receive buffer must never hold a
+ * complete frame once extraction reports Incomplete.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    if (size == 0)
+        return 0;
+    const std::size_t chunk = 1 + data[0] % 64;
+    ++data;
+    --size;
+
+    std::vector<uint8_t> recvBuffer;
+    Packet packet;
+    std::size_t malformed = 0;
+    for (std::size_t pos = 0; pos < size; pos += chunk)
+    {
+        std::size_t len = std::min(chunk, size - pos);
+        auto status = Protocol::consumeChunk(data + pos, len, recvBuffer, packet, &malformed);
+        while (status == Protocol::StreamStatus::Ok)
+        {
+            if (packet.header != PACKET_MAGIC || packet.payload.size() != packet.size)
+                std::abort();
+            status = Protocol::extractFromBuffer(recvBuffer, packet, &malformed);
+        }
+        if (recvBuffer.size() >= 2 && recvBuffer.size() >= 2u + ((recvBuffer[0] << 8) | recvBuffer[1]))
+            std::abort();
+    }
+    return 0;
+}
@@ -57,11 +57,24 @@ class AnimatedSprite
      */
     AnimatedSprite(const std::string &path, Vector2 size, Vector2 posInSheet, int maxFrames, float frameTime = 0.1f,
                    Vector2 pos = {0, 0})
-        : _size(size), _positionInSpritesheet(posInSheet), _maxFrames(maxFrames), _frameTime(frameTime), _position(pos),
-          _timer(0.0f), _currentFrame(0)
+        : AnimatedSprite(std::make_shared<Raylib::Texture>(path), size, posInSheet, maxFrames, frameTime, pos)
     {
-        _texture = std::make_shared<Raylib::Texture>(path);
+    }
 
+    /**
+     * @brief Constructor for AnimatedSprite sharing an already loaded sprite sheet.
+     * @param texture Sprite sheet, typically obtained from a TextureCache.
+     * @param size Size of each frame (width, height).
+     * @param posInSheet Position of first frame in sprite sheet grid.
+     * @param maxFrames Total number of animation frames.
+     * @param frameTime Time in seconds each frame is displayed (default: 0.1).
+     * @param pos Initial screen position (default: 0, 0).
+     */
+    AnimatedSprite(std::shared_ptr<Raylib::Texture> texture, Vector2 size, Vector2 posInSheet, int maxFrames,
+                   float frameTime = 0.1f, Vector2 pos = {0, 0})
+        : _texture(std::move(texture)), _size(size), _positionInSpritesheet(posInSheet), _maxFrames(maxFrames),
+          _frameTime(frameTime), _timer(0.0f), _currentFrame(0), _position(pos)
+    {
         _sourceRect = {posInSheet.x * size.x, posInSheet.y * size.y, size.x, size.y};
     }
 
@@ -123,6 +136,25 @@ class AnimatedSprite
             _texture->draw(_sourceRect, dest, WHITE);
         }
     }
+
+    /**
+     * @brief Queues the current animation frame on a draw list instead of drawing it.
+     *
+     * Same placement as draw(); the quad is batched with every other sprite sharing the texture.
+     * @param list Frame draw list.
+     * @param layer Draw layer.
+     */
+    void queue(Raylib::DrawList &list, int layer = 0) const
+    {
+        if (!_texture)
+            return;
+        float w = _sourceRect.width * _scale.x;
+        float h = _sourceRect.height * _scale.y;
+        Raylib::Quad source{_sourceRect.x, _sourceRect.y, _sourceRect.width, _sourceRect.height};
+        Raylib::Quad dest{_position.x - w / 2.0f, _position.y - h / 2.0f, w, h};
+        list.sprite(_texture->getId(), _texture->getWidth(), _texture->getHeight(), source, dest, {255, 255, 255, 255},
+                    layer);
+    }
 };
 
 } // namespace Graphic
@@ -0,0 +1,72 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Shared texture cache
+*/
+
+#include "TextureCache.hpp"
+#include <chrono>
+#include <iostream>
+
+namespace Rtype
+{
+namespace Graphic
+{
+
+namespace
+{
+std::size_t textureBytes(const Raylib::Texture &texture)
+{
+    return static_cast<std::size_t>(texture.getWidth()) * static_cast<std::size_t>(texture.getHeight()) * 4;
+}
+} // namespace
+
+TextureCache::Handle TextureCache::acquire(const std::string &path)
+{
+    auto it = _textures.find(path);
+    if (it != _textures.end())
+    {
+        ++_stats.hits;
+        return it->second;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto texture = std::make_shared<Raylib::Texture>(path);
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    ++_stats.loads;
+    _stats.lastLoadUs = static_cast<uint64_t>(us);
+    _stats.totalLoadUs += static_cast<uint64_t>(us);
+    _stats.residentBytes += textureBytes(*texture);
+    _stats.residentCount = _textures.size() + 1;
+    std::cout << "[TEXTURE] Loaded " << path << " (" << texture->getWidth() << "x" << texture->getHeight() << ") in "
+              << us << " us, resident=" << _stats.residentCount << " textures " << _stats.residentBytes / 1024
+              << " KB\n";
+    _textures.emplace(path, texture);
+    return texture;
+}
+
+std::size_t TextureCache::trim()
+{
+    std::size_t unloaded = 0;
+    for (auto it = _textures.begin(); it != _textures.end();)
+    {
+        if (it->second.use_count() == 1)
+        {
+            _stats.residentBytes -= textureBytes(*it->second);
+            it = _textures.erase(it);
+            ++unloaded;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    _stats.evictions += unloaded;
+    _stats.residentCount = _textures.size();
+    return unloaded;
+}
+
+} // namespace Graphic
+} // namespace Rtype
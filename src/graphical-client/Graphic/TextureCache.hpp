@@ -0,0 +1,75 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Shared texture cache
+*/
+
+#pragma once
+#include "../Raylib/Raylib.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace Rtype
+{
+namespace Graphic
+{
+
+/**
+ * @struct TextureCacheStats
+ * @brief Load counters and GPU memory estimate of a TextureCache.
+ */
+struct TextureCacheStats
+{
+    uint64_t loads = 0;            /**< Textures read from disk and uploaded */
+    uint64_t hits = 0;             /**< acquire() calls served from the cache */
+    uint64_t evictions = 0;        /**< Textures unloaded by trim() */
+    uint64_t totalLoadUs = 0;      /**< Time spent in loads, in microseconds */
+    uint64_t lastLoadUs = 0;       /**< Duration of the most recent load */
+    std::size_t residentCount = 0; /**< Textures currently loaded */
+    std::size_t residentBytes = 0; /**< Estimated GPU memory of loaded textures (RGBA8) */
+};
+
+/**
+ * @class TextureCache
+ * @brief Loads each texture file once and hands out shared handles to it.
+ *
+ * The refcount of a texture is the number of handles held outside the cache;
+ * textures nobody holds stay loaded until trim() is called, so entities that
+ * die and respawn every few frames never hit the disk again.
+ */
+class TextureCache
+{
+  public:
+    using Handle = std::shared_ptr<Raylib::Texture>;
+
+    /**
+     * @brief Returns the texture for a path, loading it on first use.
+     * @param path Path to the image file.
+     */
+    Handle acquire(const std::string &path);
+
+    /**
+     * @brief Unloads every texture no handle refers to anymore.
+     * @return Number of textures unloaded.
+     */
+    std::size_t trim();
+
+    /**
+     * @brief Current counters.
+     */
+    const TextureCacheStats &stats() const
+    {
+        return _stats;
+    }
+
+  private:
+    std::unordered_map<std::string, Handle> _textures;
+    TextureCacheStats _stats;
+};
+
+} // namespace Graphic
+} // namespace Rtype
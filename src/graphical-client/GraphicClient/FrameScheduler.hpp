@@ -0,0 +1,179 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Fixed-step simulation scheduler and frame-time statistics
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class FrameTimes
+ * @brief Rolling record of the last frame durations, for the frame-time overlay.
+ */
+class FrameTimes
+{
+  public:
+    static constexpr std::size_t kFrames = 240; /**< Frames kept (4 s at 60 FPS) */
+    static constexpr std::size_t kBuckets = 34; /**< 1 ms histogram buckets, the last one catches the rest */
+    using Histogram = std::array<uint16_t, kBuckets>;
+
+    /**
+     * @brief Records one frame duration.
+     * @param ms Frame duration in milliseconds.
+     */
+    void record(float ms)
+    {
+        _frames[_next] = ms;
+        _next = (_next + 1) % kFrames;
+        _count = std::min(_count + 1, kFrames);
+    }
+
+    /**
+     * @brief Number of frames currently recorded.
+     */
+    std::size_t count() const
+    {
+        return _count;
+    }
+
+    /**
+     * @brief Frame duration at a percentile of the recorded window.
+     * @param pct Percentile in [0, 100].
+     */
+    float percentile(float pct) const
+    {
+        if (_count == 0)
+            return 0.0f;
+        std::array<float, kFrames> sorted;
+        std::copy(_frames.begin(), _frames.begin() + _count, sorted.begin());
+        std::size_t rank = static_cast<std::size_t>(pct / 100.0f * static_cast<float>(_count - 1) + 0.5f);
+        std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + _count);
+        return sorted[rank];
+    }
+
+    /**
+     * @brief Counts of the recorded frames per 1 ms bucket.
+     */
+    Histogram histogram() const
+    {
+        Histogram buckets{};
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+            std::size_t bucket = _frames[i] > 0.0f ? static_cast<std::size_t>(_frames[i]) : 0;
+            ++buckets[std::min(bucket, kBuckets - 1)];
+        }
+        return buckets;
+    }
+
+    /**
+     * @brief Forgets every recorded frame.
+     */
+    void clear()
+    {
+        _next = 0;
+        _count = 0;
+    }
+
+  private:
+    std::array<float, kFrames> _frames{};
+    std::size_t _next = 0;
+    std::size_t _count = 0;
+};
+
+/**
+ * @class FrameScheduler
+ * @brief Splits variable-length frames into fixed simulation steps.
+ *
+ * Each frame adds its duration to an accumulator and consumes it in whole steps, so the
+ * simulation runs at the same rate as the server tick whatever the render rate. What is
+ * left, as a fraction of a step, is the interpolation factor between the last two
+ * simulated states. Pure C++: no window needed.
+ */
+class FrameScheduler
+{
+  public:
+    static constexpr int kMaxStepsPerFrame = 5; /**< Steps caught up after a hitch, the rest is dropped */
+
+    /**
+     * @brief Builds a scheduler.
+     * @param stepSeconds Simulation step in seconds.
+     */
+    explicit FrameScheduler(float stepSeconds = 0.032f) : _step(stepSeconds)
+    {
+    }
+
+    /**
+     * @brief Accounts for a rendered frame.
+     * @param frameSeconds Duration of the frame in seconds.
+     * @return Number of simulation steps to run before rendering.
+     */
+    int beginFrame(float frameSeconds)
+    {
+        _times.record(frameSeconds * 1000.0f);
+        _accumulator += frameSeconds;
+        int steps = 0;
+        while (_accumulator >= _step && steps < kMaxStepsPerFrame)
+        {
+            _accumulator -= _step;
+            ++steps;
+        }
+        if (steps == kMaxStepsPerFrame && _accumulator >= _step)
+            _accumulator = 0.0f;
+        _lastSteps = steps;
+        return steps;
+    }
+
+    /**
+     * @brief Interpolation factor in [0, 1) between the previous and the current step.
+     */
+    float alpha() const
+    {
+        return _accumulator / _step;
+    }
+
+    /**
+     * @brief Simulation step in seconds.
+     */
+    float step() const
+    {
+        return _step;
+    }
+
+    /**
+     * @brief Steps run by the last beginFrame().
+     */
+    int lastSteps() const
+    {
+        return _lastSteps;
+    }
+
+    /**
+     * @brief Recorded frame durations.
+     */
+    const FrameTimes &times() const
+    {
+        return _times;
+    }
+
+    /**
+     * @brief Drops the pending time and the recorded frames.
+     */
+    void reset()
+    {
+        _accumulator = 0.0f;
+        _lastSteps = 0;
+        _times.clear();
+    }
+
+  private:
+    float _step;
+    float _accumulator = 0.0f;
+    int _lastSteps = 0;
+    FrameTimes _times;
+};
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <iostream>
 #include <limits>
@@ -17,9 +18,14 @@
 #include <thread>
 #include <unordered_set>
 
-GraphicClient::GraphicClient() : _window(1920, 1080, "Mystic-Type"), _net("127.0.0.1", 4243)
+GraphicClient::GraphicClient(const ClientOptions &options)
+    : _window(1920, 1080, "Mystic-Type"), _net("127.0.0.1", 4243),
+      _frames(static_cast<float>(std::max(options.simulationStepMs, 1)) / 1000.0f), _showFrameStats(options.frameStats)
 {
-    _window.setTargetFPS(60);
+    _window.setTargetFPS(options.uncappedFps ? 0 : 60);
+    _net.setThreadedReceive(options.threadedNetwork);
+    if (options.netem.enabled())
+        _net.setImpairment(options.netem);
     _lastKeepAlive = std::chrono::steady_clock::now();
     _lastHello = _lastKeepAlive;
 }
@@ -81,9 +87,10 @@ bool GraphicClient::init()
     _lastHello = std::chrono::steady_clock::now();
 
     _net.pollPackets();
+    _state.setLocalPlayerId(_net.getPlayerId());
     for (const auto &p : _net.getLastPlayerList())
         _state.upsertPlayer(p.id, p.x, p.y, p.hp, p.score);
-    syncEntities(_state.listPlayers());
+    syncEntities(_state.players());
     _net.clearEvents();
     std::cout << "Init end" << std::endl;
     return true;
@@ -94,37 +101,53 @@ Entity GraphicClient::createPlayerEntity(float x, float y)
     Entity ent = _ecs.createEntity();
     _ecs.addComponent(ent, Position{x, y});
     _ecs.addComponent(ent, Velocity{0, 0});
-    auto sprite = std::make_shared<Rtype::Graphic::AnimatedSprite>("../../sprites/r-typesheet42.gif", Vector2{33, 17},
-                                                                   Vector2{0, 0}, 4, 0.15f, Vector2{x, y});
+    auto sprite = std::make_shared<Rtype::Graphic::AnimatedSprite>(
+        _textures.acquire("../../sprites/r-typesheet42.gif"), Vector2{33, 17}, Vector2{0, 0}, 4, 0.15f, Vector2{x, y});
     _ecs.addComponent(ent, Sprite{sprite});
     return ent;
 }
 
 Entity GraphicClient::createBulletEntity(float x, float y, float vx, float vy)
 {
-    Entity ent = _ecs.createEntity();
+    Entity ent = _bulletPool.acquire(_ecs, Position{x, y});
+    if (ent != INVALID_ENTITY)
+    {
+        _ecs.getComponent<Velocity>(ent) = Velocity{vx, vy};
+        _ecs.getComponent<PreviousPosition>(ent) = PreviousPosition{x, y};
+        return ent;
+    }
+    ent = _ecs.createEntity();
     _ecs.addComponent(ent, Position{x, y});
     _ecs.addComponent(ent, Velocity{vx, vy});
     _ecs.addComponent(ent, RectangleComponent{6, 6, RED});
+    _ecs.addComponent(ent, PreviousPosition{x, y});
     return ent;
 }
 
 Entity GraphicClient::createMonsterEntity(float x, float y, uint8_t type)
 {
-    Entity ent = _ecs.createEntity();
+    Entity ent = _monsterPools[type].acquire(_ecs, Position{x, y});
+    if (ent != INVALID_ENTITY)
+    {
+        _ecs.getComponent<PreviousPosition>(ent) = PreviousPosition{x, y};
+        return ent;
+    }
+    ent = _ecs.createEntity();
     _ecs.addComponent(ent, Position{x, y});
     _ecs.addComponent(ent, Velocity{0, 0});
+    _ecs.addComponent(ent, PreviousPosition{x, y});
+    _ecs.addComponent(ent, MonsterKind{type});
 
     // Create animated sprite for monster
     // Spritesheet: 205x18, 17 sprites, so each sprite is ~12x18
     // Type 1 = Blue (row 0), Type 2 = Red (row 1)
     Vector2 spriteSize{17, 18};
     Vector2 posInSheet{0, static_cast<float>(type - 1)}; // Row based on type
-    auto sprite =
-        std::make_shared<Rtype::Graphic::AnimatedSprite>("../../sprites/r-typesheet3.gif", spriteSize, posInSheet,
-                                                         12,    // 17 sprites in the sheet
-                                                         0.15f, // Frame time
-                                                         Vector2{x, y});
+    auto sprite = std::make_shared<Rtype::Graphic::AnimatedSprite>(
+        _textures.acquire("../../sprites/r-typesheet3.gif"), spriteSize, posInSheet,
+        12,    // 17 sprites in the sheet
+        0.15f, // Frame time
+        Vector2{x, y});
     if (type == 2)
     {
         sprite->setScale(2.0f, 2.0f);
@@ -152,6 +175,8 @@ void GraphicClient::syncEntities(const std::vector<PlayerState> &players)
         if (it == _entities.end())
         {
             Entity ent = createPlayerEntity(clientX, clientY);
+            if (p.id != myId)
+                _ecs.addComponent(ent, PreviousPosition{clientX, clientY});
             _entities[p.id] = ent;
         }
         else
@@ -177,6 +202,7 @@ void GraphicClient::syncEntities(const std::vector<PlayerState> &players)
                 {
                     pos.x = clientX;
                     pos.y = clientY;
+                    _ecs.getComponent<PreviousPosition>(it->second) = PreviousPosition{clientX, clientY};
                 }
                 else
                 {
@@ -194,6 +220,7 @@ void GraphicClient::syncEntities(const std::vector<PlayerState> &players)
     {
         if (liveIds.find(it->first) == liveIds.end())
         {
+            _ecs.destroyEntity(it->second);
             it = _entities.erase(it);
         }
         else
@@ -229,16 +256,16 @@ void GraphicClient::syncBullets(const std::vector<BulletState> &bullets)
             vel.vy = serverVy;
         }
     }
-    for (auto &kv : _bulletEntities)
+    for (auto it = _bulletEntities.begin(); it != _bulletEntities.end();)
     {
-        if (liveIds.find(kv.first) == liveIds.end())
+        if (liveIds.find(it->first) == liveIds.end())
+        {
+            _bulletPool.release(_ecs, it->second);
+            it = _bulletEntities.erase(it);
+        }
+        else
         {
-            auto &pos = _ecs.getComponent<Position>(kv.second);
-            auto &vel = _ecs.getComponent<Velocity>(kv.second);
-            pos.x = -1000.0f;
-            pos.y = -1000.0f;
-            vel.vx = 0.0f;
-            vel.vy = 0.0f;
+            ++it;
         }
     }
 }
@@ -266,13 +293,16 @@ void GraphicClient::syncMonsters(const std::vector<MonsterState> &monsters)
             pos.y += (clientY - pos.y) * smoothing;
         }
     }
-    for (auto &kv : _monsterEntities)
+    for (auto it = _monsterEntities.begin(); it != _monsterEntities.end();)
     {
-        if (liveIds.find(kv.first) == liveIds.end())
+        if (liveIds.find(it->first) == liveIds.end())
         {
-            auto &pos = _ecs.getComponent<Position>(kv.second);
-            pos.x = -1000.0f;
-            pos.y = -1000.0f;
+            _monsterPools[_ecs.getComponent<MonsterKind>(it->second).type].release(_ecs, it->second);
+            it = _monsterEntities.erase(it);
+        }
+        else
+        {
+            ++it;
         }
     }
 }
@@ -298,15 +328,16 @@ void GraphicClient::processNetworkEvents()
         if (!_net.pollPackets())
             break;
     }
+    _state.setLocalPlayerId(_net.getPlayerId());
     for (const auto &ev : _net.getEvents())
     {
-        if (ev == "PLAYER_LIST" || ev == "NEW_PLAYER")
+        if (ev.type == NetEventType::PlayerList || ev.type == NetEventType::NewPlayer)
         {
             _state.clearPlayers();
             for (const auto &p : _net.getLastPlayerList())
                 _state.upsertPlayer(p.id, p.x, p.y, p.hp, p.score);
         }
-        else if (ev == "SNAPSHOT")
+        else if (ev.type == NetEventType::Snapshot)
         {
             _udpReady = true;
             _state.clear();
@@ -314,24 +345,8 @@ void GraphicClient::processNetworkEvents()
                 _state.upsertPlayer(p.id, p.x, p.y, p.hp, p.score);
             for (const auto &m : _net.getLastSnapshotMonsters())
                 _state.upsertMonster(m.id, m.x, m.y, m.hp, m.type);
-            int myId = _net.getPlayerId();
-            bool foundMe = false;
-            for (const auto &p : _state.listPlayers())
-            {
-                if (p.id == myId)
-                {
-                    foundMe = true;
-                    if (p.hp == 0)
-                    {
-                        std::cerr << "[CLIENT] Vous etes mort\n";
-                        _net.disconnect();
-                        _forceExit = true;
-                        _restartToMenu = true;
-                    }
-                    break;
-                }
-            }
-            if (!foundMe)
+            const PlayerState *me = _state.localPlayer();
+            if (!me || me->hp == 0)
             {
                 std::cerr << "[CLIENT] Vous etes mort\n";
                 _net.disconnect();
@@ -339,9 +354,9 @@ void GraphicClient::processNetworkEvents()
                 _restartToMenu = true;
             }
         }
-        else if (ev.rfind("MESSAGE:", 0) == 0)
+        else if (ev.type == NetEventType::Message)
         {
-            std::string msg = ev.substr(std::string("MESSAGE:").size());
+            const std::string &msg = ev.text;
             if (msg == "DEAD")
             {
                 requestReturnToLobby("Vous etes mort");
@@ -381,9 +396,11 @@ void GraphicClient::processNetworkEvents()
     }
     _net.clearEvents();
 }
-void GraphicClient::updateEntities(float dt)
+void GraphicClient::updateEntities()
 {
-    syncEntities(_state.listPlayers());
+    // Before the syncs: snapshot smoothing moves remote players and monsters too, and must be interpolated.
+    _movementSystem.begin(_ecs);
+    syncEntities(_state.players());
     syncBullets(_net.getLastSnapshotBullets());
     syncMonsters(_net.getLastSnapshotMonsters());
 
@@ -399,16 +416,7 @@ void GraphicClient::updateEntities(float dt)
             _inputSystem.update(_net, myPos, myVel);
     }
 
-    for (const auto &kv : _entities)
-    {
-        if (kv.first == myId)
-            continue;
-        _movementSystem.update(_ecs, kv.second, dt);
-    }
-    for (const auto &kv : _bulletEntities)
-    {
-        _movementSystem.update(_ecs, kv.second, dt);
-    }
+    _movementSystem.step(_ecs);
 
     if (_entities.find(myId) != _entities.end())
     {
@@ -463,17 +471,17 @@ bool GraphicClient::selectLobby()
         bool ok = false;
         for (const auto &ev : _net.getEvents())
         {
-            if (ev.rfind("LOBBY_OK:", 0) == 0)
+            if (ev.type == NetEventType::LobbyOk)
             {
                 hasLobbyOk = true;
                 ok = true;
             }
-            if (ev.rfind("LOBBY_ERROR:", 0) == 0)
+            if (ev.type == NetEventType::LobbyError)
             {
-                lobbyError = ev.substr(std::string("LOBBY_ERROR:").size());
+                lobbyError = ev.text;
             }
             // Fallback: if we receive PLAYER_LIST before LOBBY_OK, assume lobby joined
-            if (ev == "PLAYER_LIST" || ev == "NEW_PLAYER")
+            if (ev.type == NetEventType::PlayerList || ev.type == NetEventType::NewPlayer)
             {
                 hasLobbyOk = true;
                 ok = true;
@@ -792,30 +800,18 @@ void GraphicClient::render(float dt)
 
     drawGameBackground(_gameAnimTimer);
 
-    uint8_t myHp = 0;
-    uint16_t myScore = 0;
-    bool hasHp = false;
-    bool hasScore = false;
-    int myId = _net.getPlayerId();
-    for (const auto &p : _state.listPlayers())
-    {
-        if (p.id == myId)
-        {
-            myHp = p.hp;
-            myScore = p.score;
-            hasHp = true;
-            hasScore = true;
-            break;
-        }
-    }
-    std::string hpText = hasHp ? ("HP: " + std::to_string(myHp)) : "HP: --";
+    const PlayerState *me = _state.localPlayer();
+    std::string hpText = me ? ("HP: " + std::to_string(me->hp)) : "HP: --";
     Raylib::Draw::text(hpText, static_cast<int>(GAME_AREA_OFFSET_X) + 12, static_cast<int>(GAME_AREA_OFFSET_Y) + 12, 24,
                        {255, 255, 255, 230});
-    std::string scoreText = hasScore ? ("SCORE: " + std::to_string(myScore)) : "SCORE: --";
+    std::string scoreText = me ? ("SCORE: " + std::to_string(me->score)) : "SCORE: --";
     Raylib::Draw::text(scoreText, static_cast<int>(GAME_AREA_OFFSET_X) + 12, static_cast<int>(GAME_AREA_OFFSET_Y) + 40,
                        22, {255, 255, 255, 210});
     int pingMs = _net.getUdpPingMs();
-    std::string pingText = pingMs >= 0 ? ("PING: " + std::to_string(pingMs) + " ms") : "PING: --";
+    int jitterMs = static_cast<int>(_net.getSnapshotJitterMs() + 0.5f);
+    std::string pingText = pingMs >= 0 ? ("PING: " + std::to_string(pingMs) + " ms (jitter " +
+                                          std::to_string(jitterMs) + " ms)")
+                                       : "PING: --";
     Raylib::Draw::text(pingText, static_cast<int>(GAME_AREA_OFFSET_X) + 12, static_cast<int>(GAME_AREA_OFFSET_Y) + 66,
                        20, {200, 220, 255, 220});
     int lossPct = static_cast<int>(_net.getUdpLossPct() + 0.5f);
@@ -851,22 +847,60 @@ void GraphicClient::render(float dt)
     }
 
     _spriteRenderSystem.setScale(1.0f, 1.0f);
-    for (const auto &kv : _entities)
-    {
-        _spriteRenderSystem.update(_ecs, kv.second, dt);
-    }
+    _spriteRenderSystem.setInterpolation(_frames.alpha());
+    _rectangleRenderSystem.setInterpolation(_frames.alpha());
+    _drawList.clear();
+    _spriteRenderSystem.update(_ecs, dt, _drawList);
+    _rectangleRenderSystem.update(_ecs, _drawList);
+    _drawList.sort();
+    _drawStats = Raylib::Draw::batch(_drawList);
+
+    std::string drawText = "DRAW: " + std::to_string(_drawStats.drawCalls) + " calls / " +
+                           std::to_string(_drawStats.vertices) + " verts";
+    Raylib::Draw::text(drawText, static_cast<int>(GAME_AREA_OFFSET_X) + 12, static_cast<int>(GAME_AREA_OFFSET_Y) + 158,
+                       16, {180, 210, 240, 180});
+
+    if (_showFrameStats)
+        drawFrameStats();
 
-    for (const auto &kv : _bulletEntities)
-    {
-        _rectangleRenderSystem.update(_ecs, kv.second);
-    }
+    _window.endDrawing();
+}
 
-    for (const auto &kv : _monsterEntities)
+void GraphicClient::drawFrameStats()
+{
+    const FrameTimes &times = _frames.times();
+    const int x = static_cast<int>(GAME_AREA_OFFSET_X + GAME_AREA_SIZE) + 20;
+    const int y = static_cast<int>(GAME_AREA_OFFSET_Y);
+    const int barWidth = 8;
+    const int graphHeight = 100;
+    const int width = static_cast<int>(FrameTimes::kBuckets) * barWidth;
+
+    Raylib::Draw::rectangle(x - 8, y - 8, width + 16, graphHeight + 96, {10, 10, 20, 190});
+    char line[96];
+    std::snprintf(line, sizeof(line), "FRAME p50 %.1f  p99 %.1f  max %.1f ms", times.percentile(50.0f),
+                  times.percentile(99.0f), times.percentile(100.0f));
+    Raylib::Draw::text(line, x, y, 16, {220, 230, 255, 230});
+    std::snprintf(line, sizeof(line), "FPS %d  SIM %.0f Hz  steps %d  alpha %.2f", GetFPS(), 1.0f / _frames.step(),
+                  _frames.lastSteps(), _frames.alpha());
+    Raylib::Draw::text(line, x, y + 20, 16, {220, 230, 255, 230});
+
+    FrameTimes::Histogram buckets = times.histogram();
+    uint16_t peak = *std::max_element(buckets.begin(), buckets.end());
+    int base = y + 48 + graphHeight;
+    for (std::size_t i = 0; i < buckets.size(); ++i)
     {
-        _spriteRenderSystem.update(_ecs, kv.second, dt);
+        if (buckets[i] == 0)
+            continue;
+        int h = std::max(1, buckets[i] * graphHeight / std::max<int>(peak, 1));
+        // Green within a 60 FPS frame, orange within 30 FPS, red beyond.
+        Color color = i < 17 ? Color{90, 220, 120, 230} : (i < 33 ? Color{240, 170, 60, 230} : Color{230, 60, 60, 230});
+        Raylib::Draw::rectangle(x + static_cast<int>(i) * barWidth, base - h, barWidth - 1, h, color);
     }
-
-    _window.endDrawing();
+    Raylib::Draw::rectangle(x + 17 * barWidth - 1, y + 48, 1, graphHeight, {255, 255, 255, 90});
+    Raylib::Draw::rectangle(x + 33 * barWidth - 1, y + 48, 1, graphHeight, {255, 255, 255, 90});
+    Raylib::Draw::text("0", x, base + 4, 14, {200, 200, 200, 200});
+    Raylib::Draw::text("16.7", x + 17 * barWidth - 12, base + 4, 14, {200, 200, 200, 200});
+    Raylib::Draw::text("33+ ms", x + 33 * barWidth - 12, base + 4, 14, {200, 200, 200, 200});
 }
 
 void GraphicClient::gameLoop()
@@ -874,6 +908,7 @@ void GraphicClient::gameLoop()
     while (!_window.shouldClose())
     {
         float dt = _window.getFrameTime();
+        int steps = _frames.beginFrame(dt);
         // std::cerr << "before processing network event" << i << std::endl;
         processNetworkEvents();
         if (_pendingReturnToLobby)
@@ -893,7 +928,7 @@ void GraphicClient::gameLoop()
         // If PING send failed, drop to avoid server timeout
         for (const auto &ev : _net.getEvents())
         {
-            if (ev == "PING_SEND_FAIL")
+            if (ev.type == NetEventType::PingSendFail)
             {
                 std::cerr << "[CLIENT] Failed to send PONG, disconnecting\n";
                 _net.disconnect();
@@ -929,6 +964,9 @@ void GraphicClient::gameLoop()
             }
         }
 
+        if (Raylib::Input::isKeyPressed(KEY_F3))
+            _showFrameStats = !_showFrameStats;
+
         if (!_chatActive && Raylib::Input::isKeyPressed(KEY_ESCAPE))
         {
             _net.disconnectUdp();
@@ -977,7 +1015,10 @@ void GraphicClient::gameLoop()
             }
         }
 
-        updateEntities(dt);
+        if (!_chatActive)
+            _inputSystem.latch();
+        for (int i = 0; i < steps; ++i)
+            updateEntities();
         // std::cerr << "after update entities" << i << std::endl;
         // std::cerr << "before render" << i << std::endl;
         render(dt);
@@ -1004,10 +1045,15 @@ int GraphicClient::run()
             _forceExit = false;
             _udpReady = false;
             _gameAnimTimer = 0.0f;
+            _frames.reset();
             _state.clear();
             _entities.clear();
             _bulletEntities.clear();
             _monsterEntities.clear();
+            _ecs = ECS();
+            _bulletPool.clear();
+            _monsterPools.clear();
+            _textures.trim();
             _chatLog.clear();
             _chatInput.clear();
             _chatActive = false;
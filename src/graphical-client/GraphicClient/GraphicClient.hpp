@@ -9,14 +9,30 @@
 
 #include "../../Network/Client/GameState.hpp"
 #include "../../Network/Client/NetworkClient.hpp"
+#include "../Graphic/TextureCache.hpp"
 #include "../Raylib/Raylib.hpp"
 #include "../ecs/Core.hpp"
+#include "../ecs/EntityPool.hpp"
 #include "../ecs/System.hpp"
+#include "FrameScheduler.hpp"
 #include <chrono>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+/**
+ * @struct ClientOptions
+ * @brief Command-line tunables of the client.
+ */
+struct ClientOptions
+{
+    bool threadedNetwork = true; /**< Read UDP on a dedicated thread instead of the render loop */
+    bool uncappedFps = false;    /**< Render as fast as possible instead of capping at 60 FPS */
+    int simulationStepMs = 32;   /**< Fixed simulation step, matches the server tick */
+    bool frameStats = false;     /**< Show the frame-time overlay from the start (F3 toggles it) */
+    Network::TransportLayer::Impairment::Config netem; /**< Simulated bad network on the UDP link (--netem) */
+};
+
 /**
  * @class GraphicClient
  * @brief Main client application managing graphics, networking, and game state.
@@ -29,8 +45,9 @@ class GraphicClient
   public:
     /**
      * @brief Constructor initializing the graphic client.
+     * @param options Network and frame pacing options.
      */
-    GraphicClient();
+    explicit GraphicClient(const ClientOptions &options = {});
     ~GraphicClient() = default;
 
     /**
@@ -61,17 +78,21 @@ class GraphicClient
     void processNetworkEvents();
 
     /**
-     * @brief Updates all game entities based on delta time.
-     * @param dt Delta time since last update.
+     * @brief Runs one fixed simulation step: snapshot sync, input and movement.
      */
-    void updateEntities(float dt);
+    void updateEntities();
 
     /**
-     * @brief Renders the entire game scene.
+     * @brief Renders the entire game scene, interpolated between the last two simulation steps.
      * @param dt Delta time since last frame.
      */
     void render(float dt);
 
+    /**
+     * @brief Draws the frame-time histogram and percentiles.
+     */
+    void drawFrameStats();
+
     /**
      * @brief Draws the game area background with animations.
      * @param hoverAnimTimer Animation timer for effects.
@@ -162,7 +183,8 @@ class GraphicClient
     void disconnectAndQuit();
 
     // Graphics and Rendering
-    Raylib::Window _window; /**< Game window handle */
+    Raylib::Window _window;                 /**< Game window handle */
+    Rtype::Graphic::TextureCache _textures; /**< Sprite sheets shared by all entities */
 
     // Networking
     NetworkClient _net; /**< Network client for server communication */
@@ -176,12 +198,20 @@ class GraphicClient
     RectangleRenderSystem _rectangleRenderSystem; /**< Rectangle rendering system */
     InputSystem _inputSystem;                     /**< Player input handling system */
     MovementSystem _movementSystem;               /**< Entity movement system */
+    Raylib::DrawList _drawList;                   /**< Game-area quads of the current frame */
+    Raylib::DrawStats _drawStats;                 /**< Draw calls and vertices of the last frame */
+    FrameScheduler _frames;                       /**< Fixed simulation steps and frame times */
+    bool _showFrameStats = false;                 /**< Frame-time overlay visible */
 
     // Entity Maps
     std::unordered_map<int, Entity> _entities;        /**< Mapping of server player IDs to entities */
     std::unordered_map<int, Entity> _bulletEntities;  /**< Mapping of bullet IDs to entities */
     std::unordered_map<int, Entity> _monsterEntities; /**< Mapping of monster IDs to entities */
 
+    // Entity Pools
+    EntityPool<Position> _bulletPool;                                /**< Dead bullets kept for reuse */
+    std::unordered_map<uint8_t, EntityPool<Position>> _monsterPools; /**< Dead monsters kept for reuse, per type */
+
     // Chat System
     std::vector<std::string> _chatLog; /**< Chat message history */
     std::string _chatInput;            /**< Current chat input buffer */
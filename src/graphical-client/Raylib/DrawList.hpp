@@ -0,0 +1,185 @@
+/*
+** EPITECH PROJECT, 2025
+** client
+** File description:
+** Per-frame list of 2D draw commands
+*/
+
+#ifndef DRAWLIST_HPP_
+#define DRAWLIST_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @namespace Raylib
+ * @brief Wrapper namespace for Raylib graphics library.
+ */
+namespace Raylib
+{
+/**
+ * @struct Quad
+ * @brief Axis-aligned rectangle in pixels (same layout as raylib's Rectangle).
+ */
+struct Quad
+{
+    float x;      /**< Left edge */
+    float y;      /**< Top edge */
+    float width;  /**< Width */
+    float height; /**< Height */
+};
+
+/**
+ * @struct Tint
+ * @brief RGBA color (same layout as raylib's Color).
+ */
+struct Tint
+{
+    uint8_t r; /**< Red */
+    uint8_t g; /**< Green */
+    uint8_t b; /**< Blue */
+    uint8_t a; /**< Alpha */
+};
+
+/**
+ * @struct DrawCommand
+ * @brief One textured or flat quad, ready to be turned into four vertices.
+ */
+struct DrawCommand
+{
+    uint64_t key;     /**< Sort key: layer in the high word, texture in the low word */
+    uint32_t order;   /**< Submission index, keeps the sort stable */
+    uint32_t texture; /**< GPU texture id, 0 for a flat colored quad */
+    float x0;         /**< Destination left */
+    float y0;         /**< Destination top */
+    float x1;         /**< Destination right */
+    float y1;         /**< Destination bottom */
+    float u0;         /**< Normalized source left */
+    float v0;         /**< Normalized source top */
+    float u1;         /**< Normalized source right */
+    float v1;         /**< Normalized source bottom */
+    Tint tint;        /**< Vertex color */
+};
+
+/**
+ * @struct DrawStats
+ * @brief GPU work of one submitted frame.
+ */
+struct DrawStats
+{
+    std::size_t commands = 0;  /**< Quads submitted */
+    std::size_t drawCalls = 0; /**< Texture switches, i.e. draw calls in the render batch */
+    std::size_t vertices = 0;  /**< Vertices submitted */
+};
+
+/**
+ * @class DrawList
+ * @brief Collects the game-area quads of a frame so they can be sorted and batched.
+ *
+ * Commands are grouped by layer first (lower layers drawn first), then by texture, so
+ * every entity sharing a sprite sheet ends up in one draw call. Within a layer and
+ * texture, submission order is kept. Pure C++: building and sorting need no window.
+ */
+class DrawList
+{
+  public:
+    /**
+     * @brief Queues a textured quad.
+     * @param texture GPU texture id.
+     * @param texWidth Texture width in pixels.
+     * @param texHeight Texture height in pixels.
+     * @param source Source rectangle in the texture, in pixels.
+     * @param dest Destination rectangle on screen.
+     * @param tint Color tint.
+     * @param layer Draw layer.
+     */
+    void sprite(uint32_t texture, int texWidth, int texHeight, const Quad &source, const Quad &dest, Tint tint,
+                int layer = 0)
+    {
+        float w = texWidth > 0 ? static_cast<float>(texWidth) : 1.0f;
+        float h = texHeight > 0 ? static_cast<float>(texHeight) : 1.0f;
+        push(texture, dest, source.x / w, source.y / h, (source.x + source.width) / w, (source.y + source.height) / h,
+             tint, layer);
+    }
+
+    /**
+     * @brief Queues a flat colored quad.
+     * @param dest Destination rectangle on screen.
+     * @param tint Fill color.
+     * @param layer Draw layer.
+     */
+    void rect(const Quad &dest, Tint tint, int layer = 0)
+    {
+        push(0, dest, 0.0f, 0.0f, 1.0f, 1.0f, tint, layer);
+    }
+
+    /**
+     * @brief Orders commands by layer, then texture, then submission order.
+     */
+    void sort()
+    {
+        std::sort(_commands.begin(), _commands.end(), [](const DrawCommand &a, const DrawCommand &b) {
+            return a.key != b.key ? a.key < b.key : a.order < b.order;
+        });
+    }
+
+    /**
+     * @brief Draw calls and vertices the current command order costs.
+     */
+    DrawStats measure() const
+    {
+        DrawStats stats;
+        stats.commands = _commands.size();
+        stats.vertices = _commands.size() * 4;
+        for (std::size_t i = 0; i < _commands.size(); ++i)
+        {
+            if (i == 0 || _commands[i].texture != _commands[i - 1].texture)
+                ++stats.drawCalls;
+        }
+        return stats;
+    }
+
+    /**
+     * @brief Drops every command, keeping the allocation for the next frame.
+     */
+    void clear()
+    {
+        _commands.clear();
+    }
+
+    /**
+     * @brief Queued commands, in their current order.
+     */
+    const std::vector<DrawCommand> &commands() const
+    {
+        return _commands;
+    }
+
+  private:
+    void push(uint32_t texture, const Quad &dest, float u0, float v0, float u1, float v1, Tint tint, int layer)
+    {
+        DrawCommand cmd;
+        uint32_t biasedLayer = static_cast<uint32_t>(layer) ^ 0x80000000u;
+        cmd.key = (static_cast<uint64_t>(biasedLayer) << 32) | texture;
+        cmd.order = static_cast<uint32_t>(_commands.size());
+        cmd.texture = texture;
+        cmd.x0 = dest.x;
+        cmd.y0 = dest.y;
+        cmd.x1 = dest.x + dest.width;
+        cmd.y1 = dest.y + dest.height;
+        cmd.u0 = u0;
+        cmd.v0 = v0;
+        cmd.u1 = u1;
+        cmd.v1 = v1;
+        cmd.tint = tint;
+        _commands.push_back(cmd);
+    }
+
+    std::vector<DrawCommand> _commands;
+};
+
+} // namespace Raylib
+
+#endif /* !DRAWLIST_HPP_ */
@@ -6,6 +6,8 @@
 */
 
 #include "Raylib.hpp"
+#include <algorithm>
+#include <rlgl.h>
 
 namespace Raylib
 {
@@ -82,6 +84,10 @@ int Texture::getHeight() const
 {
     return _texture.height;
 }
+unsigned int Texture::getId() const
+{
+    return _texture.id;
+}
 
 void Draw::circle(int centerX, int centerY, float radius, Color color)
 {
@@ -104,6 +110,48 @@ void Draw::text(const std::string &msg, int posX, int posY, int fontSize, Color
     ::DrawText(msg.c_str(), posX, posY, fontSize, color);
 }
 
+DrawStats Draw::batch(const DrawList &list)
+{
+    // Quads emitted between two batch limit checks; keeps every rlBegin/rlEnd inside one render batch.
+    constexpr std::size_t chunkQuads = 1024;
+    const auto &commands = list.commands();
+    DrawStats stats = list.measure();
+
+    std::size_t i = 0;
+    while (i < commands.size())
+    {
+        uint32_t texture = commands[i].texture;
+        std::size_t runEnd = i;
+        while (runEnd < commands.size() && commands[runEnd].texture == texture)
+            ++runEnd;
+
+        while (i < runEnd)
+        {
+            std::size_t chunkEnd = std::min(runEnd, i + chunkQuads);
+            ::rlCheckRenderBatchLimit(static_cast<int>((chunkEnd - i) * 4));
+            ::rlSetTexture(texture != 0 ? texture : ::rlGetTextureIdDefault());
+            ::rlBegin(RL_QUADS);
+            for (; i < chunkEnd; ++i)
+            {
+                const DrawCommand &cmd = commands[i];
+                ::rlColor4ub(cmd.tint.r, cmd.tint.g, cmd.tint.b, cmd.tint.a);
+                ::rlNormal3f(0.0f, 0.0f, 1.0f);
+                ::rlTexCoord2f(cmd.u0, cmd.v0);
+                ::rlVertex2f(cmd.x0, cmd.y0);
+                ::rlTexCoord2f(cmd.u0, cmd.v1);
+                ::rlVertex2f(cmd.x0, cmd.y1);
+                ::rlTexCoord2f(cmd.u1, cmd.v1);
+                ::rlVertex2f(cmd.x1, cmd.y1);
+                ::rlTexCoord2f(cmd.u1, cmd.v0);
+                ::rlVertex2f(cmd.x1, cmd.y0);
+            }
+            ::rlEnd();
+        }
+    }
+    ::rlSetTexture(0);
+    return stats;
+}
+
 bool Input::isKeyDown(int key)
 {
     return ::IsKeyDown(key);
@@ -13,6 +13,7 @@
 #undef ShowCursor
 #undef CloseWindow
 #endif
+#include "DrawList.hpp"
 #include <raylib.h>
 #include <string>
 
@@ -139,6 +140,12 @@ class Texture
      */
     int getHeight() const;
 
+    /**
+     * @brief Gets the GPU texture id.
+     * @return OpenGL texture id, used to batch draws sharing the texture.
+     */
+    unsigned int getId() const;
+
   private:
     Texture2D _texture; /**< Raylib texture2D object */
 };
@@ -190,6 +197,13 @@ class Draw
      * @param color Text color.
      */
     static void text(const std::string &msg, int posX, int posY, int fontSize, Color color);
+
+    /**
+     * @brief Submits a sorted draw list through rlgl, one draw call per texture run.
+     * @param list Commands to draw, already sorted.
+     * @return Draw calls and vertices submitted.
+     */
+    static DrawStats batch(const DrawList &list);
 };
 
 /**
@@ -6,10 +6,31 @@
 */
 
 #include "GraphicClient/GraphicClient.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
-int main()
+int main(int argc, char **argv)
 {
+    ClientOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--no-net-thread") == 0)
+            options.threadedNetwork = false;
+        else if (std::strcmp(argv[i], "--uncapped") == 0)
+            options.uncappedFps = true;
+        else if (std::strcmp(argv[i], "--frame-stats") == 0)
+            options.frameStats = true;
+        else if (std::strcmp(argv[i], "--sim-step-ms") == 0 && i + 1 < argc)
+            options.simulationStepMs = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--netem") == 0 && i + 1 < argc)
+        {
+            if (!Network::TransportLayer::Impairment::Config::parse(argv[++i], options.netem))
+                std::cerr << "--netem: expected latency=,jitter=,loss=,dup=,reorder=,seed=" << std::endl;
+        }
+    }
+
 #ifdef _WIN32
     WSADATA wsaData;
     if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
@@ -17,7 +38,7 @@ int main()
         return 1;
     }
 #endif
-    GraphicClient client;
+    GraphicClient client(options);
     client.run();
 
 #ifdef _WIN32
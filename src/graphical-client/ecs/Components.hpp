@@ -10,32 +10,11 @@
 #pragma once
 
 #include "../Graphic/Graphic.hpp"
+#include "MotionComponents.hpp"
 #include <memory>
 #include <raylib.h>
 #include <string>
 
-/**
- * @class Position
- * @brief Represents the 2D position of an entity.
- *
- * Stores X and Y coordinates for game world positioning.
- */
-class Position
-{
-  public:
-    float x; /**< X coordinate */
-    float y; /**< Y coordinate */
-
-    /**
-     * @brief Constructor for Position.
-     * @param x X coordinate (default: 0).
-     * @param y Y coordinate (default: 0).
-     */
-    Position(float x = 0, float y = 0) : x(x), y(y)
-    {
-    }
-};
-
 /**
  * @class Sprite
  * @brief Stores an animated sprite for rendering.
@@ -61,28 +40,6 @@ class Sprite
     }
 };
 
-/**
- * @class Velocity
- * @brief Represents the velocity of an entity.
- *
- * Stores X and Y velocity components for movement.
- */
-class Velocity
-{
-  public:
-    float vx; /**< X velocity component */
-    float vy; /**< Y velocity component */
-
-    /**
-     * @brief Constructor for Velocity.
-     * @param vx X velocity (default: 0).
-     * @param vy Y velocity (default: 0).
-     */
-    Velocity(float vx = 0, float vy = 0) : vx(vx), vy(vy)
-    {
-    }
-};
-
 /**
  * @class CircleComponent
  * @brief Component for rendering circular entities.
@@ -5,14 +5,17 @@
 ** Core
 */
 #pragma once
+#include <array>
 #include <bitset>
+#include <cassert>
+#include <cstdint>
 #include <memory>
-#include <typeindex>
-#include <unordered_map>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 /**
- * @brief Maximum number of entities in the ECS system.
+ * @brief Initial entity capacity reserved by the ECS (storage grows past it on demand).
  */
 const int MAX_ENTITIES = 5000;
 
@@ -23,9 +26,43 @@ const int MAX_COMPONENTS = 32;
 
 /**
  * @brief Entity identifier type.
+ *
+ * The low ENTITY_INDEX_BITS hold the slot index, the high bits a generation counter
+ * bumped every time the slot is recycled, so stale handles are detected.
  */
 using Entity = uint32_t;
 
+/**
+ * @brief Number of bits of an Entity used for the slot index.
+ */
+constexpr uint32_t ENTITY_INDEX_BITS = 20;
+
+/**
+ * @brief Mask extracting the slot index from an Entity.
+ */
+constexpr uint32_t ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+
+/**
+ * @brief Value never returned by createEntity().
+ */
+constexpr Entity INVALID_ENTITY = 0xFFFFFFFFu;
+
+/**
+ * @brief Slot index of an entity.
+ */
+inline uint32_t entityIndex(Entity e)
+{
+    return e & ENTITY_INDEX_MASK;
+}
+
+/**
+ * @brief Generation of an entity.
+ */
+inline uint32_t entityGeneration(Entity e)
+{
+    return e >> ENTITY_INDEX_BITS;
+}
+
 /**
  * @brief Bitset representing which component types an entity has.
  */
@@ -41,19 +78,37 @@ class IComponentArray
 {
   public:
     virtual ~IComponentArray() = default;
+
+    /**
+     * @brief Removes the component of an entity, if it has one.
+     * @param e The entity ID.
+     */
+    virtual void remove(Entity e) = 0;
+
+    /**
+     * @brief Number of components stored.
+     */
+    virtual std::size_t size() const = 0;
 };
 
 /**
  * @class ComponentArray
- * @brief Template for storing components of a specific type.
+ * @brief Sparse set storing components of a specific type.
+ *
+ * Components are packed in `data` with their owner at the same position in `entities`;
+ * `sparse` maps an entity slot index to that position. Removal swaps the last component
+ * into the hole, so the arrays stay dense.
  *
  * @tparam T The component type to store.
  */
 template <typename T> class ComponentArray : public IComponentArray
 {
   public:
-    std::vector<T> data;          /**< Actual component data */
-    std::vector<Entity> entities; /**< Associated entity IDs */
+    static constexpr uint32_t NPOS = 0xFFFFFFFFu; /**< Sparse entry of a slot without component */
+
+    std::vector<T> data;          /**< Packed component data */
+    std::vector<Entity> entities; /**< Owner of each packed component */
+    std::vector<uint32_t> sparse; /**< Slot index -> position in data, or NPOS */
 
     /**
      * @brief Adds or updates a component for an entity.
@@ -62,13 +117,28 @@ template <typename T> class ComponentArray : public IComponentArray
      */
     void add(Entity e, const T &component)
     {
-        if (e >= data.size())
+        uint32_t idx = entityIndex(e);
+        if (idx >= sparse.size())
+            sparse.resize(idx + 1, NPOS);
+        if (sparse[idx] != NPOS)
         {
-            data.resize(e + 1);
-            entities.resize(e + 1);
+            data[sparse[idx]] = component;
+            entities[sparse[idx]] = e;
+            return;
         }
-        data[e] = component;
-        entities[e] = e;
+        sparse[idx] = static_cast<uint32_t>(data.size());
+        data.push_back(component);
+        entities.push_back(e);
+    }
+
+    /**
+     * @brief Checks whether an entity has a component in this array.
+     * @param e The entity ID.
+     */
+    bool has(Entity e) const
+    {
+        uint32_t idx = entityIndex(e);
+        return idx < sparse.size() && sparse[idx] != NPOS;
     }
 
     /**
@@ -78,8 +148,130 @@ template <typename T> class ComponentArray : public IComponentArray
      */
     T &get(Entity e)
     {
-        return data[e];
+        return data[sparse[entityIndex(e)]];
+    }
+
+    /**
+     * @brief Removes the component of an entity, moving the last component into its place.
+     * @param e The entity ID.
+     */
+    void remove(Entity e) override
+    {
+        if (!has(e))
+            return;
+        uint32_t idx = entityIndex(e);
+        uint32_t pos = sparse[idx];
+        uint32_t last = static_cast<uint32_t>(data.size() - 1);
+        if (pos != last)
+        {
+            data[pos] = std::move(data[last]);
+            entities[pos] = entities[last];
+            sparse[entityIndex(entities[pos])] = pos;
+        }
+        data.pop_back();
+        entities.pop_back();
+        sparse[idx] = NPOS;
+    }
+
+    std::size_t size() const override
+    {
+        return data.size();
+    }
+};
+
+/**
+ * @brief Next free component id (shared by every ECS instance).
+ */
+inline std::size_t nextComponentId()
+{
+    static std::size_t next = 0;
+    return next++;
+}
+
+/**
+ * @brief Dense id of a component type, assigned on first use and cached per type.
+ *
+ * Used both as the signature bit and as the index of the type's storage.
+ * @tparam T The component type.
+ */
+template <typename T> std::size_t componentId()
+{
+    static const std::size_t id = nextComponentId();
+    assert(id < MAX_COMPONENTS && "too many component types, raise MAX_COMPONENTS");
+    return id;
+}
+
+/**
+ * @class View
+ * @brief Entities owning every component of Ts, with their storages resolved once.
+ *
+ * Obtained from ECS::view(); meant to be built once per system update. Iteration walks
+ * the packed entity list of the smallest storage and filters on the signature.
+ * Entities must not be created or destroyed while iterating.
+ *
+ * @tparam Ts The required component types.
+ */
+template <typename... Ts> class View
+{
+  public:
+    /**
+     * @brief Builds a view over the given storages.
+     * @param signatures Signature of each entity slot.
+     * @param arrays Storage of each component type, in the order of Ts.
+     */
+    View(const std::vector<Signature> &signatures, ComponentArray<Ts> *...arrays)
+        : _signatures(&signatures), _arrays(arrays...)
+    {
+        (_mask.set(componentId<Ts>()), ...);
+        ((_driver = (!_driver || arrays->entities.size() < _driver->size()) ? &arrays->entities : _driver), ...);
+    }
+
+    /**
+     * @brief Component of an entity in the view.
+     * @tparam T One of Ts.
+     * @param e The entity ID.
+     */
+    template <typename T> T &get(Entity e)
+    {
+        return std::get<ComponentArray<T> *>(_arrays)->get(e);
+    }
+
+    /**
+     * @brief Checks whether a live entity owns every component of the view.
+     * @param e The entity ID.
+     */
+    bool contains(Entity e) const
+    {
+        uint32_t idx = entityIndex(e);
+        return idx < _signatures->size() && ((*_signatures)[idx] & _mask) == _mask;
+    }
+
+    /**
+     * @brief Calls fn(entity, components...) for every entity in the view.
+     * @param fn Callable taking (Entity, Ts &...).
+     */
+    template <typename F> void each(F &&fn)
+    {
+        for (Entity e : *_driver)
+        {
+            if (((*_signatures)[entityIndex(e)] & _mask) == _mask)
+                fn(e, std::get<ComponentArray<Ts> *>(_arrays)->get(e)...);
+        }
     }
+
+    /**
+     * @brief Upper bound of the number of entities in the view.
+     */
+    std::size_t sizeHint() const
+    {
+        return _driver->size();
+    }
+
+  private:
+    const std::vector<Signature> *_signatures;
+    std::tuple<ComponentArray<Ts> *...> _arrays;
+    const std::vector<Entity> *_driver = nullptr;
+    Signature _mask;
 };
 
 /**
@@ -87,26 +279,79 @@ template <typename T> class ComponentArray : public IComponentArray
  * @brief Entity Component System implementation.
  *
  * Manages entities, components, and their associations using a data-oriented architecture.
+ * Destroyed entity slots are recycled with a new generation.
  */
 class ECS
 {
   public:
     /**
-     * @brief Constructor initializing entity signatures.
+     * @brief Constructor reserving room for the usual entity count.
      */
     ECS()
     {
-        signatures.resize(MAX_ENTITIES);
+        signatures.reserve(MAX_ENTITIES);
+        generations.reserve(MAX_ENTITIES);
     }
 
     /**
-     * @brief Creates a new entity.
+     * @brief Creates a new entity, reusing a destroyed slot when one is available.
      * @return The ID of the newly created entity.
      */
     Entity createEntity()
     {
-        static Entity next = 0;
-        return next++;
+        uint32_t idx;
+        if (!freeIndices.empty())
+        {
+            idx = freeIndices.back();
+            freeIndices.pop_back();
+        }
+        else
+        {
+            idx = static_cast<uint32_t>(generations.size());
+            generations.push_back(0);
+            signatures.emplace_back();
+        }
+        return (generations[idx] << ENTITY_INDEX_BITS) | idx;
+    }
+
+    /**
+     * @brief Destroys an entity and all its components.
+     *
+     * The handle and any copy of it become stale; isAlive() returns false for them.
+     * @param e The entity ID.
+     */
+    void destroyEntity(Entity e)
+    {
+        if (!isAlive(e))
+            return;
+        uint32_t idx = entityIndex(e);
+        const Signature &sig = signatures[idx];
+        for (std::size_t id = 0; id < storages.size(); ++id)
+        {
+            if (sig.test(id))
+                storages[id]->remove(e);
+        }
+        signatures[idx].reset();
+        generations[idx] = (generations[idx] + 1) & (0xFFFFFFFFu >> ENTITY_INDEX_BITS);
+        freeIndices.push_back(idx);
+    }
+
+    /**
+     * @brief Checks whether a handle still refers to a live entity.
+     * @param e The entity ID.
+     */
+    bool isAlive(Entity e) const
+    {
+        uint32_t idx = entityIndex(e);
+        return e != INVALID_ENTITY && idx < generations.size() && generations[idx] == entityGeneration(e);
+    }
+
+    /**
+     * @brief Number of live entities.
+     */
+    std::size_t aliveCount() const
+    {
+        return generations.size() - freeIndices.size();
     }
 
     /**
@@ -117,16 +362,21 @@ class ECS
      */
     template <typename T> void addComponent(Entity e, const T &c)
     {
-        std::type_index type = typeid(T);
-
-        if (!storages.count(type))
-        {
-            storages[type] = std::make_unique<ComponentArray<T>>();
-        }
-        auto *storage = static_cast<ComponentArray<T> *>(storages[type].get());
-        storage->add(e, c);
+        storage<T>().add(e, c);
+        signatures[entityIndex(e)].set(getComponentTypeIndex<T>());
+    }
 
-        signatures[e].set(getComponentTypeIndex<T>());
+    /**
+     * @brief Removes a component from an entity.
+     * @tparam T The component type.
+     * @param e The entity ID.
+     */
+    template <typename T> void removeComponent(Entity e)
+    {
+        if (!hasComponent<T>(e))
+            return;
+        storage<T>().remove(e);
+        signatures[entityIndex(e)].reset(getComponentTypeIndex<T>());
     }
 
     /**
@@ -137,7 +387,7 @@ class ECS
      */
     template <typename T> T &getComponent(Entity e)
     {
-        return static_cast<ComponentArray<T> *>(storages[typeid(T)].get())->get(e);
+        return storage<T>().get(e);
     }
 
     /**
@@ -148,20 +398,38 @@ class ECS
      */
     template <typename T> bool hasComponent(Entity e) const
     {
-        auto idx = const_cast<ECS *>(this)->getComponentTypeIndex<T>();
-        if (e >= signatures.size())
-            return false;
-        return signatures[e].test(idx);
+        return isAlive(e) && signatures[entityIndex(e)].test(componentId<T>());
     }
 
     /**
      * @brief Retrieves all components of a specific type.
      * @tparam T The component type.
-     * @return Reference to the vector of all components of this type.
+     * @return Reference to the packed vector of all components of this type.
      */
     template <typename T> std::vector<T> &getAllComponents()
     {
-        return static_cast<ComponentArray<T> *>(storages[typeid(T)].get())->data;
+        return storage<T>().data;
+    }
+
+    /**
+     * @brief View over the entities owning every component of Ts.
+     * @tparam Ts The required component types.
+     */
+    template <typename... Ts> View<Ts...> view()
+    {
+        return View<Ts...>(signatures, &storage<Ts>()...);
+    }
+
+    /**
+     * @brief Calls fn(entity, components...) for every entity owning all the given components.
+     *
+     * Shorthand for view<Ts...>().each(fn).
+     * @tparam Ts The required component types.
+     * @param fn Callable taking (Entity, Ts &...).
+     */
+    template <typename... Ts, typename F> void each(F &&fn)
+    {
+        view<Ts...>().each(std::forward<F>(fn));
     }
 
     /**
@@ -169,10 +437,9 @@ class ECS
      * @tparam T The component type.
      * @return Unique type index for this component.
      */
-    template <typename T> size_t getComponentTypeIndex()
+    template <typename T> static size_t getComponentTypeIndex()
     {
-        static size_t index = nextComponentIndex++;
-        return index;
+        return componentId<T>();
     }
 
     /**
@@ -182,11 +449,23 @@ class ECS
      */
     Signature getSignature(Entity e) const
     {
-        return signatures[e];
+        return signatures[entityIndex(e)];
     }
 
   private:
-    std::vector<Signature> signatures;                                              /**< Entity component signatures */
-    std::unordered_map<std::type_index, std::unique_ptr<IComponentArray>> storages; /**< Component storages */
-    static inline size_t nextComponentIndex = 0; /**< Next available component type index */
+    /**
+     * @brief Typed storage of T, created on first use.
+     */
+    template <typename T> ComponentArray<T> &storage()
+    {
+        auto &slot = storages[componentId<T>()];
+        if (!slot)
+            slot = std::make_unique<ComponentArray<T>>();
+        return *static_cast<ComponentArray<T> *>(slot.get());
+    }
+
+    std::vector<Signature> signatures;                                     /**< Signature per entity slot */
+    std::vector<uint32_t> generations;                                     /**< Generation per entity slot */
+    std::vector<uint32_t> freeIndices;                                     /**< Destroyed slots to recycle */
+    std::array<std::unique_ptr<IComponentArray>, MAX_COMPONENTS> storages; /**< Storage per component id */
 };
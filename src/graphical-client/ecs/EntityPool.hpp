@@ -0,0 +1,76 @@
+/*
+** EPITECH PROJECT, 2025
+** rtype
+** File description:
+** EntityPool
+*/
+
+#pragma once
+#include "Core.hpp"
+#include <vector>
+
+/**
+ * @class EntityPool
+ * @brief Parks dead entities so the next spawn of the same kind reuses them.
+ *
+ * Parking removes the Anchor component, which every system iterates on, so a parked
+ * entity is neither moved nor drawn but keeps its other components (sprite, velocity...)
+ * ready for reuse. Re-adding the Anchor on acquire brings it back.
+ *
+ * @tparam Anchor Component removed while the entity is parked.
+ */
+template <typename Anchor> class EntityPool
+{
+  public:
+    /**
+     * @brief Takes a parked entity and gives it back its anchor component.
+     * @param ecs ECS owning the entity.
+     * @param anchor Anchor component of the revived entity.
+     * @return The revived entity, or INVALID_ENTITY if the pool is empty.
+     */
+    Entity acquire(ECS &ecs, const Anchor &anchor)
+    {
+        while (!_parked.empty())
+        {
+            Entity e = _parked.back();
+            _parked.pop_back();
+            if (!ecs.isAlive(e))
+                continue;
+            ecs.addComponent(e, anchor);
+            return e;
+        }
+        return INVALID_ENTITY;
+    }
+
+    /**
+     * @brief Parks an entity until the next acquire().
+     * @param ecs ECS owning the entity.
+     * @param e The entity to park.
+     */
+    void release(ECS &ecs, Entity e)
+    {
+        if (!ecs.isAlive(e))
+            return;
+        ecs.removeComponent<Anchor>(e);
+        _parked.push_back(e);
+    }
+
+    /**
+     * @brief Number of parked entities.
+     */
+    std::size_t size() const
+    {
+        return _parked.size();
+    }
+
+    /**
+     * @brief Forgets every parked entity (call when the ECS itself is reset).
+     */
+    void clear()
+    {
+        _parked.clear();
+    }
+
+  private:
+    std::vector<Entity> _parked; /**< Parked entities, most recent last */
+};
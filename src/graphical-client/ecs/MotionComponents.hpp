@@ -0,0 +1,81 @@
+/*
+** EPITECH PROJECT, 2025
+** rtype
+** File description:
+** MotionComponents
+*/
+
+#ifndef MOTIONCOMPONENTS_HPP_
+#define MOTIONCOMPONENTS_HPP_
+#pragma once
+
+#include <cstdint>
+
+// Components with no raylib dependency, so tools such as rtype-bench can use them as is.
+
+/**
+ * @class Position
+ * @brief Represents the 2D position of an entity.
+ *
+ * Stores X and Y coordinates for game world positioning.
+ */
+class Position
+{
+  public:
+    float x; /**< X coordinate */
+    float y; /**< Y coordinate */
+
+    /**
+     * @brief Constructor for Position.
+     * @param x X coordinate (default: 0).
+     * @param y Y coordinate (default: 0).
+     */
+    Position(float x = 0, float y = 0) : x(x), y(y)
+    {
+    }
+};
+
+/**
+ * @class Velocity
+ * @brief Represents the velocity of an entity.
+ *
+ * Stores X and Y velocity components for movement.
+ */
+class Velocity
+{
+  public:
+    float vx; /**< X velocity component */
+    float vy; /**< Y velocity component */
+
+    /**
+     * @brief Constructor for Velocity.
+     * @param vx X velocity (default: 0).
+     * @param vy Y velocity (default: 0).
+     */
+    Velocity(float vx = 0, float vy = 0) : vx(vx), vy(vy)
+    {
+    }
+};
+
+/**
+ * @struct PreviousPosition
+ * @brief Position at the previous simulation step, rendered interpolated toward Position.
+ *
+ * Marks the entities advanced by MovementSystem at the fixed simulation rate.
+ */
+struct PreviousPosition
+{
+    float x = 0.0f; /**< X coordinate one step ago */
+    float y = 0.0f; /**< Y coordinate one step ago */
+};
+
+/**
+ * @struct MonsterKind
+ * @brief Server monster type of an entity, used to return it to the right pool.
+ */
+struct MonsterKind
+{
+    uint8_t type = 0; /**< Monster type from the snapshot */
+};
+
+#endif /* !MOTIONCOMPONENTS_HPP_ */
@@ -77,6 +77,18 @@ class InputSystem
         return it != _keyMap.end() ? it->second : KEY_NULL;
     };
 
+    /**
+     * @brief Remembers a shoot key press until the next update().
+     *
+     * Called every rendered frame: key presses only last one frame, while update() runs
+     * at the simulation rate.
+     */
+    void latch()
+    {
+        if (Raylib::Input::isKeyPressed(_keyMap[SHOOT]))
+            _shootQueued = true;
+    }
+
     /**
      * @brief Updates input state and sends player commands to the server.
      *
@@ -89,6 +101,7 @@ class InputSystem
      */
     void update(NetworkClient &net, const Position &pos, Velocity &vel)
     {
+        latch();
         bool moved = false;
         NetworkClient::MoveCmd cmd = NetworkClient::MoveCmd::Up;
 
@@ -129,8 +142,9 @@ class InputSystem
                           cmd);
         }
 
-        if (Raylib::Input::isKeyPressed(_keyMap[SHOOT]))
+        if (_shootQueued)
         {
+            _shootQueued = false;
             const int8_t bvx = 2;
             const int8_t bvy = 0;
             float startX = pos.x + 4.0f;
@@ -143,44 +157,61 @@ class InputSystem
   private:
     NetworkClient::MoveCmd _lastDir = NetworkClient::MoveCmd::Right;
     std::unordered_map<uint8_t, KeyboardKey> _keyMap;
+    bool _shootQueued = false;
 };
 
 /**
  * @class MovementSystem
  * @brief Handles entity position updates based on velocity.
  *
- * Updates entity positions using a fixed tick duration (32ms) to match server updates
- * and prevent frame-rate dependent velocity accumulation.
+ * Runs once per fixed simulation step (see FrameScheduler), so velocities are applied at
+ * the server tick rate whatever the frame rate: begin() before the snapshot syncs, step()
+ * after them, and rendering interpolates between the two. Only entities carrying a
+ * PreviousPosition are moved, so the locally controlled player is left to the input system.
  */
 class MovementSystem
 {
   public:
     /**
-     * @brief Updates entity position based on velocity with fixed time stepping.
+     * @brief Remembers where every moving entity starts this step, before snapshots and velocities move it.
      * @param ecs Reference to the ECS system.
-     * @param e The entity to update.
-     * @param dt Delta time since last frame.
      */
-    void update(ECS &ecs, Entity e, float dt)
+    void begin(ECS &ecs)
     {
-        auto &pos = ecs.getComponent<Position>(e);
-        auto &vel = ecs.getComponent<Velocity>(e);
+        ecs.each<Position, PreviousPosition>([](Entity, Position &pos, PreviousPosition &prev) {
+            prev.x = pos.x;
+            prev.y = pos.y;
+        });
+    }
 
-        float &acc = _accumulator[e];
-        acc += dt;
-        constexpr float tickDuration = 0.032f;
-        while (acc >= tickDuration)
-        {
+    /**
+     * @brief Advances every moving entity by one simulation step, in one pass over the packed arrays.
+     * @param ecs Reference to the ECS system.
+     */
+    void step(ECS &ecs)
+    {
+        ecs.each<Position, Velocity, PreviousPosition>([](Entity, Position &pos, Velocity &vel, PreviousPosition &) {
             pos.x += vel.vx;
             pos.y += vel.vy;
-            acc -= tickDuration;
-        }
+        });
     }
-
-  private:
-    std::unordered_map<Entity, float> _accumulator;
 };
 
+/**
+ * @brief Position an entity is drawn at: between its previous and current step when it moves at the simulation rate.
+ * @param previous View over PreviousPosition.
+ * @param e The entity.
+ * @param pos Current position.
+ * @param alpha Interpolation factor in [0, 1].
+ */
+inline Position interpolate(View<PreviousPosition> &previous, Entity e, const Position &pos, float alpha)
+{
+    if (!previous.contains(e))
+        return pos;
+    const auto &prev = previous.get<PreviousPosition>(e);
+    return Position{prev.x + (pos.x - prev.x) * alpha, prev.y + (pos.y - prev.y) * alpha};
+}
+
 /**
  * @class CircleRenderSystem
  * @brief Renders circle-based entities.
@@ -191,15 +222,14 @@ class CircleRenderSystem
 {
   public:
     /**
-     * @brief Renders a circle entity to the screen.
+     * @brief Renders every circle entity to the screen.
      * @param ecs Reference to the ECS system.
-     * @param e The entity to render.
      */
-    void update(ECS &ecs, Entity e)
+    void update(ECS &ecs)
     {
-        auto &pos = ecs.getComponent<Position>(e);
-        auto &circle = ecs.getComponent<CircleComponent>(e);
-        Raylib::Draw::circle((int)(pos.x * 5), (int)(pos.y * 5), circle.radius, circle.color);
+        ecs.each<Position, CircleComponent>([](Entity, Position &pos, CircleComponent &circle) {
+            Raylib::Draw::circle((int)(pos.x * 5), (int)(pos.y * 5), circle.radius, circle.color);
+        });
     }
 };
 
@@ -226,22 +256,45 @@ class RectangleRenderSystem
     }
 
     /**
-     * @brief Renders a rectangle entity to the screen.
-     * @param ecs Reference to the ECS system.
-     * @param e The entity to render.
+     * @brief Sets the draw layer of rectangles queued on a draw list.
+     * @param layer Draw layer.
+     */
+    void setLayer(int layer)
+    {
+        _layer = layer;
+    }
+
+    /**
+     * @brief Sets how far between the previous and the current step entities are drawn.
+     * @param alpha Interpolation factor in [0, 1].
      */
-    void update(ECS &ecs, Entity e)
+    void setInterpolation(float alpha)
     {
-        auto &pos = ecs.getComponent<Position>(e);
-        auto &rect = ecs.getComponent<RectangleComponent>(e);
+        _alpha = alpha;
+    }
 
-        float screenX = _offsetX + (pos.x / 255.0f) * _areaSize;
-        float screenY = _offsetY + (pos.y / 255.0f) * _areaSize;
+    /**
+     * @brief Queues every rectangle entity on a draw list, to be batched.
+     * @param ecs Reference to the ECS system.
+     * @param list Frame draw list.
+     */
+    void update(ECS &ecs, Raylib::DrawList &list)
+    {
+        auto previous = ecs.view<PreviousPosition>();
+        ecs.each<Position, RectangleComponent>([this, &list, &previous](Entity e, Position &pos,
+                                                                        RectangleComponent &rect) {
+            Position drawn = interpolate(previous, e, pos, _alpha);
+            float screenX = (float)(int)(_offsetX + (drawn.x / 255.0f) * _areaSize);
+            float screenY = (float)(int)(_offsetY + (drawn.y / 255.0f) * _areaSize);
 
-        Raylib::Draw::rectangle((int)screenX, (int)screenY, rect.width, rect.height, rect.color);
+            list.rect({screenX, screenY, (float)rect.width, (float)rect.height},
+                      {rect.color.r, rect.color.g, rect.color.b, rect.color.a}, _layer);
+        });
     }
 
   private:
+    int _layer = 1;
+    float _alpha = 1.0f;
     float _offsetX = 0.0f;
     float _offsetY = 0.0f;
     float _areaSize = 1280.0f;
@@ -281,28 +334,49 @@ class SpriteRenderSystem
     }
 
     /**
-     * @brief Updates and renders an animated sprite entity.
+     * @brief Sets how far between the previous and the current step entities are drawn.
+     * @param alpha Interpolation factor in [0, 1].
+     */
+    void setInterpolation(float alpha)
+    {
+        _alpha = alpha;
+    }
+
+    /**
+     * @brief Animates every sprite entity and queues it on a draw list, to be batched.
      * @param ecs Reference to the ECS system.
-     * @param e The entity to render.
      * @param dt Delta time since last frame for animation updates.
+     * @param list Frame draw list.
      */
-    void update(ECS &ecs, Entity e, float dt)
+    void update(ECS &ecs, float dt, Raylib::DrawList &list)
     {
-        auto &pos = ecs.getComponent<Position>(e);
-        auto &sprite = ecs.getComponent<Sprite>(e);
+        auto previous = ecs.view<PreviousPosition>();
+        ecs.each<Position, Sprite>([this, dt, &list, &previous](Entity e, Position &pos, Sprite &sprite) {
+            if (!sprite.sprite)
+                return;
 
-        if (!sprite.sprite)
-            return;
+            Position drawn = interpolate(previous, e, pos, _alpha);
+            float screenX = _offsetX + (drawn.x / 255.0f) * _areaSize;
+            float screenY = _offsetY + (drawn.y / 255.0f) * _areaSize;
 
-        float screenX = _offsetX + (pos.x / 255.0f) * _areaSize;
-        float screenY = _offsetY + (pos.y / 255.0f) * _areaSize;
+            sprite.sprite->setPosition({screenX, screenY});
+            sprite.sprite->update(dt);
+            sprite.sprite->queue(list, _layer);
+        });
+    }
 
-        sprite.sprite->setPosition({screenX, screenY});
-        sprite.sprite->update(dt);
-        sprite.sprite->draw();
+    /**
+     * @brief Sets the draw layer of sprites queued on a draw list.
+     * @param layer Draw layer.
+     */
+    void setLayer(int layer)
+    {
+        _layer = layer;
     }
 
   private:
+    int _layer = 0;
+    float _alpha = 1.0f;
     float _scaleX = 1.0f;
     float _scaleY = 1.0f;
     float _offsetX = 0.0f;
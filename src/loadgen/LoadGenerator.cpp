@@ -0,0 +1,464 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Headless bot load generator
+*/
+
+#include "LoadGenerator.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+namespace
+{
+constexpr auto kHelloInterval = std::chrono::seconds(1);
+constexpr auto kKeepAliveInterval = std::chrono::seconds(4);
+constexpr auto kSnapshotTimeout = std::chrono::seconds(10);
+constexpr auto kHandshakeTimeout = std::chrono::seconds(5);
+constexpr int kPollTimeoutMs = 2;
+constexpr int8_t kSpeed = 5;
+
+uint64_t elapsedUs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+{
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+    return us > 0 ? static_cast<uint64_t>(us) : 0;
+}
+
+void printLatency(const char *name, const Metrics::Histogram &h, const char *unit, double scale)
+{
+    std::printf("  %-20s n=%-7llu p50=%-8.2f p90=%-8.2f p99=%-8.2f max=%-8.2f %s\n", name,
+                static_cast<unsigned long long>(h.count()), h.percentile(50) * scale, h.percentile(90) * scale,
+                h.percentile(99) * scale, h.max() * scale, unit);
+}
+} // namespace
+
+LoadGenerator::LoadGenerator(const Options &options) : _options(options)
+{
+    _options.perLobby = std::max<std::size_t>(1, _options.perLobby);
+    _options.rampPerSec = std::max(1, _options.rampPerSec);
+    _bots.resize(_options.bots);
+    for (std::size_t i = 0; i < _bots.size(); ++i)
+    {
+        _bots[i].index = i;
+        _bots[i].group = i / _options.perLobby;
+        _bots[i].rng = static_cast<uint32_t>(0x9E3779B9u * (i + 1));
+    }
+    _lobbyCodes.resize((_options.bots + _options.perLobby - 1) / _options.perLobby);
+}
+
+bool LoadGenerator::parsePattern(const std::string &name, Pattern &out)
+{
+    if (name == "idle")
+        out = Pattern::Idle;
+    else if (name == "sweep")
+        out = Pattern::Sweep;
+    else if (name == "zigzag")
+        out = Pattern::Zigzag;
+    else if (name == "random")
+        out = Pattern::Random;
+    else
+        return false;
+    return true;
+}
+
+int LoadGenerator::run()
+{
+    _start = Clock::now();
+    _windowStart = _start;
+    const auto end = _start + std::chrono::seconds(_options.durationSec);
+    auto nextReport = _start + std::chrono::seconds(_options.reportIntervalSec);
+    std::vector<pollfd> fds;
+    std::vector<std::size_t> owners;
+
+    for (auto now = _start; now < end; now = Clock::now())
+    {
+        // Ramp: start the bots due by now; their connect and handshake complete through the poll below.
+        auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - _start).count();
+        std::size_t due = std::min<std::size_t>(
+            _bots.size(), static_cast<std::size_t>(elapsedMs * _options.rampPerSec / 1000 + 1));
+        while (_started < due)
+            startBot(_bots[_started++], Clock::now());
+
+        fds.clear();
+        owners.clear();
+        for (const auto &bot : _bots)
+        {
+            if (!bot.net || bot.phase == Phase::Failed)
+                continue;
+            // A connecting socket reports the end of connect() as writable.
+            short tcpEvents = static_cast<short>(POLLIN | (bot.net->isConnecting() ? POLLOUT : 0));
+            for (socket_t fd : {bot.net->getTcpFd(), bot.net->getUdpFd()})
+            {
+                if (fd == INVALID_SOCKET_FD)
+                    continue;
+                fds.push_back({fd, fd == bot.net->getTcpFd() ? tcpEvents : static_cast<short>(POLLIN), 0});
+                owners.push_back(bot.index);
+            }
+        }
+        int ready = fds.empty() ? 0 : POLL(fds.data(), static_cast<unsigned>(fds.size()), kPollTimeoutMs);
+        now = Clock::now();
+        if (_options.netem.enabled())
+        {
+            // Delayed datagrams fall due without any socket becoming readable.
+            for (auto &bot : _bots)
+            {
+                if (bot.net && bot.phase != Phase::Failed && bot.net->pumpImpairment())
+                    handleEvents(bot, now);
+            }
+        }
+        std::size_t lastOwner = _bots.size();
+        for (std::size_t i = 0; ready > 0 && i < fds.size(); ++i)
+        {
+            // A bot's two sockets are adjacent: drain each bot once.
+            if (fds[i].revents == 0 || owners[i] == lastOwner)
+                continue;
+            lastOwner = owners[i];
+            Bot &bot = _bots[owners[i]];
+            for (int n = 0; n < 64 && bot.net->pollPackets(); ++n)
+            {
+            }
+            handleEvents(bot, now);
+        }
+
+        for (auto &bot : _bots)
+        {
+            if (bot.net && bot.phase != Phase::Failed)
+                drive(bot, now);
+        }
+        if (_options.reportIntervalSec > 0 && now >= nextReport)
+        {
+            printProgress(now);
+            nextReport += std::chrono::seconds(_options.reportIntervalSec);
+        }
+    }
+    printReport(Clock::now());
+    std::size_t played = 0;
+    for (auto &bot : _bots)
+    {
+        if (bot.snapshots > 0)
+            ++played;
+        if (bot.net)
+            bot.net->disconnect();
+    }
+    return played > 0 ? 0 : 1;
+}
+
+void LoadGenerator::startBot(Bot &bot, Clock::time_point now)
+{
+    bot.net = std::make_unique<NetworkClient>(_options.host, _options.port);
+    bot.net->setPseudo("bot" + std::to_string(bot.index));
+    bot.net->setVerbose(false);
+    if (_options.netem.enabled())
+    {
+        auto netem = _options.netem;
+        netem.seed += static_cast<uint32_t>(bot.index) * 2; // each client uses seed and seed + 1
+        bot.net->setImpairment(netem);
+    }
+    bot.handshakeStart = now;
+    if (!bot.net->beginConnect())
+    {
+        fail(bot, "connect failed");
+        return;
+    }
+    bot.phase = Phase::Handshake;
+}
+
+void LoadGenerator::sendJoin(Bot &bot, Clock::time_point now)
+{
+    bool leader = bot.index % _options.perLobby == 0;
+    bool sent = leader ? bot.net->sendCreateLobby() : bot.net->sendJoinLobby(_lobbyCodes[bot.group]);
+    if (!sent)
+    {
+        fail(bot, "lobby request not sent");
+        return;
+    }
+    bot.joinSent = now;
+    bot.phase = Phase::Joining;
+}
+
+void LoadGenerator::handleEvents(Bot &bot, Clock::time_point now)
+{
+    for (const auto &ev : bot.net->getEvents())
+    {
+        switch (ev.type)
+        {
+        case NetEventType::Connected:
+            if (bot.phase != Phase::Handshake)
+                break;
+            _handshakeUs.record(elapsedUs(bot.handshakeStart, now));
+            bot.nextKeepAlive = now + kKeepAliveInterval;
+            if (bot.index % _options.perLobby == 0)
+                sendJoin(bot, now);
+            else
+                bot.phase = Phase::WaitLeader;
+            break;
+        case NetEventType::LobbyOk:
+            if (bot.phase != Phase::Joining)
+                break;
+            _lobbyJoinUs.record(elapsedUs(bot.joinSent, now));
+            if (bot.index % _options.perLobby == 0)
+                _lobbyCodes[bot.group] = ev.text;
+            bot.phase = Phase::Hello;
+            bot.nextHello = now;
+            break;
+        case NetEventType::Snapshot: {
+            ++bot.snapshots;
+            ++_snapshotsInWindow;
+            bot.lastSnapshot = now;
+            if (bot.phase == Phase::Hello)
+            {
+                bot.phase = Phase::Playing;
+                bot.firstSnapshot = now;
+                _firstSnapshotMs.record(elapsedUs(bot.joinSent, now) / 1000);
+                bot.nextInput = now;
+                bot.nextShoot = now;
+                bot.nextPing = now;
+            }
+            bool found = false;
+            for (const auto &p : bot.net->getLastSnapshot())
+            {
+                if (p.id != bot.net->getPlayerId())
+                    continue;
+                bot.x = p.x;
+                bot.y = p.y;
+                found = p.hp > 0;
+                break;
+            }
+            if (!found && !bot.dead)
+            {
+                bot.dead = true;
+                ++_deaths;
+            }
+            break;
+        }
+        case NetEventType::Message:
+            if (ev.text == "DEAD" && !bot.dead)
+            {
+                bot.dead = true;
+                ++_deaths;
+            }
+            break;
+        case NetEventType::LobbyError:
+            fail(bot, "lobby error");
+            break;
+        case NetEventType::Refused:
+            fail(bot, "refused");
+            break;
+        case NetEventType::Timeout:
+            fail(bot, "connection lost");
+            break;
+        case NetEventType::PingSendFail:
+            fail(bot, "pong not sent");
+            break;
+        default:
+            break;
+        }
+        if (bot.phase == Phase::Failed)
+            return;
+    }
+    bot.net->clearEvents();
+
+    uint32_t pongs = bot.net->getUdpPongCount();
+    if (pongs != bot.pongsSeen)
+    {
+        bot.pongsSeen = pongs;
+        _rttMs.record(static_cast<uint64_t>(std::max(0, bot.net->getUdpPingMs())));
+    }
+}
+
+void LoadGenerator::drive(Bot &bot, Clock::time_point now)
+{
+    if (bot.phase == Phase::Handshake)
+    {
+        if (now - bot.handshakeStart > kHandshakeTimeout)
+            fail(bot, "handshake timed out");
+        return;
+    }
+    if (!bot.net->isConnected())
+    {
+        fail(bot, "disconnected");
+        return;
+    }
+    if (now >= bot.nextKeepAlive)
+    {
+        bot.net->sendPong();
+        bot.nextKeepAlive = now + kKeepAliveInterval;
+    }
+    switch (bot.phase)
+    {
+    case Phase::WaitLeader: {
+        const Bot &leader = _bots[bot.group * _options.perLobby];
+        if (!_lobbyCodes[bot.group].empty())
+            sendJoin(bot, now);
+        else if (leader.phase == Phase::Failed)
+            fail(bot, "lobby leader failed");
+        break;
+    }
+    case Phase::Joining:
+        if (now - bot.joinSent > kSnapshotTimeout)
+            fail(bot, "no LOBBY_OK");
+        break;
+    case Phase::Hello:
+        if (now - bot.joinSent > kSnapshotTimeout)
+        {
+            fail(bot, "no snapshot");
+            break;
+        }
+        if (now >= bot.nextHello)
+        {
+            bot.net->sendHelloUdp(0, 0);
+            bot.nextHello = now + kHelloInterval;
+        }
+        break;
+    case Phase::Playing:
+        if (now >= bot.nextPing)
+        {
+            bot.net->sendUdpPing();
+            bot.nextPing = now + std::chrono::milliseconds(_options.pingIntervalMs);
+        }
+        if (bot.dead)
+            break;
+        if (_options.pattern != Pattern::Idle && now >= bot.nextInput)
+        {
+            int8_t vx = 0;
+            int8_t vy = 0;
+            NetworkClient::MoveCmd dir = steer(bot, now, vx, vy);
+            bot.net->sendInput(bot.x, bot.y, vx, vy, dir);
+            bot.nextInput = now + std::chrono::milliseconds(_options.inputIntervalMs);
+        }
+        if (_options.shootIntervalMs > 0 && now >= bot.nextShoot)
+        {
+            bot.net->sendShoot(static_cast<uint8_t>(std::min(bot.x + 4, 255)),
+                               static_cast<uint8_t>(std::min(bot.y + 1, 255)), 2, 0);
+            bot.nextShoot = now + std::chrono::milliseconds(_options.shootIntervalMs);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+NetworkClient::MoveCmd LoadGenerator::steer(Bot &bot, Clock::time_point now, int8_t &vx, int8_t &vy)
+{
+    // Offset each bot in time so a lobby does not move in lockstep.
+    long long t = std::chrono::duration_cast<std::chrono::milliseconds>(now - _start).count() +
+                  static_cast<long long>(bot.index) * 137;
+    switch (_options.pattern)
+    {
+    case Pattern::Sweep:
+        switch ((t / 500) % 6)
+        {
+        case 0:
+        case 1:
+            vy = -kSpeed;
+            return NetworkClient::MoveCmd::Up;
+        case 2:
+            vx = kSpeed;
+            return NetworkClient::MoveCmd::Right;
+        case 3:
+        case 4:
+            vy = kSpeed;
+            return NetworkClient::MoveCmd::Down;
+        default:
+            vx = -kSpeed;
+            return NetworkClient::MoveCmd::Left;
+        }
+    case Pattern::Zigzag:
+        vx = (t / 2000) % 2 ? -kSpeed : kSpeed;
+        vy = (t / 500) % 2 ? kSpeed : -kSpeed;
+        return vy > 0 ? NetworkClient::MoveCmd::Down : NetworkClient::MoveCmd::Up;
+    case Pattern::Random:
+        if (now >= bot.nextTurn)
+        {
+            bot.rng ^= bot.rng << 13;
+            bot.rng ^= bot.rng >> 17;
+            bot.rng ^= bot.rng << 5;
+            bot.dir = static_cast<NetworkClient::MoveCmd>(bot.rng % 4);
+            bot.nextTurn = now + std::chrono::milliseconds(200 + bot.rng % 400);
+        }
+        if (bot.dir == NetworkClient::MoveCmd::Left || bot.dir == NetworkClient::MoveCmd::Right)
+            vx = bot.dir == NetworkClient::MoveCmd::Right ? kSpeed : -kSpeed;
+        else
+            vy = bot.dir == NetworkClient::MoveCmd::Down ? kSpeed : -kSpeed;
+        return bot.dir;
+    default:
+        return NetworkClient::MoveCmd::Right;
+    }
+}
+
+void LoadGenerator::fail(Bot &bot, const char *reason)
+{
+    if (bot.phase == Phase::Failed)
+        return;
+    std::cerr << "[LOADGEN] bot " << bot.index << ": " << reason << "\n";
+    bot.phase = Phase::Failed;
+    ++_failed;
+    if (bot.net)
+        bot.net->disconnect();
+}
+
+void LoadGenerator::printProgress(Clock::time_point now)
+{
+    std::size_t playing = 0;
+    for (const auto &bot : _bots)
+        playing += bot.phase == Phase::Playing;
+    double window = std::chrono::duration<double>(now - _windowStart).count();
+    double elapsed = std::chrono::duration<double>(now - _start).count();
+    std::printf("[LOADGEN] t=%.0fs started=%zu playing=%zu failed=%zu snapshots=%.0f/s rtt p50=%llu p99=%llu ms\n",
+                elapsed, _started, playing, _failed, window > 0 ? _snapshotsInWindow / window : 0.0,
+                static_cast<unsigned long long>(_rttMs.percentile(50)),
+                static_cast<unsigned long long>(_rttMs.percentile(99)));
+    std::fflush(stdout);
+    _snapshotsInWindow = 0;
+    _windowStart = now;
+}
+
+void LoadGenerator::printReport(Clock::time_point now)
+{
+    Metrics::Histogram snapshotRate; // hundredths of a snapshot per second, per bot
+    Metrics::Histogram loss;         // hundredths of a percent, per bot
+    std::size_t playing = 0;
+    uint64_t snapshots = 0;
+    for (const auto &bot : _bots)
+    {
+        snapshots += bot.snapshots;
+        if (bot.snapshots == 0)
+            continue;
+        playing += bot.phase == Phase::Playing;
+        double seconds = std::chrono::duration<double>(now - bot.firstSnapshot).count();
+        if (seconds > 1.0)
+            snapshotRate.record(static_cast<uint64_t>(bot.snapshots / seconds * 100.0));
+        loss.record(static_cast<uint64_t>(bot.net->getUdpLossPct() * 100.0f));
+    }
+    double elapsed = std::chrono::duration<double>(now - _start).count();
+    std::printf("[LOADGEN] %.1fs, %zu/%zu bots started, %zu playing at the end, %zu failed, %zu died\n", elapsed,
+                _started, _bots.size(), playing, _failed, _deaths);
+    std::printf("[LOADGEN] %llu snapshots received (%.0f/s)\n", static_cast<unsigned long long>(snapshots),
+                elapsed > 0 ? snapshots / elapsed : 0.0);
+    printLatency("handshake", _handshakeUs, "ms", 0.001);
+    printLatency("lobby join", _lobbyJoinUs, "ms", 0.001);
+    printLatency("first snapshot", _firstSnapshotMs, "ms", 1.0);
+    printLatency("udp rtt", _rttMs, "ms", 1.0);
+    printLatency("snapshot rate/bot", snapshotRate, "Hz", 0.01);
+    printLatency("snapshot loss/bot", loss, "%", 0.01);
+    if (_options.netem.enabled())
+    {
+        Network::TransportLayer::Impairment::Stats total;
+        for (const auto &bot : _bots)
+        {
+            if (!bot.net)
+                continue;
+            auto s = bot.net->getImpairmentStats();
+            total.submitted += s.submitted;
+            total.dropped += s.dropped;
+            total.duplicated += s.duplicated;
+            total.reordered += s.reordered;
+        }
+        std::printf("[LOADGEN] netem %s: %llu datagrams, %llu dropped, %llu duplicated, %llu reordered\n",
+                    _options.netem.describe().c_str(), static_cast<unsigned long long>(total.submitted),
+                    static_cast<unsigned long long>(total.dropped), static_cast<unsigned long long>(total.duplicated),
+                    static_cast<unsigned long long>(total.reordered));
+    }
+    std::fflush(stdout);
+}
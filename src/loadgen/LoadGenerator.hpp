@@ -0,0 +1,135 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Headless bot load generator
+*/
+
+#pragma once
+
+#include "../Metrics/Histogram.hpp"
+#include "../Network/Client/NetworkClient.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Drives many headless NetworkClient bots against a server from one thread.
+ *
+ * Bots are started at a fixed rate, grouped in lobbies (the first bot of a group creates
+ * the lobby, the others join its code), then play a scripted movement and shooting
+ * pattern. One poll() over every bot socket drives the whole fleet.
+ */
+class LoadGenerator
+{
+  public:
+    /**
+     * @brief Scripted movement of the bots.
+     */
+    enum class Pattern
+    {
+        Idle,   ///< Never moves, only shoots.
+        Sweep,  ///< Up and down, drifting left and right.
+        Zigzag, ///< Diagonals, switching direction every half second.
+        Random  ///< New random direction every few hundred milliseconds.
+    };
+
+    /**
+     * @brief Load shape and server address.
+     */
+    struct Options
+    {
+        std::string host = "127.0.0.1";
+        uint16_t port = 4243;
+        std::size_t bots = 100;           ///< Bots to run.
+        std::size_t perLobby = 4;         ///< Bots sharing a lobby.
+        int durationSec = 30;             ///< Run time once the first bot started.
+        int rampPerSec = 50;              ///< Bots started per second.
+        Pattern pattern = Pattern::Sweep; ///< Movement script.
+        int inputIntervalMs = 32;         ///< INPUT rate while moving (the server tick).
+        int shootIntervalMs = 250;        ///< 0 disables shooting.
+        int pingIntervalMs = 1000;        ///< PING_UDP rate.
+        int reportIntervalSec = 5;        ///< Progress line rate, 0 disables it.
+        /// Simulated network for every bot; bot i uses seed + 2 * i.
+        Network::TransportLayer::Impairment::Config netem;
+    };
+
+    explicit LoadGenerator(const Options &options);
+
+    /**
+     * @brief Runs the load for the configured duration and prints the report.
+     * @return 0 if at least one bot played, 1 otherwise.
+     */
+    int run();
+
+    /**
+     * @brief Parse a pattern name (idle, sweep, zigzag, random).
+     * @return false if the name is unknown.
+     */
+    static bool parsePattern(const std::string &name, Pattern &out);
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Phase
+    {
+        Pending,    ///< Not started yet.
+        Handshake,  ///< TCP connect and SERVER_HELLO/CLIENT_HELLO/OK in flight.
+        WaitLeader, ///< Waiting for the group leader's lobby code.
+        Joining,    ///< CREATE_LOBBY/JOIN_LOBBY sent, waiting for LOBBY_OK.
+        Hello,      ///< In a lobby, sending HELLO_UDP until the first snapshot.
+        Playing,    ///< Receiving snapshots and sending inputs.
+        Failed      ///< Connection refused, lost, or lobby error.
+    };
+
+    struct Bot
+    {
+        std::size_t index = 0;
+        std::size_t group = 0;
+        Phase phase = Phase::Pending;
+        std::unique_ptr<NetworkClient> net;
+        Clock::time_point handshakeStart{};
+        Clock::time_point joinSent{};
+        Clock::time_point firstSnapshot{};
+        Clock::time_point lastSnapshot{};
+        Clock::time_point nextHello{};
+        Clock::time_point nextInput{};
+        Clock::time_point nextShoot{};
+        Clock::time_point nextPing{};
+        Clock::time_point nextKeepAlive{};
+        Clock::time_point nextTurn{};
+        uint64_t snapshots = 0;
+        uint32_t pongsSeen = 0;
+        uint32_t rng = 0;
+        NetworkClient::MoveCmd dir = NetworkClient::MoveCmd::Right;
+        uint8_t x = 0;
+        uint8_t y = 0;
+        bool dead = false;
+    };
+
+    void startBot(Bot &bot, Clock::time_point now);
+    void sendJoin(Bot &bot, Clock::time_point now);
+    void handleEvents(Bot &bot, Clock::time_point now);
+    void drive(Bot &bot, Clock::time_point now);
+    void fail(Bot &bot, const char *reason);
+    NetworkClient::MoveCmd steer(Bot &bot, Clock::time_point now, int8_t &vx, int8_t &vy);
+    void printProgress(Clock::time_point now);
+    void printReport(Clock::time_point now);
+
+    Options _options;
+    std::vector<Bot> _bots;
+    std::vector<std::string> _lobbyCodes; ///< Code of each group's lobby, empty until its leader joined
+    Clock::time_point _start{};
+    std::size_t _started = 0;
+    std::size_t _failed = 0;
+    std::size_t _deaths = 0;
+    uint64_t _snapshotsInWindow = 0;
+    Clock::time_point _windowStart{};
+
+    Metrics::Histogram _handshakeUs;     ///< connect + handshake, per bot
+    Metrics::Histogram _lobbyJoinUs;     ///< CREATE/JOIN_LOBBY to LOBBY_OK, per bot
+    Metrics::Histogram _firstSnapshotMs; ///< lobby request to the first snapshot, per bot
+    Metrics::Histogram _rttMs;           ///< every UDP pong
+};
@@ -0,0 +1,87 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** rtype-loadgen entry point
+*/
+
+#include "LoadGenerator.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+void usage()
+{
+    std::cout << "usage: rtype-loadgen [--host IP] [--port N] [--bots N] [--per-lobby N] [--duration S]\n"
+                 "                     [--ramp N/s] [--pattern idle|sweep|zigzag|random] [--shoot-ms N]\n"
+                 "                     [--input-ms N] [--ping-ms N] [--report S]\n"
+                 "                     [--netem latency=MS,jitter=MS,loss=PCT,dup=PCT,reorder=PCT,seed=N]\n";
+}
+
+bool parseArgs(int argc, char **argv, LoadGenerator::Options &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "--host" && hasValue)
+            options.host = argv[++i];
+        else if (a == "--port" && hasValue)
+            options.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        else if (a == "--bots" && hasValue)
+            options.bots = static_cast<std::size_t>(std::atoi(argv[++i]));
+        else if (a == "--per-lobby" && hasValue)
+            options.perLobby = static_cast<std::size_t>(std::atoi(argv[++i]));
+        else if (a == "--duration" && hasValue)
+            options.durationSec = std::atoi(argv[++i]);
+        else if (a == "--ramp" && hasValue)
+            options.rampPerSec = std::atoi(argv[++i]);
+        else if (a == "--pattern" && hasValue)
+        {
+            if (!LoadGenerator::parsePattern(argv[++i], options.pattern))
+                return false;
+        }
+        else if (a == "--shoot-ms" && hasValue)
+            options.shootIntervalMs = std::atoi(argv[++i]);
+        else if (a == "--input-ms" && hasValue)
+            options.inputIntervalMs = std::atoi(argv[++i]);
+        else if (a == "--ping-ms" && hasValue)
+            options.pingIntervalMs = std::atoi(argv[++i]);
+        else if (a == "--report" && hasValue)
+            options.reportIntervalSec = std::atoi(argv[++i]);
+        else if (a == "--netem" && hasValue)
+        {
+            if (!Network::TransportLayer::Impairment::Config::parse(argv[++i], options.netem))
+                return false;
+        }
+        else
+            return false;
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    LoadGenerator::Options options;
+    if (!parseArgs(argc, argv, options))
+    {
+        usage();
+        return 2;
+    }
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+    {
+        return 1;
+    }
+#endif
+    LoadGenerator loadgen(options);
+    int status = loadgen.run();
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return status;
+}
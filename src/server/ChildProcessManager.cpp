@@ -9,20 +9,80 @@
 #ifdef _WIN32
 #include <Windows.h>
 #else
+#include <csignal>
+#include <fcntl.h>
+#include <fstream>
 #include <netinet/in.h>
+#include <sys/resource.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/prctl.h>
 #endif
+#endif
+#include <cerrno>
 #include <cstring>
 #include <iostream>
+#include <sstream>
 #include <vector>
 
-int ChildProcessManager::spawn(const std::string &lobby, uint16_t udpPort, const std::string &ipcSock)
+#ifndef _WIN32
+namespace
+{
+int g_sigchldPipe[2] = {-1, -1};
+
+void onSigchld(int)
+{
+    int saved = errno;
+    char one = 1;
+    ssize_t ret = ::write(g_sigchldPipe[1], &one, sizeof(one));
+    (void)ret;
+    errno = saved;
+}
+} // namespace
+#endif
+
+ChildProcessManager::ChildProcessManager(std::size_t maxChildren, ChildLimits limits)
+    : _maxChildren(maxChildren), _limits(limits)
+{
+#ifndef _WIN32
+    if (g_sigchldPipe[0] == -1 && ::pipe(g_sigchldPipe) == 0)
+    {
+        for (int fd : g_sigchldPipe)
+        {
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        struct sigaction sa
+        {
+        };
+        sa.sa_handler = onSigchld;
+        sigemptyset(&sa.sa_mask);
+        sa.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+        ::sigaction(SIGCHLD, &sa, nullptr);
+    }
+#endif
+}
+
+ChildProcessManager::~ChildProcessManager()
+{
+#ifndef _WIN32
+    if (g_sigchldPipe[0] != -1)
+    {
+        ::signal(SIGCHLD, SIG_DFL);
+        ::close(g_sigchldPipe[0]);
+        ::close(g_sigchldPipe[1]);
+        g_sigchldPipe[0] = -1;
+        g_sigchldPipe[1] = -1;
+    }
+#endif
+}
+
+int ChildProcessManager::launch(const std::vector<std::string> &extraArgs, const std::vector<int> &inheritFds)
 {
-    std::string portStr = std::to_string(udpPort);
     std::vector<char *> args;
-    ChildInfo info;
 #ifdef _WIN32
     STARTUPINFO si = {sizeof(si)};
     PROCESS_INFORMATION pi = {0};
@@ -32,14 +92,9 @@ int ChildProcessManager::spawn(const std::string &lobby, uint16_t udpPort, const
 #endif // _WIN32
 
     args.push_back(const_cast<char *>(exePath.c_str()));
-    args.push_back(const_cast<char *>("--lobby"));
-    args.push_back(const_cast<char *>(lobby.c_str()));
-    args.push_back(const_cast<char *>("--udp-port"));
-    args.push_back(const_cast<char *>(portStr.c_str()));
-    if (!ipcSock.empty())
+    for (const auto &a : extraArgs)
     {
-        args.push_back(const_cast<char *>("--ipc-port"));
-        args.push_back(const_cast<char *>(ipcSock.c_str()));
+        args.push_back(const_cast<char *>(a.c_str()));
     }
     args.push_back(nullptr);
 #ifdef _WIN32
@@ -75,13 +130,20 @@ int ChildProcessManager::spawn(const std::string &lobby, uint16_t udpPort, const
         return -1;
     }
 
-    info.pid = pi.dwProcessId;
+    (void)inheritFds;
+    int pid = static_cast<int>(pi.dwProcessId);
     CloseHandle(pi.hProcess);
     CloseHandle(pi.hThread);
-    (void)lobby;
-    (void)udpPort;
-    (void)ipcSock;
+    return pid;
 #else
+    int cpu = -1;
+    if (_limits.pinCpus)
+    {
+        long cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+        if (cpus > 0)
+            cpu = static_cast<int>(_nextCpu++ % static_cast<unsigned>(cpus));
+    }
+    pid_t parent = ::getpid();
     pid_t pid = ::fork();
     if (pid < 0)
     {
@@ -90,7 +152,41 @@ int ChildProcessManager::spawn(const std::string &lobby, uint16_t udpPort, const
     }
     if (pid == 0)
     {
-        // Child: exec the UDP server binary
+        // Child: apply limits, keep the IPC descriptors open across exec, then exec the UDP server binary
+#ifdef __linux__
+        // Die with the lobby server instead of holding the UDP port as an orphan (kept across exec).
+        ::prctl(PR_SET_PDEATHSIG, SIGTERM);
+        if (::getppid() != parent)
+            _exit(1);
+        if (cpu >= 0)
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            ::sched_setaffinity(0, sizeof(set), &set);
+        }
+#else
+        (void)cpu;
+        (void)parent;
+#endif
+        if (_limits.memoryMb > 0)
+        {
+            struct rlimit lim
+            {
+            };
+            lim.rlim_cur = static_cast<rlim_t>(_limits.memoryMb) * 1024 * 1024;
+            lim.rlim_max = lim.rlim_cur;
+            ::setrlimit(RLIMIT_AS, &lim);
+        }
+        if (_limits.niceLevel != 0)
+        {
+            ::setpriority(PRIO_PROCESS, 0, _limits.niceLevel);
+        }
+        for (int fd : inheritFds)
+        {
+            if (fd != -1)
+                ::fcntl(fd, F_SETFD, 0);
+        }
         if (::access(exePath.c_str(), X_OK) != 0)
         {
             exePath = "rtype-udp-server";
@@ -101,27 +197,229 @@ int ChildProcessManager::spawn(const std::string &lobby, uint16_t udpPort, const
         std::perror("[PARENT] execv failed");
         _exit(1);
     }
-    info.pid = pid;
+    return pid;
+#endif
+}
+
+int ChildProcessManager::spawn(const std::string &lobby, uint16_t udpPort, const std::string &ipcSock,
+                               const std::vector<int> &inheritFds)
+{
+    std::vector<std::string> args{"--lobby", lobby, "--udp-port", std::to_string(udpPort)};
+    if (!ipcSock.empty())
+    {
+        args.push_back("--ipc");
+        args.push_back(ipcSock);
+    }
+    int pid = launch(args, inheritFds);
+    if (pid < 0)
+        return -1;
 
     // Parent: track child
-#endif
+    ChildInfo info;
+    info.pid = pid;
     info.lobbyCode = lobby;
     info.udpPort = udpPort;
     info.ipcSock = ipcSock;
-    _children[lobby] = info;
+    _children[pid] = info;
     std::cout << "[PARENT] Spawned UDP server lobby=" << lobby << " port=" << udpPort << " pid=" << info.pid << "\n";
     return info.pid;
 }
 
+int ChildProcessManager::spawnIdle(uint16_t udpPort, const std::string &ipcSock, const std::vector<int> &inheritFds)
+{
+    int pid = launch({"--pooled", "--udp-port", std::to_string(udpPort), "--ipc", ipcSock}, inheritFds);
+    if (pid < 0)
+        return -1;
+
+    ChildInfo info;
+    info.pid = pid;
+    info.udpPort = udpPort;
+    info.ipcSock = ipcSock;
+    _idle[pid] = info;
+    std::cout << "[PARENT] Spawned pooled UDP server port=" << udpPort << " pid=" << pid << "\n";
+    return pid;
+}
+
+bool ChildProcessManager::assign(int pid, const std::string &lobby)
+{
+    auto it = _idle.find(pid);
+    if (it == _idle.end())
+        return false;
+    ChildInfo info = it->second;
+    _idle.erase(it);
+    info.lobbyCode = lobby;
+    _children[pid] = info;
+    return true;
+}
+
 std::optional<ChildInfo> ChildProcessManager::get(const std::string &lobby) const
 {
-    auto it = _children.find(lobby);
-    if (it == _children.end())
-        return std::nullopt;
-    return it->second;
+    for (const auto &kv : _children)
+    {
+        if (kv.second.lobbyCode == lobby && !kv.second.terminating)
+            return kv.second;
+    }
+    return std::nullopt;
+}
+
+void ChildProcessManager::terminate(const std::string &lobby)
+{
+    std::vector<int> pids;
+    for (const auto &kv : _children)
+    {
+        if (kv.second.lobbyCode == lobby && !kv.second.terminating)
+            pids.push_back(kv.first);
+    }
+    for (int pid : pids)
+        terminate(pid);
+}
+
+void ChildProcessManager::terminate(int pid)
+{
+    auto idleIt = _idle.find(pid);
+    auto childIt = _children.find(pid);
+    ChildInfo *info = idleIt != _idle.end() ? &idleIt->second
+                                            : (childIt != _children.end() ? &childIt->second : nullptr);
+    if (!info || info->terminating)
+        return;
+    info->terminating = true;
+#ifdef _WIN32
+    HANDLE h = OpenProcess(PROCESS_TERMINATE, FALSE, static_cast<DWORD>(pid));
+    if (h)
+    {
+        TerminateProcess(h, 0);
+        CloseHandle(h);
+    }
+    // No SIGCHLD on Windows: stop tracking right away.
+    _idle.erase(pid);
+    _children.erase(pid);
+#else
+    ::kill(pid, SIGTERM);
+#endif
+}
+
+void ChildProcessManager::forceKill(int pid)
+{
+    if (_children.find(pid) == _children.end() && _idle.find(pid) == _idle.end())
+        return;
+#ifdef _WIN32
+    HANDLE h = OpenProcess(PROCESS_TERMINATE, FALSE, static_cast<DWORD>(pid));
+    if (h)
+    {
+        TerminateProcess(h, 1);
+        CloseHandle(h);
+    }
+    _idle.erase(pid);
+    _children.erase(pid);
+#else
+    ::kill(pid, SIGKILL);
+#endif
+}
+
+int ChildProcessManager::signalFd() const
+{
+#ifdef _WIN32
+    return -1;
+#else
+    return g_sigchldPipe[0];
+#endif
+}
+
+std::vector<ChildExit> ChildProcessManager::reap()
+{
+    std::vector<ChildExit> exits;
+#ifndef _WIN32
+    char buf[64];
+    while (g_sigchldPipe[0] != -1 && ::read(g_sigchldPipe[0], buf, sizeof(buf)) > 0)
+    {
+    }
+
+    int status = 0;
+    pid_t pid;
+    while ((pid = ::waitpid(-1, &status, WNOHANG)) > 0)
+    {
+        ChildExit exit;
+        exit.pid = pid;
+        if (WIFEXITED(status))
+            exit.exitCode = WEXITSTATUS(status);
+        if (WIFSIGNALED(status))
+            exit.signal = WTERMSIG(status);
+
+        auto it = _children.find(pid);
+        if (it != _children.end())
+        {
+            exit.lobbyCode = it->second.lobbyCode;
+            exit.udpPort = it->second.udpPort;
+            exit.requested = it->second.terminating;
+            _children.erase(it);
+        }
+        else
+        {
+            auto idleIt = _idle.find(pid);
+            if (idleIt == _idle.end())
+                continue; // not one of ours
+            exit.idle = true;
+            exit.udpPort = idleIt->second.udpPort;
+            exit.requested = idleIt->second.terminating;
+            _idle.erase(idleIt);
+        }
+        exits.push_back(exit);
+    }
+#endif
+    return exits;
 }
 
-void ChildProcessManager::forget(const std::string &lobby)
+std::vector<ChildUsage> ChildProcessManager::sample()
 {
-    _children.erase(lobby);
+    std::vector<ChildUsage> usage;
+#ifdef __linux__
+    static const long ticksPerSec = ::sysconf(_SC_CLK_TCK);
+    static const long pageKb = ::sysconf(_SC_PAGESIZE) / 1024;
+    auto now = std::chrono::steady_clock::now();
+    auto sampleOne = [&](int pid, ChildInfo &info) {
+        std::ifstream statFile("/proc/" + std::to_string(pid) + "/stat");
+        std::string stat;
+        if (!std::getline(statFile, stat))
+            return;
+        // Fields after the command name, which may contain spaces: state is field 3, utime/stime are 14/15.
+        auto nameEnd = stat.rfind(')');
+        if (nameEnd == std::string::npos)
+            return;
+        std::istringstream fields(stat.substr(nameEnd + 2));
+        std::string field;
+        unsigned long long utime = 0;
+        unsigned long long stime = 0;
+        for (int i = 3; i <= 15 && fields >> field; ++i)
+        {
+            if (i == 14)
+                utime = std::stoull(field);
+            else if (i == 15)
+                stime = std::stoull(field);
+        }
+        std::size_t residentPages = 0;
+        std::ifstream statm("/proc/" + std::to_string(pid) + "/statm");
+        std::size_t sizePages = 0;
+        statm >> sizePages >> residentPages;
+
+        ChildUsage u;
+        u.pid = pid;
+        u.lobbyCode = info.lobbyCode;
+        u.rssKb = residentPages * static_cast<std::size_t>(pageKb);
+        unsigned long long ticks = utime + stime;
+        if (info.lastSample != std::chrono::steady_clock::time_point{})
+        {
+            double elapsed = std::chrono::duration<double>(now - info.lastSample).count();
+            if (elapsed > 0 && ticksPerSec > 0)
+                u.cpuPercent = 100.0 * static_cast<double>(ticks - info.lastCpuTicks) / ticksPerSec / elapsed;
+        }
+        info.lastCpuTicks = ticks;
+        info.lastSample = now;
+        usage.push_back(u);
+    };
+    for (auto &kv : _children)
+        sampleOne(kv.first, kv.second);
+    for (auto &kv : _idle)
+        sampleOne(kv.first, kv.second);
+#endif
+    return usage;
 }
@@ -7,10 +7,12 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 struct ChildInfo
 {
@@ -18,49 +20,147 @@ struct ChildInfo
     std::string lobbyCode;
     uint16_t udpPort = 0;
     std::string ipcSock;
+    bool terminating = false; ///< terminate() was called, the exit is expected
+
+    unsigned long long lastCpuTicks = 0; ///< utime + stime at the last sample
+    std::chrono::steady_clock::time_point lastSample{};
+};
+
+/**
+ * @brief A child that exited, as reported by ChildProcessManager::reap().
+ */
+struct ChildExit
+{
+    int pid = -1;
+    std::string lobbyCode; ///< empty for pooled children that never got a lobby
+    uint16_t udpPort = 0;
+    bool idle = false;      ///< the child was still in the warm pool
+    bool requested = false; ///< the exit follows a terminate() call
+    int exitCode = -1;      ///< exit status, or -1 when killed by a signal
+    int signal = 0;         ///< terminating signal, 0 for a normal exit
+};
+
+/**
+ * @brief Resource limits applied to every spawned child (POSIX only).
+ */
+struct ChildLimits
+{
+    bool pinCpus = false;     ///< pin each child to one CPU, round robin
+    std::size_t memoryMb = 0; ///< address space limit (RLIMIT_AS), 0 = unlimited
+    int niceLevel = 0;        ///< scheduling priority offset, 0 = inherit
 };
 
 /**
- * @brief Minimal child process manager to spawn UDP game servers.
+ * @brief CPU and memory use of one child since the previous sample.
+ */
+struct ChildUsage
+{
+    int pid = -1;
+    std::string lobbyCode;
+    double cpuPercent = 0.0;
+    std::size_t rssKb = 0;
+};
+
+/**
+ * @brief Spawns and supervises the UDP game servers.
  *
- * This is a stub: no restart logic, no signal handling, just spawn and track.
+ * On POSIX a SIGCHLD handler writes to a self-pipe; the TCP loop selects on
+ * signalFd() and calls reap() to collect exited children without blocking.
+ * Children stay tracked until they are reaped, terminate() included.
  */
 class ChildProcessManager
 {
   public:
-    explicit ChildProcessManager(std::size_t maxChildren = 64) : _maxChildren(maxChildren)
-    {
-    }
+    explicit ChildProcessManager(std::size_t maxChildren = 64, ChildLimits limits = {});
+    ~ChildProcessManager();
+
+    ChildProcessManager(const ChildProcessManager &) = delete;
+    ChildProcessManager &operator=(const ChildProcessManager &) = delete;
 
     /**
      * @brief Spawn a UDP game server process.
      * @param lobby lobby code
      * @param udpPort udp port to bind
-     * @param ipcSock path to IPC socket
+     * @param ipcSock IPC endpoint (IpcChannel::endpoint())
+     * @param inheritFds descriptors the child keeps across exec (IpcChannel::childFds())
+     * @return pid on success, -1 on failure
+     */
+    int spawn(const std::string &lobby, uint16_t udpPort, const std::string &ipcSock,
+              const std::vector<int> &inheritFds = {});
+
+    /**
+     * @brief Spawn a pooled UDP game server that binds its ports and waits for a lobby.
+     * @param udpPort udp port to bind
+     * @param ipcSock IPC endpoint the child reports to
+     * @param inheritFds descriptors the child keeps across exec
      * @return pid on success, -1 on failure
      */
-    int spawn(const std::string &lobby, uint16_t udpPort, const std::string &ipcSock);
+    int spawnIdle(uint16_t udpPort, const std::string &ipcSock, const std::vector<int> &inheritFds = {});
 
     /**
-     * @brief Retrieve info by lobby code.
+     * @brief Track an idle child as the server of a lobby.
+     * @return false if the pid is not an idle child.
+     */
+    bool assign(int pid, const std::string &lobby);
+
+    /**
+     * @brief Retrieve the running (not terminating) child of a lobby.
      */
     std::optional<ChildInfo> get(const std::string &lobby) const;
 
     /**
-     * @brief Remove tracking info (does not kill).
+     * @brief Ask the children of a lobby to stop (SIGTERM). They are reported by reap().
+     */
+    void terminate(const std::string &lobby);
+
+    /**
+     * @brief Ask one child, idle or not, to stop (SIGTERM). It is reported by reap().
+     */
+    void terminate(int pid);
+
+    /**
+     * @brief Kill a hung child (SIGKILL). Not marked as requested: reap() reports it like a crash.
+     */
+    void forceKill(int pid);
+
+    /**
+     * @brief Descriptor that becomes readable after SIGCHLD (-1 when unsupported).
+     */
+    int signalFd() const;
+
+    /**
+     * @brief Collect every exited child without blocking.
+     */
+    std::vector<ChildExit> reap();
+
+    /**
+     * @brief Sample CPU and RSS of every child from /proc (empty when unsupported).
      */
-    void forget(const std::string &lobby);
+    std::vector<ChildUsage> sample();
 
     std::size_t activeCount() const
     {
         return _children.size();
     }
+    std::size_t idleCount() const
+    {
+        return _idle.size();
+    }
     std::size_t maxCount() const
     {
         return _maxChildren;
     }
 
   private:
-    std::unordered_map<std::string, ChildInfo> _children;
+    /**
+     * @brief fork+exec (CreateProcess on Windows) the UDP server binary with extra arguments.
+     * @return pid on success, -1 on failure
+     */
+    int launch(const std::vector<std::string> &extraArgs, const std::vector<int> &inheritFds);
+
+    std::unordered_map<int, ChildInfo> _children; ///< lobby servers by pid
+    std::unordered_map<int, ChildInfo> _idle;     ///< pooled children by pid, not bound to a lobby yet
     std::size_t _maxChildren;
+    ChildLimits _limits;
+    unsigned _nextCpu = 0;
 };
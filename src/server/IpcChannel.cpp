@@ -2,23 +2,32 @@
 ** EPITECH PROJECT, 2025
 ** Mystic-Type
 ** File description:
-** IPC channel helper (UNIX domain socket)
+** IPC channel between the TCP lobby server and a UDP game server
 */
 
 #include "IpcChannel.hpp"
+#include "ShmRing.hpp"
 
 #include <cstring>
 #include <iostream>
-namespace
-{
-constexpr std::size_t MAX_MSG = 1024;
-}
+#include <new>
+#ifndef _WIN32
+#include <atomic>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+#endif
 
 IpcChannel::~IpcChannel()
 {
     close();
 }
 
+#ifdef _WIN32
+
 bool IpcChannel::bindServer(void)
 {
     if (_sockfd != INVALID_SOCKET_FD)
@@ -36,6 +45,7 @@ bool IpcChannel::bindServer(void)
     {
         std::cerr << "Bind failed" << std::endl;
         CLOSE(_sockfd);
+        _sockfd = INVALID_SOCKET_FD;
         return false;
     }
 
@@ -44,6 +54,7 @@ bool IpcChannel::bindServer(void)
     {
         std::cerr << "getsockname failed" << std::endl;
         CLOSE(_sockfd);
+        _sockfd = INVALID_SOCKET_FD;
         return false;
     }
 
@@ -51,7 +62,7 @@ bool IpcChannel::bindServer(void)
     return true;
 }
 
-bool IpcChannel::connectClient(const std::string &port)
+bool IpcChannel::connectClient(const std::string &endpoint)
 {
     if (_sockfd != INVALID_SOCKET_FD)
         CLOSE(_sockfd);
@@ -62,51 +73,308 @@ bool IpcChannel::connectClient(const std::string &port)
 
     memset(&_addr, 0, sizeof(_addr));
     _addr.sin_family = AF_INET;
-    _addr.sin_port = htons(std::stoi(port));
+    _addr.sin_port = htons(static_cast<uint16_t>(std::stoi(endpoint)));
     _addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
     _isServer = false;
     return true;
 }
 
-bool IpcChannel::send(const std::string &msg)
+bool IpcChannel::send(const IpcMessage &msg)
 {
     if (_sockfd == INVALID_SOCKET_FD)
         return false;
-    if (msg.size() > MAX_MSG)
+    if (_isServer && !_hasPeer)
         return false;
-    ssize_t sent =
-        ::sendto(_sockfd, msg.c_str(), msg.size(), 0, reinterpret_cast<const sockaddr *>(&_addr), sizeof(_addr));
-    return sent == static_cast<ssize_t>(msg.size());
+    const sockaddr_in &to = _isServer ? _peer : _addr;
+    ssize_t sent = ::sendto(_sockfd, reinterpret_cast<const char *>(&msg), sizeof(msg), 0,
+                            reinterpret_cast<const sockaddr *>(&to), sizeof(to));
+    return sent == static_cast<ssize_t>(sizeof(msg));
 }
 
-std::optional<std::string> IpcChannel::recv(int timeoutMs)
+std::optional<IpcMessage> IpcChannel::recv(int timeoutMs)
 {
-    fd_set rfds = {0};
-    timeval tv = {0};
+    fd_set rfds;
+    timeval tv{};
     if (_sockfd == INVALID_SOCKET_FD)
         return std::nullopt;
 
     FD_ZERO(&rfds);
     FD_SET(_sockfd, &rfds);
-    tv.tv_usec = timeoutMs;
-    tv.tv_sec = 0;
-    int ret = select(_sockfd + 1, &rfds, NULL, NULL, &tv);
+    tv.tv_sec = timeoutMs > 0 ? timeoutMs / 1000 : 0;
+    tv.tv_usec = timeoutMs > 0 ? (timeoutMs % 1000) * 1000 : 0;
+    int ret = select(static_cast<int>(_sockfd) + 1, &rfds, NULL, NULL, timeoutMs < 0 ? NULL : &tv);
     if (ret <= 0)
         return std::nullopt;
 
-    char buf[MAX_MSG + 1]{};
-    ssize_t n = ::recv(_sockfd, buf, MAX_MSG, 0);
-    if (n <= 0)
+    IpcMessage msg;
+    sockaddr_in from{};
+    socklen_t fromLen = sizeof(from);
+    ssize_t n = ::recvfrom(_sockfd, reinterpret_cast<char *>(&msg), sizeof(msg), 0,
+                           reinterpret_cast<sockaddr *>(&from), &fromLen);
+    if (n != static_cast<ssize_t>(sizeof(msg)))
         return std::nullopt;
-    return std::string(buf, buf + n);
+    if (_isServer)
+    {
+        _peer = from;
+        _hasPeer = true;
+    }
+    return msg;
+}
+
+std::string IpcChannel::endpoint() const
+{
+    return std::to_string(ntohs(_addr.sin_port));
+}
+
+std::vector<int> IpcChannel::childFds() const
+{
+    return {};
 }
 
 void IpcChannel::close()
 {
-    if (_sockfd != -INVALID_SOCKET_FD)
+    if (_sockfd != INVALID_SOCKET_FD)
     {
         CLOSE(_sockfd);
+        _sockfd = INVALID_SOCKET_FD;
     }
     _isServer = false;
+    _hasPeer = false;
     memset(&_addr, 0, sizeof(_addr));
 }
+
+#else
+
+/**
+ * @brief Layout of the shared segment: one ring per direction.
+ */
+struct IpcChannel::Segment
+{
+    ShmRing toParent;
+    ShmRing toChild;
+};
+
+namespace
+{
+/**
+ * @brief Create one wakeup direction: {read end, write end} (the same eventfd on Linux).
+ */
+bool makeWakeup(int &readFd, int &writeFd)
+{
+#ifdef __linux__
+    readFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    writeFd = readFd;
+    return readFd != -1;
+#else
+    int fds[2];
+    if (::pipe(fds) == -1)
+        return false;
+    for (int fd : fds)
+    {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    readFd = fds[0];
+    writeFd = fds[1];
+    return true;
+#endif
+}
+
+void closeIfOpen(int &fd)
+{
+    if (fd != -1)
+        ::close(fd);
+    fd = -1;
+}
+} // namespace
+
+ShmRing *IpcChannel::inbox() const
+{
+    return _isServer ? &_segment->toParent : &_segment->toChild;
+}
+
+ShmRing *IpcChannel::outbox() const
+{
+    return _isServer ? &_segment->toChild : &_segment->toParent;
+}
+
+bool IpcChannel::bindServer(void)
+{
+    close();
+
+    static std::atomic<unsigned> counter{0};
+    _shmName = "/rtype-ipc-" + std::to_string(::getpid()) + "-" + std::to_string(counter++);
+    int shmFd = ::shm_open(_shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (shmFd == -1)
+    {
+        std::cerr << "shm_open failed for " << _shmName << std::endl;
+        return false;
+    }
+    if (::ftruncate(shmFd, sizeof(Segment)) == -1)
+    {
+        ::close(shmFd);
+        ::shm_unlink(_shmName.c_str());
+        return false;
+    }
+    void *mem = ::mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, shmFd, 0);
+    ::close(shmFd);
+    if (mem == MAP_FAILED)
+    {
+        ::shm_unlink(_shmName.c_str());
+        return false;
+    }
+    _segment = new (mem) Segment();
+    _isServer = true;
+
+    // toParent: we wait, the child signals. toChild: the child waits, we signal.
+    if (!makeWakeup(_waitFd, _childSignalFd) || !makeWakeup(_childWaitFd, _signalFd))
+    {
+        std::cerr << "Failed to create IPC wakeup descriptors" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool IpcChannel::connectClient(const std::string &endpoint)
+{
+    close();
+
+    auto first = endpoint.find(':');
+    auto second = first == std::string::npos ? std::string::npos : endpoint.find(':', first + 1);
+    if (second == std::string::npos)
+        return false;
+    _shmName = endpoint.substr(0, first);
+    try
+    {
+        _waitFd = std::stoi(endpoint.substr(first + 1, second - first - 1));
+        _signalFd = std::stoi(endpoint.substr(second + 1));
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+
+    int shmFd = ::shm_open(_shmName.c_str(), O_RDWR, 0600);
+    if (shmFd == -1)
+        return false;
+    void *mem = ::mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, shmFd, 0);
+    ::close(shmFd);
+    if (mem == MAP_FAILED)
+        return false;
+    _segment = static_cast<Segment *>(mem);
+    _isServer = false;
+    _unlinked = true; // the name belongs to the parent
+    return true;
+}
+
+void IpcChannel::signalPeer()
+{
+#ifdef __linux__
+    uint64_t one = 1;
+    ssize_t ret = ::write(_signalFd, &one, sizeof(one));
+#else
+    char one = 1;
+    ssize_t ret = ::write(_signalFd, &one, sizeof(one));
+#endif
+    (void)ret; // a full counter/pipe already means a pending wakeup
+}
+
+void IpcChannel::clearWakeup()
+{
+#ifdef __linux__
+    uint64_t count = 0;
+    ssize_t ret = ::read(_waitFd, &count, sizeof(count));
+    (void)ret;
+#else
+    char buf[64];
+    while (::read(_waitFd, buf, sizeof(buf)) > 0)
+    {
+    }
+#endif
+}
+
+bool IpcChannel::send(const IpcMessage &msg)
+{
+    if (!_segment || !outbox()->push(msg))
+        return false;
+    signalPeer();
+    return true;
+}
+
+bool IpcChannel::popInbox(IpcMessage &msg)
+{
+    if (!inbox()->pop(msg))
+        return false;
+    if (_isServer && !_unlinked)
+    {
+        // The child is attached, nobody else needs the name.
+        ::shm_unlink(_shmName.c_str());
+        _unlinked = true;
+    }
+    return true;
+}
+
+std::optional<IpcMessage> IpcChannel::recv(int timeoutMs)
+{
+    if (!_segment)
+        return std::nullopt;
+
+    IpcMessage msg;
+    while (true)
+    {
+        if (popInbox(msg))
+            return msg;
+        // Clear the wakeup before the second look so a concurrent push is never missed.
+        clearWakeup();
+        if (popInbox(msg))
+            return msg;
+        if (timeoutMs == 0)
+            return std::nullopt;
+
+        fd_set rfds;
+        FD_ZERO(&rfds);
+        FD_SET(_waitFd, &rfds);
+        timeval tv{timeoutMs / 1000, (timeoutMs % 1000) * 1000};
+        int ret = select(_waitFd + 1, &rfds, NULL, NULL, timeoutMs < 0 ? NULL : &tv);
+        if (ret == 0 || (ret < 0 && errno != EINTR))
+            return std::nullopt;
+        if (timeoutMs > 0)
+            timeoutMs = 0; // a single wait, then one last non-blocking look
+    }
+}
+
+std::string IpcChannel::endpoint() const
+{
+    return _shmName + ":" + std::to_string(_childWaitFd) + ":" + std::to_string(_childSignalFd);
+}
+
+std::vector<int> IpcChannel::childFds() const
+{
+    return {_childWaitFd, _childSignalFd};
+}
+
+void IpcChannel::close()
+{
+    if (_segment)
+    {
+        ::munmap(_segment, sizeof(Segment));
+        _segment = nullptr;
+    }
+    if (_isServer && !_unlinked && !_shmName.empty())
+        ::shm_unlink(_shmName.c_str());
+    _unlinked = false;
+    _shmName.clear();
+    // On Linux each eventfd is shared by both ends of a direction, close it once.
+    if (_childSignalFd == _waitFd)
+        _childSignalFd = -1;
+    if (_childWaitFd == _signalFd)
+        _childWaitFd = -1;
+    closeIfOpen(_waitFd);
+    closeIfOpen(_signalFd);
+    closeIfOpen(_childWaitFd);
+    closeIfOpen(_childSignalFd);
+    _isServer = false;
+}
+
+#endif
@@ -2,22 +2,30 @@
 ** EPITECH PROJECT, 2025
 ** Mystic-Type
 ** File description:
-** IPC channel helper (UNIX domain socket)
+** IPC channel between the TCP lobby server and a UDP game server
 */
 
 #pragma once
 
 #include "../Network/TransportLayer/UDP/UDPSocket.hpp"
+#include "IpcMessage.hpp"
 #include <optional>
 #include <string>
+#include <vector>
+
+struct ShmRing;
+
 /**
- * @brief Small IPC helper based on a UNIX datagram socket (SOCK_DGRAM).
+ * @brief Typed control channel between the TCP server (server side) and one UDP game server (client side).
  *
- * Server mode: bind() on a path, then recv/send.
- * Client mode: connect() to the existing path, then recv/send.
+ * On POSIX the channel is a shared-memory segment holding one SPSC ring per
+ * direction. Each direction has a wakeup descriptor (eventfd on Linux, a pipe
+ * elsewhere) that is signalled on every push, so the receiving side can
+ * select() on fd() and never polls. The child inherits the wakeup descriptors
+ * and opens the segment by name; endpoint() is the string passed on its
+ * command line.
  *
- * Messages are short ASCII strings (<= 1024 bytes); this is not a reliable stream
- * protocol but sufficient for READY/ALLOW/etc control signals.
+ * On Windows the messages travel as raw IpcMessage datagrams over loopback UDP.
  */
 class IpcChannel
 {
@@ -29,51 +37,79 @@ class IpcChannel
     IpcChannel &operator=(const IpcChannel &) = delete;
 
     /**
-     * @brief Create a socket and bind to a path (server side).
+     * @brief Create the channel (server side).
      * @return true on success.
      */
     bool bindServer(void);
 
     /**
-     * @brief Create a socket and connect to a path (client side).
+     * @brief Attach to a channel created by the parent (client side).
+     * @param endpoint value of endpoint() on the server side.
      * @return true on success.
      */
-    bool connectClient(const std::string &port);
+    bool connectClient(const std::string &endpoint);
 
     /**
-     * @brief Send a text message (limited to 1024 bytes).
+     * @brief Queue a message for the other side and wake it up.
+     * @return false if the channel is closed or the ring is full.
      */
-    bool send(const std::string &msg);
+    bool send(const IpcMessage &msg);
 
     /**
      * @brief Receive a message with optional timeout (ms).
-     * timeoutMs = 0 => non-blocking, <0 => blocking, >0 => poll with timeout.
+     * timeoutMs = 0 => non-blocking, <0 => blocking, >0 => wait up to timeoutMs.
      */
-    std::optional<std::string> recv(int timeoutMs = 0);
+    std::optional<IpcMessage> recv(int timeoutMs = 0);
 
     /**
-     * @brief get ipc port in string format
+     * @brief Address of the channel to hand to the child process.
      */
-    inline std::string getport(void) const
-    {
-        return std::to_string(ntohs(_addr.sin_port));
-    }
+    std::string endpoint() const;
 
     /**
-     * @brief Close the socket and unlink the path when in server mode.
+     * @brief Descriptors the child process must inherit (empty on Windows).
+     */
+    std::vector<int> childFds() const;
+
+    /**
+     * @brief Close the channel and release the shared segment.
      */
     void close();
 
     /**
-     * @brief return internal sock fd
+     * @brief Descriptor that becomes readable when a message is pending.
      */
     socket_t fd() const
     {
+#ifdef _WIN32
         return _sockfd;
+#else
+        return _waitFd;
+#endif
     }
 
   private:
-    socket_t _sockfd = INVALID_SOCKET_FD;
-    sockaddr_in _addr;
     bool _isServer = false;
+#ifdef _WIN32
+    socket_t _sockfd = INVALID_SOCKET_FD;
+    sockaddr_in _addr{};
+    sockaddr_in _peer{};
+    bool _hasPeer = false;
+#else
+    struct Segment;
+
+    void signalPeer();
+    void clearWakeup();
+    bool popInbox(IpcMessage &msg);
+    ShmRing *inbox() const;
+    ShmRing *outbox() const;
+
+    std::string _shmName;
+    Segment *_segment = nullptr;
+    bool _unlinked = false;
+    int _waitFd = -1;        ///< readable when the inbox got a message
+    int _signalFd = -1;      ///< written to wake the peer after pushing to the outbox
+    int _childWaitFd = -1;   ///< server side only: child's ends, handed over at spawn
+    int _childSignalFd = -1; ///< server side only
+#endif
 };
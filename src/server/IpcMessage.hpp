@@ -0,0 +1,145 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Typed control messages between the TCP lobby server and UDP game servers
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * @brief Kind of control message exchanged over an IpcChannel.
+ */
+enum class IpcType : uint8_t
+{
+    Ready = 1,    ///< child -> parent: UDP port bound, ready to serve (or to be claimed).
+    Heartbeat,    ///< child -> parent: still alive, value = players in game. Rate limited.
+    PlayerDead,   ///< child -> parent: value = id of the player that died.
+    BossSpawned,  ///< child -> parent: the lobby boss appeared.
+    BossDead,     ///< child -> parent: the lobby boss was defeated.
+    NoPlayers,    ///< child -> parent: the lobby world is empty, the child is exiting.
+    Claim,        ///< parent -> pooled child: serve the lobby carried in the message.
+    Metric,       ///< child -> parent: metric delta, see IpcMetric.
+    StatsRequest, ///< parent -> child: reply with the lobby's traffic stats.
+    Stat,         ///< child -> parent: one IpcStat of the reply, see IpcMessage::makeStat.
+    StatsEnd      ///< child -> parent: reply complete, value = Stat messages sent.
+};
+
+/**
+ * @brief Metric carried by an IpcType::Metric message (in reserved[0]).
+ *
+ * Counters carry their delta in value. Histograms carry one bucket per message:
+ * the Metrics::Histogram bucket index in reserved[1..2] and its new sample count in value.
+ */
+enum class IpcMetric : uint8_t
+{
+    PacketsIn = 0,  ///< counter: UDP datagrams parsed
+    PacketsOut,     ///< counter: UDP datagrams sent
+    BytesIn,        ///< counter
+    BytesOut,       ///< counter
+    PacketsDropped, ///< counter: unparsable datagrams and failed sends
+    Truncations,    ///< counter: snapshots cut to fit the 255-byte payload
+    TickMicros,     ///< histogram: duration of one simulation step
+    SnapshotBytes,  ///< histogram: size of each snapshot built
+    Count
+};
+
+constexpr bool isHistogramMetric(IpcMetric metric)
+{
+    return metric >= IpcMetric::TickMicros;
+}
+
+/**
+ * @brief Field of an IpcType::Stat message (in reserved[0]); reserved[1..2] holds the player id, 0 for the lobby.
+ *
+ * Rates are averaged over the game server's last one-second window.
+ */
+enum class IpcStat : uint8_t
+{
+    PacketsInPerSec = 0, ///< lobby and clients
+    PacketsOutPerSec,    ///< lobby and clients
+    BytesInPerSec,       ///< lobby and clients
+    BytesOutPerSec,      ///< lobby and clients
+    SnapshotBytesP50,    ///< lobby: snapshot datagram size since the game started
+    SnapshotBytesP99,    ///< lobby
+    SnapshotBytesMax,    ///< lobby
+    Players,             ///< lobby: entities in the last snapshot
+    Bullets,             ///< lobby
+    Monsters,            ///< lobby
+    Truncations,         ///< lobby: snapshots cut to fit the payload cap, since the game started
+    EntitiesDropped,     ///< lobby: entities those snapshots left out
+    Count
+};
+
+/**
+ * @brief Fixed-size, trivially copyable control message.
+ *
+ * Lives as-is in the shared-memory ring, so it must stay a POD.
+ */
+struct IpcMessage
+{
+    static constexpr std::size_t LOBBY_LEN = 8;
+
+    IpcType type = IpcType::Heartbeat;
+    uint8_t reserved[3]{};
+    int32_t value = 0;
+    char lobby[LOBBY_LEN]{}; ///< Lobby code, not NUL terminated when it uses all 8 bytes.
+
+    static IpcMessage make(IpcType type, int32_t value = 0, const std::string &lobbyCode = "")
+    {
+        IpcMessage msg;
+        msg.type = type;
+        msg.value = value;
+        std::memcpy(msg.lobby, lobbyCode.data(), lobbyCode.size() < LOBBY_LEN ? lobbyCode.size() : LOBBY_LEN);
+        return msg;
+    }
+
+    static IpcMessage makeMetric(IpcMetric metric, int32_t value, uint16_t bucket = 0)
+    {
+        IpcMessage msg = make(IpcType::Metric, value);
+        msg.reserved[0] = static_cast<uint8_t>(metric);
+        msg.reserved[1] = static_cast<uint8_t>(bucket >> 8);
+        msg.reserved[2] = static_cast<uint8_t>(bucket & 0xFF);
+        return msg;
+    }
+
+    static IpcMessage makeStat(IpcStat stat, int32_t value, uint16_t playerId = 0)
+    {
+        IpcMessage msg = make(IpcType::Stat, value);
+        msg.reserved[0] = static_cast<uint8_t>(stat);
+        msg.reserved[1] = static_cast<uint8_t>(playerId >> 8);
+        msg.reserved[2] = static_cast<uint8_t>(playerId & 0xFF);
+        return msg;
+    }
+
+    IpcMetric metric() const
+    {
+        return static_cast<IpcMetric>(reserved[0]);
+    }
+
+    uint16_t metricBucket() const
+    {
+        return static_cast<uint16_t>((reserved[1] << 8) | reserved[2]);
+    }
+
+    IpcStat stat() const
+    {
+        return static_cast<IpcStat>(reserved[0]);
+    }
+
+    uint16_t statPlayer() const
+    {
+        return static_cast<uint16_t>((reserved[1] << 8) | reserved[2]);
+    }
+
+    std::string lobbyCode() const
+    {
+        return std::string(lobby, strnlen(lobby, LOBBY_LEN));
+    }
+};
+
+static_assert(sizeof(IpcMessage) == 16, "IpcMessage is shared between processes, keep its layout fixed");
@@ -0,0 +1,84 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Game server side metric accumulation, forwarded to the lobby server over IPC
+*/
+
+#pragma once
+
+#include "../Metrics/Histogram.hpp"
+#include "IpcChannel.hpp"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Accumulates the game server's metrics and ships the deltas as IpcType::Metric messages.
+ *
+ * Histograms are kept as sparse bucket counts, so a second of ticks usually costs a
+ * handful of 16-byte messages and the parent merges them exactly.
+ */
+class IpcMetricsWriter
+{
+  public:
+    IpcMetricsWriter()
+    {
+        for (auto &buckets : _buckets)
+            buckets.assign(Metrics::Histogram::kBuckets, 0);
+    }
+
+    void add(IpcMetric metric, uint64_t delta)
+    {
+        _counters[static_cast<std::size_t>(metric)] += delta;
+    }
+
+    void sample(IpcMetric metric, uint64_t value)
+    {
+        ++_buckets[histogramIndex(metric)][Metrics::Histogram::bucketOf(value)];
+    }
+
+    /**
+     * @brief Sends every pending delta; what the ring cannot take stays pending for the next flush.
+     */
+    void flush(IpcChannel &ipc)
+    {
+        constexpr uint64_t kMaxValue = static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
+        for (std::size_t m = 0; m < _counters.size(); ++m)
+        {
+            while (_counters[m] > 0)
+            {
+                uint64_t chunk = std::min(_counters[m], kMaxValue);
+                if (!ipc.send(IpcMessage::makeMetric(static_cast<IpcMetric>(m), static_cast<int32_t>(chunk))))
+                    return;
+                _counters[m] -= chunk;
+            }
+        }
+        for (std::size_t h = 0; h < _buckets.size(); ++h)
+        {
+            IpcMetric metric = static_cast<IpcMetric>(static_cast<std::size_t>(IpcMetric::TickMicros) + h);
+            for (std::size_t b = 0; b < _buckets[h].size(); ++b)
+            {
+                if (_buckets[h][b] == 0)
+                    continue;
+                if (!ipc.send(IpcMessage::makeMetric(metric, static_cast<int32_t>(_buckets[h][b]),
+                                                     static_cast<uint16_t>(b))))
+                    return;
+                _buckets[h][b] = 0;
+            }
+        }
+    }
+
+  private:
+    static constexpr std::size_t kHistograms =
+        static_cast<std::size_t>(IpcMetric::Count) - static_cast<std::size_t>(IpcMetric::TickMicros);
+
+    static std::size_t histogramIndex(IpcMetric metric)
+    {
+        return static_cast<std::size_t>(metric) - static_cast<std::size_t>(IpcMetric::TickMicros);
+    }
+
+    std::array<uint64_t, static_cast<std::size_t>(IpcMetric::TickMicros)> _counters{};
+    std::array<std::vector<uint32_t>, kHistograms> _buckets;
+};
@@ -0,0 +1,240 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Per-lobby and per-client traffic stats, queried by the lobby server over IPC
+*/
+
+#pragma once
+
+#include "../Metrics/Histogram.hpp"
+#include "IpcChannel.hpp"
+#ifndef _WIN32
+#include <netinet/in.h>
+#else
+#include <winsock2.h>
+#endif
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <unordered_map>
+
+/**
+ * @brief Packets and bytes per second in each direction.
+ */
+struct TrafficRates
+{
+    uint32_t packetsIn = 0;
+    uint32_t packetsOut = 0;
+    uint32_t bytesIn = 0;
+    uint32_t bytesOut = 0;
+};
+
+/**
+ * @brief Game server side: traffic of the lobby and of each client endpoint, plus snapshot accounting.
+ *
+ * Counts go into a window that roll() closes once a second, turning it into rates.
+ * A client is known by its UDP endpoint, and by its player id once a HELLO_UDP or INPUT
+ * named it; an endpoint with no traffic over a whole window is forgotten.
+ */
+class TrafficStats
+{
+  public:
+    void received(const sockaddr_in &from, std::size_t bytes)
+    {
+        count(_lobby.window, bytes, true);
+        count(client(from).window, bytes, true);
+    }
+
+    void sent(const sockaddr_in &to, std::size_t bytes)
+    {
+        count(_lobby.window, bytes, false);
+        count(client(to).window, bytes, false);
+    }
+
+    void identify(const sockaddr_in &addr, int playerId)
+    {
+        client(addr).playerId = playerId;
+    }
+
+    /**
+     * @brief A snapshot was built: its datagram size and the entities it carries or left out.
+     */
+    void snapshot(std::size_t bytes, uint16_t players, uint16_t bullets, uint16_t monsters, uint16_t dropped)
+    {
+        _snapshotBytes.record(bytes);
+        _players = players;
+        _bullets = bullets;
+        _monsters = monsters;
+        if (dropped > 0)
+        {
+            ++_truncations;
+            _entitiesDropped += dropped;
+        }
+    }
+
+    /**
+     * @brief Close the current window: its counts become the rates reported until the next roll().
+     */
+    void roll(long long nowMs)
+    {
+        long long elapsed = _windowStartMs == 0 ? 0 : nowMs - _windowStartMs;
+        _windowStartMs = nowMs;
+        if (elapsed <= 0)
+            return;
+        close(_lobby, elapsed);
+        for (auto it = _clients.begin(); it != _clients.end();)
+        {
+            bool idle = it->second.window.packetsIn == 0 && it->second.window.packetsOut == 0;
+            close(it->second, elapsed);
+            it = idle ? _clients.erase(it) : std::next(it);
+        }
+    }
+
+    const TrafficRates &lobbyRates() const
+    {
+        return _lobby.rates;
+    }
+
+    uint64_t truncations() const
+    {
+        return _truncations;
+    }
+
+    /**
+     * @brief Answer an IpcType::StatsRequest: Stat messages for the lobby then each named client, then StatsEnd.
+     * @return false if the ring filled up; the parent drops a reply without its StatsEnd.
+     */
+    bool report(IpcChannel &ipc) const
+    {
+        int32_t sent = 0;
+        auto stat = [&ipc, &sent](IpcStat field, uint64_t value, uint16_t player) {
+            constexpr uint64_t kMax = static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
+            ++sent;
+            return ipc.send(IpcMessage::makeStat(field, static_cast<int32_t>(std::min(value, kMax)), player));
+        };
+        auto rates = [&stat](const TrafficRates &r, uint16_t player) {
+            return stat(IpcStat::PacketsInPerSec, r.packetsIn, player) &&
+                   stat(IpcStat::PacketsOutPerSec, r.packetsOut, player) &&
+                   stat(IpcStat::BytesInPerSec, r.bytesIn, player) &&
+                   stat(IpcStat::BytesOutPerSec, r.bytesOut, player);
+        };
+        if (!rates(_lobby.rates, 0) || !stat(IpcStat::SnapshotBytesP50, _snapshotBytes.percentile(50), 0) ||
+            !stat(IpcStat::SnapshotBytesP99, _snapshotBytes.percentile(99), 0) ||
+            !stat(IpcStat::SnapshotBytesMax, _snapshotBytes.max(), 0) || !stat(IpcStat::Players, _players, 0) ||
+            !stat(IpcStat::Bullets, _bullets, 0) || !stat(IpcStat::Monsters, _monsters, 0) ||
+            !stat(IpcStat::Truncations, _truncations, 0) || !stat(IpcStat::EntitiesDropped, _entitiesDropped, 0))
+            return false;
+        for (const auto &kv : _clients)
+        {
+            if (kv.second.playerId > 0 && kv.second.playerId <= UINT16_MAX &&
+                !rates(kv.second.rates, static_cast<uint16_t>(kv.second.playerId)))
+                return false;
+        }
+        return ipc.send(IpcMessage::make(IpcType::StatsEnd, sent));
+    }
+
+  private:
+    struct Window
+    {
+        uint64_t packetsIn = 0;
+        uint64_t packetsOut = 0;
+        uint64_t bytesIn = 0;
+        uint64_t bytesOut = 0;
+    };
+
+    struct Traffic
+    {
+        int playerId = 0; ///< 0 until a packet named it
+        Window window;
+        TrafficRates rates;
+    };
+
+    static void count(Window &w, std::size_t bytes, bool in)
+    {
+        (in ? w.packetsIn : w.packetsOut) += 1;
+        (in ? w.bytesIn : w.bytesOut) += bytes;
+    }
+
+    static void close(Traffic &t, long long elapsedMs)
+    {
+        auto perSec = [elapsedMs](uint64_t n) { return static_cast<uint32_t>(n * 1000 / elapsedMs); };
+        t.rates = {perSec(t.window.packetsIn), perSec(t.window.packetsOut), perSec(t.window.bytesIn),
+                   perSec(t.window.bytesOut)};
+        t.window = Window{};
+    }
+
+    Traffic &client(const sockaddr_in &addr)
+    {
+        uint64_t key = (static_cast<uint64_t>(addr.sin_addr.s_addr) << 16) | addr.sin_port;
+        return _clients[key];
+    }
+
+    Traffic _lobby;
+    std::unordered_map<uint64_t, Traffic> _clients; ///< by endpoint
+    long long _windowStartMs = 0;
+    Metrics::Histogram _snapshotBytes;
+    uint16_t _players = 0;
+    uint16_t _bullets = 0;
+    uint16_t _monsters = 0;
+    uint64_t _truncations = 0;
+    uint64_t _entitiesDropped = 0;
+};
+
+/**
+ * @brief Lobby server side: the last complete reply of a game server to IpcType::StatsRequest.
+ */
+struct GameStats
+{
+    std::array<uint32_t, static_cast<std::size_t>(IpcStat::Count)> lobby{}; ///< by IpcStat
+    std::map<uint16_t, TrafficRates> clients;                                ///< by player id
+    int32_t messages = 0;                                                    ///< Stat messages folded in
+
+    uint32_t get(IpcStat stat) const
+    {
+        return lobby[static_cast<std::size_t>(stat)];
+    }
+
+    TrafficRates lobbyRates() const
+    {
+        return {get(IpcStat::PacketsInPerSec), get(IpcStat::PacketsOutPerSec), get(IpcStat::BytesInPerSec),
+                get(IpcStat::BytesOutPerSec)};
+    }
+
+    /**
+     * @brief Fold one IpcType::Stat message into the reply being assembled.
+     */
+    void apply(const IpcMessage &msg)
+    {
+        ++messages;
+        if (msg.stat() >= IpcStat::Count || msg.value < 0)
+            return;
+        uint32_t value = static_cast<uint32_t>(msg.value);
+        if (msg.statPlayer() == 0)
+        {
+            lobby[static_cast<std::size_t>(msg.stat())] = value;
+            return;
+        }
+        TrafficRates &rates = clients[msg.statPlayer()];
+        switch (msg.stat())
+        {
+        case IpcStat::PacketsInPerSec:
+            rates.packetsIn = value;
+            break;
+        case IpcStat::PacketsOutPerSec:
+            rates.packetsOut = value;
+            break;
+        case IpcStat::BytesInPerSec:
+            rates.bytesIn = value;
+            break;
+        case IpcStat::BytesOutPerSec:
+            rates.bytesOut = value;
+            break;
+        default:
+            break;
+        }
+    }
+};
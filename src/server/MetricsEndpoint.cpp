@@ -0,0 +1,146 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Loopback HTTP endpoint serving Prometheus metrics
+*/
+
+#include "MetricsEndpoint.hpp"
+#include <algorithm>
+
+namespace
+{
+std::string httpResponse(const char *status, const char *contentType, const std::string &body)
+{
+    return std::string("HTTP/1.1 ") + status + "\r\nContent-Type: " + contentType +
+           "\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+}
+} // namespace
+
+MetricsEndpoint::~MetricsEndpoint()
+{
+    for (auto &conn : _connections)
+        CLOSE(conn.fd);
+    if (_listenFd != INVALID_SOCKET_FD)
+        CLOSE(_listenFd);
+}
+
+bool MetricsEndpoint::listen(uint16_t port)
+{
+    _listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (_listenFd == INVALID_SOCKET_FD)
+        return false;
+    int reuse = 1;
+    setsockopt(_listenFd, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char *>(&reuse), sizeof(reuse));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(_listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 || ::listen(_listenFd, 8) < 0)
+    {
+        CLOSE(_listenFd);
+        _listenFd = INVALID_SOCKET_FD;
+        return false;
+    }
+    return true;
+}
+
+void MetricsEndpoint::addFds(fd_set &readfds, fd_set &writefds, int &maxFd) const
+{
+    if (_listenFd == INVALID_SOCKET_FD)
+        return;
+    FD_SET(_listenFd, &readfds);
+    maxFd = std::max(maxFd, static_cast<int>(_listenFd));
+    for (const auto &conn : _connections)
+    {
+        FD_SET(conn.fd, conn.response.empty() ? &readfds : &writefds);
+        maxFd = std::max(maxFd, static_cast<int>(conn.fd));
+    }
+}
+
+void MetricsEndpoint::process(const fd_set &readfds, const fd_set &writefds,
+                              const std::function<std::string()> &render)
+{
+    if (_listenFd == INVALID_SOCKET_FD)
+        return;
+    auto now = std::chrono::steady_clock::now();
+    if (FD_ISSET(_listenFd, &readfds))
+    {
+        socket_t fd = ::accept(_listenFd, nullptr, nullptr);
+        if (fd != INVALID_SOCKET_FD && _connections.size() < kMaxConnections)
+        {
+#ifdef _WIN32
+            u_long nonBlocking = 1; // SEND_NOWAIT_FLAGS is 0 there
+            ioctlsocket(fd, FIONBIO, &nonBlocking);
+#endif
+            _connections.push_back(Connection{fd, {}, {}, 0, now});
+        }
+        else if (fd != INVALID_SOCKET_FD)
+        {
+            CLOSE(fd);
+        }
+    }
+    for (std::size_t i = 0; i < _connections.size();)
+    {
+        Connection &conn = _connections[i];
+        bool done;
+        if (conn.response.empty())
+        {
+            done = now - conn.opened > std::chrono::seconds(1);
+            if (!done && FD_ISSET(conn.fd, &readfds))
+            {
+                char buf[1024];
+                ssize_t n = ::recv(conn.fd, buf, sizeof(buf), 0);
+                if (n <= 0)
+                {
+                    done = true;
+                }
+                else
+                {
+                    conn.request.append(buf, static_cast<std::size_t>(n));
+                    if (conn.request.find("\r\n\r\n") != std::string::npos || conn.request.size() > kMaxRequestBytes)
+                    {
+                        conn.response = respond(conn.request, render);
+                        done = !flush(conn);
+                    }
+                }
+            }
+        }
+        else
+        {
+            done = now - conn.opened > std::chrono::seconds(5);
+            if (!done && FD_ISSET(conn.fd, &writefds))
+                done = !flush(conn);
+        }
+        if (done)
+        {
+            CLOSE(conn.fd);
+            _connections[i] = std::move(_connections.back());
+            _connections.pop_back();
+            continue;
+        }
+        ++i;
+    }
+}
+
+std::string MetricsEndpoint::respond(const std::string &request, const std::function<std::string()> &render)
+{
+    if (request.rfind("GET /metrics ", 0) == 0 || request.rfind("GET / ", 0) == 0)
+        return httpResponse("200 OK", "text/plain; version=0.0.4", render());
+    return httpResponse("404 Not Found", "text/plain", "try /metrics\n");
+}
+
+bool MetricsEndpoint::flush(Connection &conn)
+{
+    while (conn.sent < conn.response.size())
+    {
+        const std::size_t left = conn.response.size() - conn.sent;
+        ssize_t n = ::send(conn.fd, conn.response.data() + conn.sent, static_cast<int>(left), SEND_NOWAIT_FLAGS);
+        if (n < 0 && SOCKET_WOULD_BLOCK(SOCKET_ERROR_CODE))
+            return true;
+        if (n <= 0)
+            return false;
+        conn.sent += static_cast<std::size_t>(n);
+    }
+    return false;
+}
@@ -0,0 +1,74 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Loopback HTTP endpoint serving Prometheus metrics
+*/
+
+#pragma once
+
+#include "../Network/TransportLayer/ISocket.hpp"
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Minimal HTTP/1.1 server on 127.0.0.1 answering `GET /metrics`, driven by the owner's select() loop.
+ *
+ * Each scrape is one short-lived connection: the request is read, the body is rendered
+ * by the callback, and the socket is closed. Responses are sent without blocking and the
+ * rest is flushed when the socket is writable, so a scraper that stops reading cannot
+ * stall the lobby server. Connections get a second to send their request and five to
+ * receive the response.
+ */
+class MetricsEndpoint
+{
+  public:
+    MetricsEndpoint() = default;
+    ~MetricsEndpoint();
+
+    MetricsEndpoint(const MetricsEndpoint &) = delete;
+    MetricsEndpoint &operator=(const MetricsEndpoint &) = delete;
+
+    /**
+     * @brief Bind 127.0.0.1:port and listen.
+     * @return false if the port is unavailable.
+     */
+    bool listen(uint16_t port);
+
+    /**
+     * @brief Add the listening socket and open connections to the select() sets (write: pending responses).
+     */
+    void addFds(fd_set &readfds, fd_set &writefds, int &maxFd) const;
+
+    /**
+     * @brief Accept, read, answer and flush whatever select() reported ready.
+     * @param render Produces the metrics body for each scrape.
+     */
+    void process(const fd_set &readfds, const fd_set &writefds, const std::function<std::string()> &render);
+
+  private:
+    struct Connection
+    {
+        socket_t fd = INVALID_SOCKET_FD;
+        std::string request;
+        std::string response; ///< set once the request is complete
+        std::size_t sent = 0; ///< bytes of response already written
+        std::chrono::steady_clock::time_point opened;
+    };
+
+    static constexpr std::size_t kMaxConnections = 16;
+    static constexpr std::size_t kMaxRequestBytes = 4096;
+
+    static std::string respond(const std::string &request, const std::function<std::string()> &render);
+
+    /**
+     * @brief Write as much of the response as the socket takes.
+     * @return true while bytes remain to be sent.
+     */
+    static bool flush(Connection &conn);
+
+    socket_t _listenFd = INVALID_SOCKET_FD;
+    std::vector<Connection> _connections;
+};
@@ -0,0 +1,56 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Single-producer single-consumer ring living in shared memory
+*/
+
+#pragma once
+
+#include "IpcMessage.hpp"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Lock-free SPSC ring of IpcMessage, placed in a shared mapping.
+ *
+ * One process only pushes, the other only pops. Head and tail are free
+ * running counters; the slot index is the counter modulo CAPACITY. The
+ * structure is zero-initialised by the creator of the mapping.
+ */
+struct ShmRing
+{
+    static constexpr uint32_t CAPACITY = 256; // power of two
+
+    alignas(64) std::atomic<uint32_t> head{0}; ///< next slot to write (producer)
+    alignas(64) std::atomic<uint32_t> tail{0}; ///< next slot to read (consumer)
+    alignas(64) IpcMessage slots[CAPACITY];
+
+    /**
+     * @brief Producer side. @return false when the ring is full.
+     */
+    bool push(const IpcMessage &msg)
+    {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= CAPACITY)
+            return false;
+        slots[h & (CAPACITY - 1)] = msg;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side. @return false when the ring is empty.
+     */
+    bool pop(IpcMessage &out)
+    {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire))
+            return false;
+        out = slots[t & (CAPACITY - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "ShmRing needs address-free atomics");
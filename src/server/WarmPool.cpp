@@ -0,0 +1,110 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Pool of pre-spawned idle UDP game servers
+*/
+
+#include "WarmPool.hpp"
+#include <algorithm>
+#include <iostream>
+
+void WarmPool::refill(const std::function<uint16_t()> &allocatePort)
+{
+    if (_idle.size() >= _target || Clock::now() < _nextRefill)
+        return;
+
+    Idle idle;
+    idle.slot.ipc = std::make_unique<IpcChannel>();
+    if (!idle.slot.ipc->bindServer())
+    {
+        std::cerr << "[PARENT] Failed to bind IPC for pooled server" << std::endl;
+        return;
+    }
+    idle.slot.udpPort = allocatePort();
+    if (idle.slot.udpPort == 0)
+        return;
+    idle.slot.pid = _childMgr.spawnIdle(idle.slot.udpPort, idle.slot.ipc->endpoint(), idle.slot.ipc->childFds());
+    if (idle.slot.pid < 0)
+        return;
+    _idle.push_back(std::move(idle));
+}
+
+void WarmPool::pollReady()
+{
+    for (auto &idle : _idle)
+    {
+        if (idle.ready)
+            continue;
+        while (auto msg = idle.slot.ipc->recv(0))
+        {
+            if (msg->type == IpcType::Ready)
+            {
+                idle.ready = true;
+                if (_failedStarts > 0)
+                    std::cout << "[PARENT] Pooled UDP server ready again after " << _failedStarts
+                              << " failed start(s)\n";
+                _failedStarts = 0;
+                _nextRefill = Clock::time_point{};
+                break;
+            }
+        }
+    }
+}
+
+std::optional<WarmPool::Slot> WarmPool::claim(const std::string &lobbyCode)
+{
+    for (auto it = _idle.begin(); it != _idle.end();)
+    {
+        if (!it->ready)
+        {
+            ++it;
+            continue;
+        }
+        Slot slot = std::move(it->slot);
+        it = _idle.erase(it);
+        if (!slot.ipc->send(IpcMessage::make(IpcType::Claim, 0, lobbyCode)))
+        {
+            // The child never learns its lobby: stop it so reap() frees its port, and try the next one.
+            _childMgr.terminate(slot.pid);
+            continue;
+        }
+        _childMgr.assign(slot.pid, lobbyCode);
+        return slot;
+    }
+    return std::nullopt;
+}
+
+void WarmPool::forget(int pid)
+{
+    for (auto it = _idle.begin(); it != _idle.end(); ++it)
+    {
+        if (it->slot.pid == pid)
+        {
+            if (!it->ready)
+            {
+                // Double the delay per consecutive failure: 250 ms, 500 ms, ... up to kMaxRetryDelay.
+                auto delay = std::min<std::chrono::milliseconds>(kMaxRetryDelay,
+                                                                 kRetryDelay * (1u << std::min(_failedStarts, 8u)));
+                if (_failedStarts == 0)
+                    std::cerr << "[PARENT] Pooled UDP server pid=" << pid
+                              << " exited before Ready, backing off pool refills" << std::endl;
+                ++_failedStarts;
+                _nextRefill = Clock::now() + delay;
+            }
+            _idle.erase(it);
+            return;
+        }
+    }
+}
+
+std::size_t WarmPool::readyCount() const
+{
+    std::size_t n = 0;
+    for (const auto &idle : _idle)
+    {
+        if (idle.ready)
+            ++n;
+    }
+    return n;
+}
@@ -0,0 +1,99 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** Pool of pre-spawned idle UDP game servers
+*/
+
+#pragma once
+
+#include "ChildProcessManager.hpp"
+#include "IpcChannel.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+/**
+ * @brief Keeps a few UDP game servers spawned ahead of time.
+ *
+ * Pooled children are started with `--pooled`: they bind their UDP port,
+ * report Ready on their IPC channel and wait for a Claim message.
+ * Creating a lobby then only costs one IPC datagram instead of a fork+exec
+ * and the child startup. The pool is refilled from the TCP loop, outside of
+ * the lobby request path. Children that die before reporting Ready (missing
+ * binary, port taken...) make refill() wait exponentially longer, so a broken
+ * setup does not turn into a fork/exec loop.
+ */
+class WarmPool
+{
+  public:
+    /**
+     * @brief A ready child handed over to a lobby.
+     */
+    struct Slot
+    {
+        int pid = -1;
+        uint16_t udpPort = 0;
+        std::unique_ptr<IpcChannel> ipc;
+    };
+
+    WarmPool(ChildProcessManager &childMgr, std::size_t target) : _childMgr(childMgr), _target(target)
+    {
+    }
+
+    /**
+     * @brief Spawn at most one missing child (called every loop iteration).
+     *
+     * @param allocatePort Source of UDP ports for new children.
+     */
+    void refill(const std::function<uint16_t()> &allocatePort);
+
+    /**
+     * @brief Consume pending READY messages from idle children.
+     */
+    void pollReady();
+
+    /**
+     * @brief Bind a ready child to a lobby.
+     *
+     * A child that cannot be sent the claim is terminated and the next ready one is tried.
+     *
+     * @return The child's port and IPC channel, or nothing if no child is ready.
+     */
+    std::optional<Slot> claim(const std::string &lobbyCode);
+
+    /**
+     * @brief Drop an idle child that exited before being claimed.
+     *
+     * One that never reported Ready counts as a failed start and delays the next refill().
+     */
+    void forget(int pid);
+
+    std::size_t readyCount() const;
+    std::size_t size() const
+    {
+        return _idle.size();
+    }
+
+  private:
+    struct Idle
+    {
+        Slot slot;
+        bool ready = false;
+    };
+
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::chrono::milliseconds kRetryDelay{250}; ///< after the first failed start
+    static constexpr std::chrono::milliseconds kMaxRetryDelay{30000};
+
+    ChildProcessManager &_childMgr;
+    std::size_t _target;
+    std::deque<Idle> _idle;
+    unsigned _failedStarts = 0; ///< consecutive children that exited before Ready
+    Clock::time_point _nextRefill{};
+};
@@ -5,24 +5,43 @@
 ** UDP game server entry point (process enfant)
 */
 
+#include "../Log/Logger.hpp"
 #include "../Network/SessionManager.hpp"
 #include "../Network/TransportLayer/UDP/UDPGameServer.hpp"
 #include "IpcChannel.hpp"
 
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <csignal>
 #include <cstdlib>
-#include <iostream>
 #include <optional>
+#include <random>
 #include <sstream>
 #include <string>
 #include <thread>
 
 namespace
 {
+UDPGameServer *g_server = nullptr;
+volatile std::sig_atomic_t g_stopSignal = 0;
+
+void stopOnSignal(int sig)
+{
+    g_stopSignal = sig;
+    if (g_server)
+        g_server->stop();
+}
+
 struct Args
 {
     std::string lobby = "PUBLIC";
     uint16_t port = 0;
     std::string ipcSock;
+    bool pooled = false;
 };
 
 std::string logPrefix(const Args &args)
@@ -46,28 +65,49 @@ std::optional<Args> parseArgs(int argc, char **argv)
         {
             args.port = static_cast<uint16_t>(std::atoi(argv[++i]));
         }
-        else if (a == "--ipc-port" && i + 1 < argc)
+        else if (a == "--ipc" && i + 1 < argc)
         {
             args.ipcSock = argv[++i];
         }
+        else if (a == "--pooled")
+        {
+            args.pooled = true;
+        }
     }
+    if (args.pooled && args.ipcSock.empty())
+        return std::nullopt;
     return args;
 }
-} // namespace
 
-int main(int argc, char **argv)
+/**
+ * @brief Block until the parent hands this pooled server a lobby.
+ *
+ * @return The lobby code, or nothing if the lobby server went away first.
+ */
+std::optional<std::string> waitForClaim(IpcChannel &ipc)
 {
-#ifdef _WIN32
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+#ifndef _WIN32
+    // Backs up PR_SET_PDEATHSIG (Linux only): an orphan is re-parented, so its parent pid changes.
+    pid_t parent = ::getppid();
+#endif
+    while (true)
     {
-        return 1;
-    }
+        auto msg = ipc.recv(1000);
+        if (msg.has_value() && msg->type == IpcType::Claim)
+            return msg->lobbyCode();
+#ifndef _WIN32
+        if (::getppid() != parent)
+            return std::nullopt;
 #endif
+    }
+}
+
+int run(int argc, char **argv)
+{
     auto argsOpt = parseArgs(argc, argv);
     if (!argsOpt.has_value())
     {
-        std::cerr << "[UDP SERVER ERROR] Failed to parse args\n";
+        RTYPE_LOG_ERROR("[UDP SERVER ERROR] Failed to parse args");
         return 1;
     }
     Args args = *argsOpt;
@@ -76,30 +116,112 @@ int main(int argc, char **argv)
     {
         if (!ipc.connectClient(args.ipcSock))
         {
-            std::cerr << logPrefix(args) << "Unable to connect IPC at " << args.ipcSock << "\n";
+            RTYPE_LOG_ERROR("%sUnable to connect IPC at %s", logPrefix(args).c_str(), args.ipcSock.c_str());
             return 1;
         }
-        ipc.send("READY");
     }
 
     try
     {
         SessionManager sessions;
-        UDPGameServer udpServer(args.port, sessions, 50, args.lobby);
+        // RTYPE_SEED fixes the simulation's RNG (perf runs, reproducing a bug); random otherwise.
+        uint32_t seed = std::random_device{}();
+        if (const char *seedText = std::getenv("RTYPE_SEED"))
+            seed = static_cast<uint32_t>(std::strtoul(seedText, nullptr, 10));
+        UDPGameServer udpServer(args.port, sessions, 50, args.pooled ? "" : args.lobby, seed);
         if (!args.ipcSock.empty())
         {
             udpServer.setIpc(&ipc);
+            ipc.send(IpcMessage::make(IpcType::Ready));
+        }
+        if (args.pooled)
+        {
+            auto lobby = waitForClaim(ipc);
+            if (!lobby.has_value())
+            {
+                RTYPE_LOG_WARN("%sLobby server gone before the claim, exiting", logPrefix(args).c_str());
+                return 0;
+            }
+            args.lobby = *lobby;
+            udpServer.setLobby(args.lobby);
+        }
+        // The lobby server stops game servers with SIGTERM; let run() return so queued log lines
+        // (and the trace, if any) get written. Installed after the claim so idle pooled servers still die.
+        g_server = &udpServer;
+        std::signal(SIGTERM, stopOnSignal);
+        std::signal(SIGINT, stopOnSignal);
+        // RTYPE_NETEM="latency=80,jitter=20,loss=2" impairs this server's UDP traffic (see Impairment).
+        if (const char *netem = std::getenv("RTYPE_NETEM"))
+        {
+            Network::TransportLayer::Impairment::Config config;
+            if (Network::TransportLayer::Impairment::Config::parse(netem, config))
+                udpServer.setImpairment(config);
+            else
+                RTYPE_LOG_WARN("%sRTYPE_NETEM=%s ignored: expected latency=,jitter=,loss=,dup=,reorder=,seed=",
+                               logPrefix(args).c_str(), netem);
         }
-        std::cout << logPrefix(args) << "Started\n";
+        // RTYPE_TRACE_DIR is inherited from the lobby server, so every game server writes its own trace.
+        if (const char *traceDir = std::getenv("RTYPE_TRACE_DIR"))
+        {
+#ifdef RTYPE_PROFILING
+            udpServer.setTraceFile(std::string(traceDir) + "/trace-" + args.lobby + "-" + std::to_string(args.port) +
+                                   ".json");
+#else
+            RTYPE_LOG_WARN("%sRTYPE_TRACE_DIR=%s ignored: built without RTYPE_PROFILING", logPrefix(args).c_str(),
+                           traceDir);
+#endif
+        }
+        // The pid keeps the recording of a crashed server from being overwritten by its restart.
+        if (const char *recordDir = std::getenv("RTYPE_RECORD_DIR"))
+        {
+#ifdef _WIN32
+            int pid = _getpid();
+#else
+            int pid = static_cast<int>(getpid());
+#endif
+            udpServer.setRecordFile(std::string(recordDir) + "/record-" + args.lobby + "-" +
+                                    std::to_string(args.port) + "-" + std::to_string(pid) + ".rtr");
+        }
+        RTYPE_LOG_INFO("%sStarted", logPrefix(args).c_str());
         udpServer.run();
+        g_server = nullptr;
     }
     catch (const std::exception &e)
     {
-        std::cerr << "[UDP SERVER ERROR] " << e.what() << std::endl;
+        g_server = nullptr;
+        RTYPE_LOG_ERROR("[UDP SERVER ERROR] %s", e.what());
         return 1;
     }
+    return 0;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+    {
+        return 1;
+    }
+#endif
+    Log::Level level;
+    if (const char *levelName = std::getenv("RTYPE_LOG_LEVEL"))
+    {
+        if (Log::parseLevel(levelName, level))
+            Log::setLevel(level);
+    }
+    Log::start();
+    int status = run(argc, argv);
+    Log::shutdown();
 #ifdef _WIN32
     WSACleanup();
 #endif
-    return 0;
+    // Die from the signal after flushing, so the lobby server still sees how the process ended.
+    if (g_stopSignal)
+    {
+        std::signal(g_stopSignal, SIG_DFL);
+        std::raise(g_stopSignal);
+    }
+    return status;
 }
@@ -0,0 +1,338 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** rtype-perf entry point: scripted game server run checked against a baseline
+*/
+
+#include "../Log/Logger.hpp"
+#include "../Network/TransportLayer/UDP/UDPGameServer.hpp"
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct Args
+{
+    int bots = 8;
+    int seconds = 10;
+    int shootMs = 1000;
+    uint32_t seed = 42;
+    uint16_t port = 0; ///< 0: any free port
+    std::string baseline;
+    bool update = false;
+};
+
+/**
+ * @brief What the run measured; every metric is lower-is-better.
+ */
+struct Metric
+{
+    const char *name;
+    double defaultTolerancePct; ///< used when the baseline has no <name>_tolerance_pct
+    double value;
+};
+
+void usage()
+{
+    std::cout << "usage: rtype-perf [--bots N] [--seconds M] [--shoot-ms T] [--seed S] [--port P]\n"
+                 "                  [--baseline FILE [--update]]\n"
+                 "  Runs a game server on loopback with N scripted bots in one lobby for M seconds and reports\n"
+                 "  tick p50/p99, simulation CPU per tick and snapshot size. With --baseline the scenario is read\n"
+                 "  from FILE and a metric above its tolerance fails the run; --update rewrites FILE with this run.\n"
+                 "  The server listens on any free port unless --port is given.\n";
+}
+
+bool parseArgs(int argc, char **argv, Args &args)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        if (a == "--bots" && i + 1 < argc)
+            args.bots = std::atoi(argv[++i]);
+        else if (a == "--seconds" && i + 1 < argc)
+            args.seconds = std::atoi(argv[++i]);
+        else if (a == "--shoot-ms" && i + 1 < argc)
+            args.shootMs = std::atoi(argv[++i]);
+        else if (a == "--seed" && i + 1 < argc)
+            args.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (a == "--port" && i + 1 < argc)
+            args.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        else if (a == "--baseline" && i + 1 < argc)
+            args.baseline = argv[++i];
+        else if (a == "--update")
+            args.update = true;
+        else
+            return false;
+    }
+    return args.bots > 0 && args.bots < 64 && args.seconds > 0 && args.shootMs > 0 &&
+           (!args.update || !args.baseline.empty());
+}
+
+/**
+ * @brief Read a flat JSON object of numbers ({"key": 1.5, ...}), the baseline format.
+ */
+bool readBaseline(const std::string &path, std::map<std::string, double> &out)
+{
+    std::ifstream file(path);
+    if (!file)
+        return false;
+    std::stringstream ss;
+    ss << file.rdbuf();
+    const std::string text = ss.str();
+    std::size_t pos = 0;
+    auto skipSpace = [&]() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos])))
+            ++pos;
+    };
+    auto expect = [&](char c) {
+        skipSpace();
+        if (pos >= text.size() || text[pos] != c)
+            return false;
+        ++pos;
+        return true;
+    };
+    if (!expect('{'))
+        return false;
+    skipSpace();
+    if (pos < text.size() && text[pos] == '}')
+        return true;
+    do
+    {
+        if (!expect('"'))
+            return false;
+        std::size_t end = text.find('"', pos);
+        if (end == std::string::npos)
+            return false;
+        std::string key = text.substr(pos, end - pos);
+        pos = end + 1;
+        if (!expect(':'))
+            return false;
+        skipSpace();
+        const char *start = text.c_str() + pos;
+        char *rest = nullptr;
+        double value = std::strtod(start, &rest);
+        if (rest == start)
+            return false;
+        pos += static_cast<std::size_t>(rest - start);
+        out[key] = value;
+    } while (expect(','));
+    return expect('}');
+}
+
+bool writeBaseline(const std::string &path, const Args &args, const std::vector<Metric> &metrics,
+                   const std::map<std::string, double> &previous)
+{
+    std::ofstream file(path);
+    if (!file)
+        return false;
+    file << "{\n    \"bots\": " << args.bots << ",\n    \"seconds\": " << args.seconds << ",\n    \"shoot_ms\": "
+         << args.shootMs << ",\n    \"seed\": " << args.seed;
+    for (const Metric &m : metrics)
+    {
+        const std::string tolKey = std::string(m.name) + "_tolerance_pct";
+        auto tol = previous.find(tolKey);
+        char line[160];
+        std::snprintf(line, sizeof(line), ",\n    \"%s\": %.2f,\n    \"%s\": %g", m.name, m.value, tolKey.c_str(),
+                      tol != previous.end() ? tol->second : m.defaultTolerancePct);
+        file << line;
+    }
+    file << "\n}\n";
+    return static_cast<bool>(file);
+}
+
+constexpr uint8_t kMoveUp = 0;   ///< NetworkClient::MoveCmd::Up
+constexpr uint8_t kMoveDown = 1; ///< NetworkClient::MoveCmd::Down
+
+struct BotTraffic
+{
+    uint64_t snapshots = 0;
+    uint64_t snapshotBytes = 0;
+};
+
+/**
+ * @brief Drive the bots until `seconds` elapsed or the server stopped.
+ *
+ * Bot i (player id i + 1) sits at its own height, moves up and down (1 s each way, phase
+ * shifted per bot), sends INPUT every tick, fires every shootMs and repeats its HELLO_UDP
+ * every second, which brings it back to full health: deaths never change the load.
+ */
+BotTraffic runBots(const Args &args, const std::atomic<bool> &serverDone)
+{
+    using Clock = std::chrono::steady_clock;
+    using Network::TransportLayer::UDPSocket;
+    sockaddr_in server{};
+    server.sin_family = AF_INET;
+    server.sin_port = htons(args.port);
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    std::vector<std::unique_ptr<UDPSocket>> sockets;
+    for (int i = 0; i < args.bots; ++i)
+        sockets.push_back(std::make_unique<UDPSocket>());
+    auto send = [&](int bot, PacketType type, std::vector<uint8_t> payload) {
+        const uint16_t id = static_cast<uint16_t>(bot + 1);
+        payload.insert(payload.begin(), {static_cast<uint8_t>(id >> 8), static_cast<uint8_t>(id & 0xFF)});
+        std::vector<uint8_t> bytes = Packet(type, payload).serialize();
+        sockets[bot]->writeByte(reinterpret_cast<const char *>(bytes.data()), bytes.size(), server);
+    };
+    auto height = [&args](int bot) { return static_cast<uint8_t>(20 + bot * 200 / args.bots); };
+
+    BotTraffic traffic;
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::seconds(args.seconds);
+    long long nextInput = 0;
+    long long nextShoot = 0;
+    long long nextHello = 0;
+    char buffer[1024];
+    while (!serverDone && Clock::now() < end)
+    {
+        long long now = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+        for (int i = 0; i < args.bots; ++i)
+        {
+            if (now >= nextHello)
+                send(i, PacketType::HELLO_UDP, {30, height(i)});
+            if (now >= nextInput)
+            {
+                bool up = ((now + i * 250) / 1000) % 2 == 0;
+                send(i, PacketType::INPUT,
+                     {30, height(i), 0, static_cast<uint8_t>(up ? -3 : 3), up ? kMoveUp : kMoveDown});
+            }
+            if (now >= nextShoot)
+                send(i, PacketType::SHOOT, {34, static_cast<uint8_t>(height(i) + 1), 2, 0});
+            ssize_t n = 0;
+            while ((n = sockets[i]->readByte(buffer, sizeof(buffer))) > 0)
+            {
+                Packet packet;
+                if (Packet::tryDeserialize(reinterpret_cast<const uint8_t *>(buffer), static_cast<std::size_t>(n),
+                                           packet) == ParseStatus::Ok &&
+                    packet.type == PacketType::SNAPSHOT)
+                {
+                    ++traffic.snapshots;
+                    traffic.snapshotBytes += static_cast<uint64_t>(n);
+                }
+            }
+        }
+        if (now >= nextHello)
+            nextHello = now + 1000;
+        if (now >= nextInput)
+            nextInput = now + 32;
+        if (now >= nextShoot)
+            nextShoot = now + args.shootMs;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return traffic;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Args args;
+    if (!parseArgs(argc, argv, args))
+    {
+        usage();
+        return 2;
+    }
+    std::map<std::string, double> baseline;
+    if (!args.baseline.empty())
+    {
+        if (!readBaseline(args.baseline, baseline) && !args.update)
+        {
+            std::cerr << "rtype-perf: cannot read baseline " << args.baseline << "\n";
+            return 2;
+        }
+        // The baseline fixes the scenario, so its numbers stay comparable.
+        if (baseline.count("bots"))
+            args.bots = static_cast<int>(baseline["bots"]);
+        if (baseline.count("seconds"))
+            args.seconds = static_cast<int>(baseline["seconds"]);
+        if (baseline.count("shoot_ms"))
+            args.shootMs = static_cast<int>(baseline["shoot_ms"]);
+        if (baseline.count("seed"))
+            args.seed = static_cast<uint32_t>(baseline["seed"]);
+    }
+    Log::setLevel(Log::Level::Error);
+
+    SessionManager sessions;
+    std::unique_ptr<UDPGameServer> server;
+    try
+    {
+        server = std::make_unique<UDPGameServer>(args.port, sessions, 50, "PERF", args.seed);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "rtype-perf: port " << args.port << ": " << e.what() << "\n";
+        return 2;
+    }
+    args.port = server->port();
+    std::printf("%d bots firing every %d ms, one lobby, seed %u, %d s on port %u\n", args.bots, args.shootMs, args.seed,
+                args.seconds, static_cast<unsigned>(args.port));
+
+    std::atomic<bool> serverDone{false};
+    std::thread serverThread([&]() {
+        server->run();
+        serverDone = true;
+    });
+    BotTraffic traffic = runBots(args, serverDone);
+    bool endedEarly = serverDone;
+    server->stop();
+    serverThread.join();
+
+    const Metrics::Histogram &tickNs = server->tickNs();
+    if (endedEarly || tickNs.count() == 0 || traffic.snapshots == 0)
+    {
+        std::cerr << "rtype-perf: the game server stopped before the end of the scenario\n";
+        return 1;
+    }
+    // CPU of the simulation step only: the loop's idle wakeups would drown it, and depend on the scheduler.
+    std::vector<Metric> metrics = {
+        {"tick_p50_us", 100, tickNs.percentile(50) / 1000.0},
+        {"tick_p99_us", 200, tickNs.percentile(99) / 1000.0},
+        {"sim_cpu_us_per_tick", 100, server->tickCpuNs() / 1000.0 / static_cast<double>(tickNs.count())},
+        {"snapshot_bytes_mean", 10, static_cast<double>(traffic.snapshotBytes) / traffic.snapshots},
+    };
+    std::printf("%llu ticks, %llu snapshots received (%.1f/s per bot)\n",
+                static_cast<unsigned long long>(tickNs.count()), static_cast<unsigned long long>(traffic.snapshots),
+                static_cast<double>(traffic.snapshots) / args.bots / args.seconds);
+
+    if (args.update)
+    {
+        if (!writeBaseline(args.baseline, args, metrics, baseline))
+        {
+            std::cerr << "rtype-perf: cannot write " << args.baseline << "\n";
+            return 2;
+        }
+        for (const Metric &m : metrics)
+            std::printf("%-20s %10.2f\n", m.name, m.value);
+        std::printf("baseline written to %s\n", args.baseline.c_str());
+        return 0;
+    }
+
+    bool regressed = false;
+    std::printf("%-20s %10s %10s %10s\n", "metric", "measured", "baseline", "limit");
+    for (const Metric &m : metrics)
+    {
+        auto ref = baseline.find(m.name);
+        if (ref == baseline.end())
+        {
+            std::printf("%-20s %10.2f %10s %10s\n", m.name, m.value, "-", "-");
+            continue;
+        }
+        auto tol = baseline.find(std::string(m.name) + "_tolerance_pct");
+        double limit = ref->second * (1.0 + (tol != baseline.end() ? tol->second : m.defaultTolerancePct) / 100.0);
+        bool over = m.value > limit;
+        regressed = regressed || over;
+        std::printf("%-20s %10.2f %10.2f %10.2f %s\n", m.name, m.value, ref->second, limit, over ? "REGRESSED" : "ok");
+    }
+    return regressed ? 1 : 0;
+}
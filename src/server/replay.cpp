@@ -0,0 +1,102 @@
+/*
+** EPITECH PROJECT, 2025
+** Mystic-Type
+** File description:
+** rtype-replay entry point
+*/
+
+#include "../Log/Logger.hpp"
+#include "../Network/TransportLayer/UDP/UDPGameServer.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+struct Args
+{
+    std::string file;
+    int repeat = 1;
+    bool verbose = false;
+};
+
+void usage()
+{
+    std::cout << "usage: rtype-replay FILE.rtr [--repeat N] [--verbose]\n"
+                 "  Re-simulates a game server recording (RTYPE_RECORD_DIR) headless and checks its snapshots.\n";
+}
+
+bool parseArgs(int argc, char **argv, Args &args)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        if (a == "--repeat" && i + 1 < argc)
+            args.repeat = std::atoi(argv[++i]);
+        else if (a == "--verbose")
+            args.verbose = true;
+        else if (args.file.empty() && a.rfind("--", 0) != 0)
+            args.file = a;
+        else
+            return false;
+    }
+    return !args.file.empty() && args.repeat > 0;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Args args;
+    if (!parseArgs(argc, argv, args))
+    {
+        usage();
+        return 2;
+    }
+    // Game logs would only repeat what the recorded server already printed.
+    if (!args.verbose)
+        Log::setLevel(Log::Level::Warn);
+
+    Metrics::Histogram tickNs;
+    UDPGameServer::ReplayResult result;
+    double wallMs = 0;
+    bool faithful = true;
+    for (int run = 0; run < args.repeat; ++run)
+    {
+        result = UDPGameServer::ReplayResult{};
+        if (!UDPGameServer::replay(args.file, result))
+        {
+            std::cerr << "rtype-replay: " << result.error << "\n";
+            return 1;
+        }
+        tickNs.merge(result.tickNs);
+        wallMs += result.wallMs;
+        faithful = faithful && result.mismatches == 0 && result.snapshots == result.recordedSnapshots;
+    }
+
+    std::printf("lobby %s seed %u: %llu packets, %llu ticks, %llu snapshots (%llu recorded)\n", result.lobby.c_str(),
+                result.seed, static_cast<unsigned long long>(result.packets),
+                static_cast<unsigned long long>(result.ticks), static_cast<unsigned long long>(result.snapshots),
+                static_cast<unsigned long long>(result.recordedSnapshots));
+    double runMs = wallMs / args.repeat;
+    std::printf("simulated %.1f s in %.1f ms per run (%.0fx real time, %d run%s)\n", result.simulatedMs / 1000.0, runMs,
+                runMs > 0 ? result.simulatedMs / runMs : 0.0, args.repeat, args.repeat > 1 ? "s" : "");
+    std::printf("tick       n=%-8llu mean=%8.1f p50=%8.1f p99=%8.1f max=%8.1f us\n",
+                static_cast<unsigned long long>(tickNs.count()), tickNs.mean() / 1000.0,
+                tickNs.percentile(50) / 1000.0, tickNs.percentile(99) / 1000.0, tickNs.max() / 1000.0);
+    if (!result.error.empty())
+        std::printf("simulation stopped: %s\n", result.error.c_str());
+    if (faithful)
+    {
+        std::printf("snapshots identical\n");
+        return 0;
+    }
+    if (result.mismatches)
+        std::printf("snapshots differ: %llu mismatched, first at #%lld\n",
+                    static_cast<unsigned long long>(result.mismatches), result.firstMismatch);
+    else
+        std::printf("snapshots differ: replay built %llu, recording has %llu\n",
+                    static_cast<unsigned long long>(result.snapshots),
+                    static_cast<unsigned long long>(result.recordedSnapshots));
+    return 1;
+}
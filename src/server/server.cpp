@@ -10,10 +10,44 @@
 #include "../Network/TransportLayer/UDP/UDPGameServer.hpp"
 #include "ChildProcessManager.hpp"
 #include "IpcChannel.hpp"
+#include "MetricsEndpoint.hpp"
+#include "WarmPool.hpp"
+#include <cstdlib>
 #include <iostream>
+#include <string>
 #include <thread>
 
-int main()
+namespace
+{
+struct Args
+{
+    std::size_t warmPool = 2;
+    uint16_t metricsPort = 0; ///< 0 keeps the metrics endpoint closed
+    ChildLimits limits;
+};
+
+Args parseArgs(int argc, char **argv)
+{
+    Args args;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        if (a == "--warm-pool" && i + 1 < argc)
+            args.warmPool = static_cast<std::size_t>(std::atoi(argv[++i]));
+        else if (a == "--pin-cpus")
+            args.limits.pinCpus = true;
+        else if (a == "--child-mem-mb" && i + 1 < argc)
+            args.limits.memoryMb = static_cast<std::size_t>(std::atoi(argv[++i]));
+        else if (a == "--child-nice" && i + 1 < argc)
+            args.limits.niceLevel = std::atoi(argv[++i]);
+        else if (a == "--metrics-port" && i + 1 < argc)
+            args.metricsPort = static_cast<uint16_t>(std::atoi(argv[++i]));
+    }
+    return args;
+}
+} // namespace
+
+int main(int argc, char **argv)
 {
 #ifdef _WIN32
     WSADATA wsaData;
@@ -25,8 +59,18 @@ int main()
     try
     {
         SessionManager sessions;
-        ChildProcessManager childMgr;
-        TCPServer tcpServer(4243, sessions, &childMgr);
+        Args args = parseArgs(argc, argv);
+        ChildProcessManager childMgr(64, args.limits);
+        WarmPool pool(childMgr, args.warmPool);
+        MetricsEndpoint metrics;
+        if (args.metricsPort != 0)
+        {
+            if (!metrics.listen(args.metricsPort))
+                std::cerr << "[SERVER] metrics endpoint unavailable on port " << args.metricsPort << "\n";
+            else
+                std::cout << "[SERVER] metrics on http://127.0.0.1:" << args.metricsPort << "/metrics\n";
+        }
+        TCPServer tcpServer(4243, sessions, &childMgr, &pool, args.metricsPort != 0 ? &metrics : nullptr);
         tcpServer.run();
     }
     catch (const std::exception &e)